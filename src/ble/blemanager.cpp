@@ -1,9 +1,13 @@
 #include "blemanager.h"
-#include "protocol/de1characteristics.h"
+#include "sensors/sensordescriptor.h"
 #include "sensors/sensorfactory.h"
 
 #include <QLoggingCategory>
 #include <QCoreApplication>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QPermissions>
 
 Q_LOGGING_CATEGORY(lcBLE, "bridge.ble")
@@ -16,10 +20,18 @@ BLEManager::BLEManager(QObject *parent)
 
     connect(m_agent, &QBluetoothDeviceDiscoveryAgent::deviceDiscovered,
             this, &BLEManager::onDeviceDiscovered);
+    connect(m_agent, &QBluetoothDeviceDiscoveryAgent::deviceUpdated,
+            this, &BLEManager::onDeviceUpdated);
     connect(m_agent, &QBluetoothDeviceDiscoveryAgent::finished,
             this, &BLEManager::onScanFinished);
     connect(m_agent, &QBluetoothDeviceDiscoveryAgent::errorOccurred,
             this, &BLEManager::onScanError);
+
+    m_pruneTimer.setInterval(PRUNE_INTERVAL_MS);
+    connect(&m_pruneTimer, &QTimer::timeout, this, &BLEManager::pruneStale);
+
+    // Readings may change before the first snapshot is built
+    m_snapshotAge.start();
 }
 
 BLEManager::~BLEManager()
@@ -38,7 +50,8 @@ void BLEManager::startScan()
         return;
     }
 
-    m_devices.clear();
+    // Devices found by earlier scans stay listed until they go stale
+    pruneStale();
     qCInfo(lcBLE) << "Starting BLE scan...";
 
 #ifdef Q_OS_ANDROID
@@ -103,18 +116,30 @@ void BLEManager::requestBluetoothPermission()
 void BLEManager::doStartScan()
 {
     qCInfo(lcBLE) << "Permissions granted, starting scan...";
+    m_scan++;
     m_agent->start(QBluetoothDeviceDiscoveryAgent::LowEnergyMethod);
+    m_pruneTimer.start();
     emit scanningChanged(true);
 }
 
 void BLEManager::stopScan()
 {
+    m_pruneTimer.stop();
     if (m_agent && m_agent->isActive()) {
         m_agent->stop();
         emit scanningChanged(false);
     }
 }
 
+quint64 BLEManager::deviceKey(const QBluetoothDeviceInfo &device)
+{
+    if (!device.address().isNull()) {
+        return device.address().toUInt64();
+    }
+    // Apple platforms hide the address; MAC addresses never use the top bit
+    return quint64(qHash(device.deviceUuid())) | (quint64(1) << 63);
+}
+
 void BLEManager::onDeviceDiscovered(const QBluetoothDeviceInfo &device)
 {
     // Only care about BLE devices
@@ -122,65 +147,177 @@ void BLEManager::onDeviceDiscovered(const QBluetoothDeviceInfo &device)
         return;
     }
 
-    // Check for duplicate (same address already in list)
-    QString address = device.address().toString();
-    for (const auto &existing : m_devices) {
-        if (existing.address().toString() == address) {
-            return; // Already have this device
-        }
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    bool changed = false;
+    auto it = m_devices.find(deviceKey(device));
+    if (it == m_devices.end()) {
+        DiscoveredDevice entry;
+        entry.info = device;
+        classify(entry);
+        it = m_devices.insert(deviceKey(device), entry);
+        changed = true;
+    } else if (it->kind == DeviceKind::Unknown && device.name() != it->info.name()) {
+        // Some advertisers only send their name in the scan response
+        it->info = device;
+        classify(*it);
+        changed = true;
     }
 
-    m_devices.append(device);
+    it->rssi = device.rssi();
+    it->lastSeen = now;
+    if (changed) {
+        m_snapshotDirty = true;
+        emit discoveredDevicesChanged();
+    } else {
+        m_readingsChanged = true;
+    }
+
+    // Report each device once per scan, as listeners rely on rediscovery
+    // to find devices again after a disconnect
+    if (it->scan == m_scan || it->kind == DeviceKind::Unknown) {
+        return;
+    }
+    it->scan = m_scan;
 
-    if (isDE1(device)) {
+    switch (it->kind) {
+    case DeviceKind::Machine:
         qCInfo(lcBLE) << "Found DE1:" << device.name() << device.address().toString();
         emit de1Discovered(device);
-    } else if (isScale(device)) {
-        QString type = scaleType(device);
-        qCInfo(lcBLE) << "Found" << type << "scale:" << device.name() << device.address().toString();
+        break;
+    case DeviceKind::Scale:
+        qCInfo(lcBLE) << "Found" << it->typeName << "scale:" << device.name() << device.address().toString();
         emit scaleDiscovered(device);
-    } else if (isSensor(device)) {
-        QString type = sensorType(device);
-        qCInfo(lcBLE) << "Found" << type << "sensor:" << device.name() << device.address().toString();
+        break;
+    case DeviceKind::Sensor:
+        qCInfo(lcBLE) << "Found" << it->typeName << "sensor:" << device.name() << device.address().toString();
         emit sensorDiscovered(device);
+        break;
+    case DeviceKind::Unknown:
+        break;
     }
 }
 
-void BLEManager::onScanFinished()
+void BLEManager::onDeviceUpdated(const QBluetoothDeviceInfo &device, QBluetoothDeviceInfo::Fields updatedFields)
 {
-    qCInfo(lcBLE) << "Scan finished, found" << m_devices.size() << "devices";
-    emit scanningChanged(false);
-    emit scanFinished();
+    auto it = m_devices.find(deviceKey(device));
+    if (it == m_devices.end()) {
+        onDeviceDiscovered(device);
+        return;
+    }
+
+    if (updatedFields & QBluetoothDeviceInfo::Field::RSSI) {
+        it->rssi = device.rssi();
+    }
+    it->lastSeen = QDateTime::currentMSecsSinceEpoch();
+    m_readingsChanged = true;
 }
 
-void BLEManager::onScanError(QBluetoothDeviceDiscoveryAgent::Error error)
+void BLEManager::classify(DiscoveredDevice &entry)
 {
-    qCWarning(lcBLE) << "Scan error:" << error << m_agent->errorString();
-    emit this->error(m_agent->errorString());
+    entry.type = DeviceClassifier::classify(entry.info);
+    entry.kind = DeviceClassifier::category(entry.type);
+    if (entry.kind == DeviceKind::Unknown) {
+        // Sensors described in JSON rather than built in
+        if (auto described = SensorFactory::descriptor(entry.info)) {
+            entry.kind = DeviceKind::Sensor;
+            entry.typeName = described->type;
+            return;
+        }
+    }
+    entry.typeName = (entry.kind == DeviceKind::Scale || entry.kind == DeviceKind::Sensor)
+        ? DeviceClassifier::apiName(entry.type) : QString();
 }
 
-bool BLEManager::isDE1(const QBluetoothDeviceInfo &device) const
+void BLEManager::pruneStale()
 {
-    // Check if it's a known scale first - scales are NOT DE1 machines
-    if (isScale(device)) {
-        return false;
+    const qint64 cutoff = QDateTime::currentMSecsSinceEpoch() - STALE_AFTER_MS;
+    qsizetype removed = m_devices.removeIf([cutoff](const auto &it) {
+        return it->lastSeen < cutoff;
+    });
+    if (removed > 0) {
+        qCDebug(lcBLE) << "Dropped" << removed << "stale devices," << m_devices.size() << "remain";
+        m_snapshotDirty = true;
+        emit discoveredDevicesChanged();
     }
+}
 
-    QString name = device.name().toLower();
+QList<QBluetoothDeviceInfo> BLEManager::discoveredDevices() const
+{
+    QList<QBluetoothDeviceInfo> devices;
+    devices.reserve(m_devices.size());
+    for (const DiscoveredDevice &entry : m_devices) {
+        devices.append(entry.info);
+    }
+    return devices;
+}
+
+const BLEManager::DiscoveredDevice *BLEManager::discoveredDevice(const QString &address) const
+{
+    QBluetoothAddress parsed(address);
+    if (parsed.isNull()) {
+        return nullptr;
+    }
+    auto it = m_devices.constFind(parsed.toUInt64());
+    return it == m_devices.constEnd() ? nullptr : &it.value();
+}
 
-    // DE1 devices advertise as "DE1" or contain "decent"
-    if (name.startsWith("de1") || name.contains("decent")) {
-        return true;
+QByteArray BLEManager::discoveredDevicesJson() const
+{
+    const bool readingsDue = m_readingsChanged && m_snapshotAge.elapsed() >= READINGS_REFRESH_MS;
+    if (!m_snapshotDirty && !readingsDue) {
+        return m_snapshot;
     }
 
-    // Check for DE1 service UUID in advertisement
-    for (const auto &uuid : device.serviceUuids()) {
-        if (uuid == DE1::SERVICE_UUID) {
-            return true;
+    QJsonArray devices;
+    for (const DiscoveredDevice &entry : m_devices) {
+        QJsonObject obj;
+        obj["name"] = entry.info.name();
+        obj["address"] = entry.info.address().toString();
+        obj["rssi"] = entry.rssi;
+        obj["lastSeen"] = entry.lastSeen;
+
+        switch (entry.kind) {
+        case DeviceKind::Scale:
+            obj["type"] = "scale";
+            obj["scaleType"] = entry.typeName;
+            break;
+        case DeviceKind::Sensor:
+            obj["type"] = "sensor";
+            obj["sensorType"] = entry.typeName;
+            break;
+        case DeviceKind::Machine:
+            obj["type"] = "machine";
+            break;
+        case DeviceKind::Unknown:
+            obj["type"] = "unknown";
+            break;
         }
+        devices.append(obj);
     }
 
-    return false;
+    m_snapshot = QJsonDocument(devices).toJson(QJsonDocument::Compact);
+    m_snapshotDirty = false;
+    m_readingsChanged = false;
+    m_snapshotAge.start();
+    return m_snapshot;
+}
+
+void BLEManager::onScanFinished()
+{
+    qCInfo(lcBLE) << "Scan finished, found" << m_devices.size() << "devices";
+    emit scanningChanged(false);
+    emit scanFinished();
+}
+
+void BLEManager::onScanError(QBluetoothDeviceDiscoveryAgent::Error error)
+{
+    qCWarning(lcBLE) << "Scan error:" << error << m_agent->errorString();
+    emit this->error(m_agent->errorString());
+}
+
+bool BLEManager::isDE1(const QBluetoothDeviceInfo &device) const
+{
+    return DeviceClassifier::classify(device) == DeviceType::DE1;
 }
 
 bool BLEManager::isScale(const QBluetoothDeviceInfo &device) const
@@ -190,23 +327,11 @@ bool BLEManager::isScale(const QBluetoothDeviceInfo &device) const
 
 QString BLEManager::scaleType(const QBluetoothDeviceInfo &device) const
 {
-    QString name = device.name();
-    QString nameLower = name.toLower();
-
-    // Detect scale by name pattern (case-insensitive where needed)
-    if (name.startsWith("Decent Scale")) return "Decent";
-    if (nameLower.startsWith("acaia") || nameLower.startsWith("proch")) return "Acaia";
-    if (nameLower.startsWith("pyxis")) return "Acaia Pyxis";
-    if (nameLower.startsWith("felicita")) return "Felicita";
-    if (nameLower.startsWith("skale")) return "Skale";
-    if (nameLower.startsWith("bookoo") && !nameLower.contains("em") && !nameLower.contains("monitor")) return "Bookoo";
-    if (nameLower.startsWith("eureka")) return "Eureka";
-    if (nameLower.startsWith("difluid")) return "DiFluid";
-    if (nameLower.startsWith("hiroia") || nameLower.startsWith("jimmy")) return "Hiroia";
-    if (nameLower.startsWith("varia")) return "Varia";
-    if (nameLower.startsWith("smartchef")) return "SmartChef";
-
-    return QString();
+    DeviceType type = DeviceClassifier::classify(device);
+    if (DeviceClassifier::category(type) != DeviceCategory::Scale) {
+        return QString();
+    }
+    return DeviceClassifier::apiName(type);
 }
 
 bool BLEManager::isSensor(const QBluetoothDeviceInfo &device) const
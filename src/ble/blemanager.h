@@ -1,15 +1,27 @@
 #ifndef BLEMANAGER_H
 #define BLEMANAGER_H
 
+#include "deviceclassifier.h"
 #include <QObject>
 #include <QBluetoothDeviceDiscoveryAgent>
 #include <QBluetoothDeviceInfo>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QList>
+#include <QTimer>
 
 /**
  * @brief BLE device discovery manager
  *
  * Scans for DE1 machines and compatible scales.
+ *
+ * Every advertiser seen is kept in a registry keyed by its 48-bit address
+ * (platform UUID on Apple), classified once when first seen, and updated
+ * with RSSI and last-seen time on later advertisements. Entries not seen
+ * for STALE_AFTER_MS while scanning are dropped. The JSON list served over
+ * HTTP is rebuilt when devices are added, reclassified or dropped; RSSI and
+ * last-seen updates alone refresh it at most every READINGS_REFRESH_MS, so a
+ * crowded scan does not re-serialize the list on every request.
  */
 class BLEManager : public QObject
 {
@@ -18,6 +30,18 @@ class BLEManager : public QObject
     Q_PROPERTY(bool scanning READ isScanning NOTIFY scanningChanged)
 
 public:
+    using DeviceKind = DeviceCategory;
+
+    struct DiscoveredDevice {
+        QBluetoothDeviceInfo info;
+        DeviceType type = DeviceType::Unknown;
+        DeviceKind kind = DeviceKind::Unknown;
+        QString typeName;       // scale or sensor type
+        qint16 rssi = 0;
+        qint64 lastSeen = 0;    // ms since epoch
+        int scan = -1;          // last scan that reported this device
+    };
+
     explicit BLEManager(QObject *parent = nullptr);
     ~BLEManager();
 
@@ -26,7 +50,11 @@ public:
     void startScan();
     void stopScan();
 
-    QList<QBluetoothDeviceInfo> discoveredDevices() const { return m_devices; }
+    QList<QBluetoothDeviceInfo> discoveredDevices() const;
+    // nullptr if the address has not been seen
+    const DiscoveredDevice *discoveredDevice(const QString &address) const;
+    // JSON array for /api/v1/devices/discovered
+    QByteArray discoveredDevicesJson() const;
 
     // Device type detection
     bool isDE1(const QBluetoothDeviceInfo &device) const;
@@ -40,20 +68,36 @@ signals:
     void de1Discovered(const QBluetoothDeviceInfo &device);
     void scaleDiscovered(const QBluetoothDeviceInfo &device);
     void sensorDiscovered(const QBluetoothDeviceInfo &device);
+    // Devices were added, reclassified or dropped; not emitted for RSSI updates
+    void discoveredDevicesChanged();
     void scanFinished();
     void error(const QString &message);
 
 private slots:
     void onDeviceDiscovered(const QBluetoothDeviceInfo &device);
+    void onDeviceUpdated(const QBluetoothDeviceInfo &device, QBluetoothDeviceInfo::Fields updatedFields);
     void onScanFinished();
     void onScanError(QBluetoothDeviceDiscoveryAgent::Error error);
 
 private:
     void requestBluetoothPermission();
     void doStartScan();
+    static void classify(DiscoveredDevice &entry);
+    void pruneStale();
+    static quint64 deviceKey(const QBluetoothDeviceInfo &device);
 
     QBluetoothDeviceDiscoveryAgent *m_agent = nullptr;
-    QList<QBluetoothDeviceInfo> m_devices;
+    QHash<quint64, DiscoveredDevice> m_devices;
+    QTimer m_pruneTimer;
+    int m_scan = 0;
+    mutable QByteArray m_snapshot;
+    mutable bool m_snapshotDirty = true;      // Membership or classification changed
+    mutable bool m_readingsChanged = false;   // Only RSSI / last seen changed
+    mutable QElapsedTimer m_snapshotAge;
+
+    static constexpr qint64 STALE_AFTER_MS = 120000;
+    static constexpr qint64 READINGS_REFRESH_MS = 1000;
+    static constexpr int PRUNE_INTERVAL_MS = 30000;
 };
 
 #endif // BLEMANAGER_H
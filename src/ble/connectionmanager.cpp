@@ -0,0 +1,203 @@
+#include "connectionmanager.h"
+
+#include <QLoggingCategory>
+#include <QLowEnergyConnectionParameters>
+#include <QLowEnergyController>
+#include <QRandomGenerator>
+
+Q_LOGGING_CATEGORY(lcConn, "bridge.ble.connections")
+
+ConnectionManager::ConnectionManager(QObject *parent)
+    : QObject(parent)
+{
+}
+
+ConnectionManager::~ConnectionManager()
+{
+    clear();
+}
+
+void ConnectionManager::start()
+{
+    m_outage.start();
+}
+
+void ConnectionManager::clear()
+{
+    for (Link &link : m_links) {
+        link.timer->stop();
+        link.timer->deleteLater();
+    }
+    m_links.clear();
+}
+
+void ConnectionManager::addLink(const QString &id, Role role, const QBluetoothDeviceInfo &device, Connector connector)
+{
+    removeLink(id);
+
+    Link link;
+    link.role = role;
+    link.device = device;
+    link.connector = std::move(connector);
+    link.sinceLost.start();
+    link.timer = new QTimer(this);
+    link.timer->setSingleShot(true);
+    connect(link.timer, &QTimer::timeout, this, [this, id]() { onTimer(id); });
+    m_links.insert(id, link);
+
+    if (!m_outage.isValid()) {
+        m_outage.start();
+    }
+    qCInfo(lcConn) << "Managing" << roleName(role) << "link" << id << device.name();
+    attempt(id);
+}
+
+void ConnectionManager::removeLink(const QString &id)
+{
+    auto it = m_links.find(id);
+    if (it == m_links.end()) return;
+
+    // Deferred: removal may happen from inside the timer's own timeout
+    it->timer->stop();
+    it->timer->deleteLater();
+    m_links.erase(it);
+}
+
+QBluetoothDeviceInfo ConnectionManager::device(const QString &id) const
+{
+    return m_links.value(id).device;
+}
+
+bool ConnectionManager::isConnected(const QString &id) const
+{
+    auto it = m_links.constFind(id);
+    return it != m_links.constEnd() && it->state == LinkState::Connected;
+}
+
+void ConnectionManager::retryNow(const QString &id)
+{
+    auto it = m_links.find(id);
+    if (it == m_links.end() || it->state != LinkState::Backoff) return;
+
+    qCInfo(lcConn) << roleName(it->role) << id << "is advertising, retrying now";
+    attempt(id);
+}
+
+bool ConnectionManager::allConnected() const
+{
+    for (const Link &link : m_links) {
+        if (link.state != LinkState::Connected) return false;
+    }
+    return true;
+}
+
+void ConnectionManager::attempt(const QString &id)
+{
+    auto it = m_links.find(id);
+    if (it == m_links.end()) return;
+
+    it->state = LinkState::Connecting;
+    it->attempts++;
+    it->timer->start(ATTEMPT_TIMEOUT_MS);
+    qCInfo(lcConn) << "Connecting" << id << "attempt" << it->attempts;
+
+    // The connector may report back (or remove the link) synchronously
+    Connector connector = it->connector;
+    QBluetoothDeviceInfo device = it->device;
+    connector(device);
+}
+
+void ConnectionManager::onTimer(const QString &id)
+{
+    auto it = m_links.find(id);
+    if (it == m_links.end()) return;
+
+    if (it->state == LinkState::Backoff) {
+        attempt(id);
+    } else if (it->state == LinkState::Connecting) {
+        reportFailed(id, "attempt timed out");
+    }
+}
+
+void ConnectionManager::reportConnected(const QString &id)
+{
+    auto it = m_links.find(id);
+    if (it == m_links.end() || it->state == LinkState::Connected) return;
+
+    it->timer->stop();
+    it->state = LinkState::Connected;
+    qCInfo(lcConn) << roleName(it->role) << id << "connected after" << it->attempts
+                   << "attempt(s) in" << it->sinceLost.elapsed() << "ms";
+    it->attempts = 0;
+
+    if (m_outage.isValid() && allConnected()) {
+        qint64 elapsed = m_outage.elapsed();
+        qCInfo(lcConn) << "All" << m_links.size() << "links connected in" << elapsed << "ms";
+        m_outage.invalidate();
+        emit allLinksConnected(elapsed);
+    }
+}
+
+void ConnectionManager::reportFailed(const QString &id, const QString &reason)
+{
+    auto it = m_links.find(id);
+    if (it == m_links.end() || it->state == LinkState::Backoff) return;
+
+    if (it->state == LinkState::Connected) {
+        qCWarning(lcConn) << roleName(it->role) << id << "lost:" << reason;
+        it->sinceLost.start();
+        if (!m_outage.isValid()) {
+            m_outage.start();
+        }
+    } else {
+        qCWarning(lcConn) << roleName(it->role) << id << "attempt" << it->attempts << "failed:" << reason;
+    }
+
+    scheduleRetry(*it);
+}
+
+void ConnectionManager::scheduleRetry(Link &link)
+{
+    int delay = backoffDelay(link.attempts);
+    link.state = LinkState::Backoff;
+    link.timer->start(delay);
+    qCInfo(lcConn) << "Retrying" << roleName(link.role) << link.device.name() << "in" << delay << "ms";
+}
+
+int ConnectionManager::backoffDelay(int attempts)
+{
+    // Exponential, capped; "equal jitter" keeps at least half the delay so
+    // links that failed together do not retry in lockstep
+    qint64 ceiling = BACKOFF_BASE_MS;
+    for (int i = 1; i < attempts && ceiling < BACKOFF_MAX_MS; i++) {
+        ceiling *= 2;
+    }
+    ceiling = qMin<qint64>(ceiling, BACKOFF_MAX_MS);
+    int half = int(ceiling / 2);
+    return half + QRandomGenerator::global()->bounded(half + 1);
+}
+
+QString ConnectionManager::roleName(Role role)
+{
+    switch (role) {
+    case Role::DE1: return "DE1";
+    case Role::Scale: return "Scale";
+    case Role::Sensor: return "Sensor";
+    }
+    return QString();
+}
+
+void ConnectionManager::requestLowLatency(QLowEnergyController *controller)
+{
+#if defined(Q_OS_LINUX) || defined(Q_OS_ANDROID)
+    // 7.5-15 ms interval, no peripheral latency. Only BlueZ and Android
+    // implement connection updates; elsewhere the OS picks the parameters.
+    QLowEnergyConnectionParameters params;
+    params.setIntervalRange(7.5, 15.0);
+    params.setLatency(0);
+    params.setSupervisionTimeout(4000);
+    controller->requestConnectionUpdate(params);
+#else
+    Q_UNUSED(controller);
+#endif
+}
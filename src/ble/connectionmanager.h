@@ -0,0 +1,91 @@
+#ifndef CONNECTIONMANAGER_H
+#define CONNECTIONMANAGER_H
+
+#include <QObject>
+#include <QBluetoothDeviceInfo>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QTimer>
+#include <functional>
+
+class QLowEnergyController;
+
+/**
+ * @brief Keeps every BLE link (DE1, scale, sensors) connected
+ *
+ * Each link is an independent state machine: an attempt is started through
+ * the link's connector, the device owner reports the outcome, and failed
+ * attempts or dropped links are retried with exponential backoff and jitter.
+ * Links never wait on each other or on the scanner, so after a power cut
+ * all devices reconnect in parallel.
+ *
+ * The time from start() (or from the first link lost while everything was
+ * up) until all links are connected again is logged.
+ */
+class ConnectionManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Role { DE1, Scale, Sensor };
+    enum class LinkState { Connecting, Connected, Backoff };
+
+    // Starts one connection attempt to the device
+    using Connector = std::function<void(const QBluetoothDeviceInfo &device)>;
+
+    explicit ConnectionManager(QObject *parent = nullptr);
+    ~ConnectionManager();
+
+    // Begins measuring time-to-all-connected
+    void start();
+    // Forgets all links and cancels pending retries
+    void clear();
+
+    // Adds a link and starts connecting immediately; replaces an existing link with the same id
+    void addLink(const QString &id, Role role, const QBluetoothDeviceInfo &device, Connector connector);
+    void removeLink(const QString &id);
+    bool hasLink(const QString &id) const { return m_links.contains(id); }
+    QBluetoothDeviceInfo device(const QString &id) const;
+    bool isConnected(const QString &id) const;
+    bool allConnected() const;
+
+    // The device was just seen advertising: skip the rest of a pending backoff
+    void retryNow(const QString &id);
+
+    // Outcome reports from device owners; unknown ids are ignored
+    void reportConnected(const QString &id);
+    // An attempt failed or an established link dropped: retry after backoff
+    void reportFailed(const QString &id, const QString &reason);
+
+    // Ask for a short connection interval on platforms that support it
+    static void requestLowLatency(QLowEnergyController *controller);
+
+signals:
+    void allLinksConnected(qint64 elapsedMs);
+
+private:
+    struct Link {
+        Role role = Role::DE1;
+        QBluetoothDeviceInfo device;
+        Connector connector;
+        LinkState state = LinkState::Connecting;
+        int attempts = 0;
+        QElapsedTimer sinceLost;
+        QTimer *timer = nullptr;  // attempt timeout or retry delay, owned by the manager
+    };
+
+    void attempt(const QString &id);
+    void onTimer(const QString &id);
+    void scheduleRetry(Link &link);
+    static int backoffDelay(int attempts);
+    static QString roleName(Role role);
+
+    QHash<QString, Link> m_links;
+    QElapsedTimer m_outage;
+
+    static constexpr int ATTEMPT_TIMEOUT_MS = 15000;
+    static constexpr int BACKOFF_BASE_MS = 500;
+    static constexpr int BACKOFF_MAX_MS = 30000;
+};
+
+#endif // CONNECTIONMANAGER_H
@@ -0,0 +1,34 @@
+#ifndef DATAGENERATION_H
+#define DATAGENERATION_H
+
+#include <QtGlobal>
+#include <atomic>
+
+/**
+ * @brief Change stamp for a group of device readings
+ *
+ * Every bump() draws from one process-wide sequence, so a stamp is never
+ * reused, not even by a device object created later, and the largest of
+ * several stamps moves whenever any of them does. Readers keep whatever
+ * they derive from the data (e.g. a serialized response) together with
+ * the stamp and rebuild only on mismatch.
+ */
+class DataGeneration
+{
+public:
+    DataGeneration() : m_value(next()) {}
+
+    quint64 value() const { return m_value; }
+    void bump() { m_value = next(); }
+
+private:
+    static quint64 next()
+    {
+        static std::atomic<quint64> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    quint64 m_value;
+};
+
+#endif // DATAGENERATION_H
@@ -1,5 +1,7 @@
 #include "de1device.h"
-#include "protocol/binarycodec.h"
+#include "protocol/de1packets.h"
+#include "connectionmanager.h"
+#include "mmrclient.h"
 
 #include <QLoggingCategory>
 #include <QJsonObject>
@@ -8,9 +10,26 @@
 
 Q_LOGGING_CATEGORY(lcDE1, "bridge.de1")
 
+namespace {
+
+QString characteristicName(const QBluetoothUuid &uuid)
+{
+    if (uuid == DE1::Characteristic::STATE_INFO) return "STATE_INFO";
+    if (uuid == DE1::Characteristic::SHOT_SAMPLE) return "SHOT_SAMPLE";
+    if (uuid == DE1::Characteristic::WATER_LEVELS) return "WATER_LEVELS";
+    if (uuid == DE1::Characteristic::TEMPERATURES) return "TEMPERATURES";
+    if (uuid == DE1::Characteristic::READ_FROM_MMR) return "READ_FROM_MMR";
+    return uuid.toString();
+}
+
+} // namespace
+
 DE1Device::DE1Device(QObject *parent)
     : QObject(parent)
 {
+    m_mmr = new MmrClient([this](const QBluetoothUuid &uuid, const QByteArray &packet) {
+        writeCharacteristic(uuid, packet);
+    }, this);
 }
 
 DE1Device::~DE1Device()
@@ -31,6 +50,7 @@ void DE1Device::connectToDevice(const QBluetoothDeviceInfo &device)
     emit nameChanged();
 
     qCInfo(lcDE1) << "Connecting to" << m_name << "at" << m_address;
+    m_connectTimer.start();
 
     m_controller = QLowEnergyController::createCentral(device, this);
 
@@ -50,6 +70,8 @@ void DE1Device::connectToDevice(const QBluetoothDeviceInfo &device)
 
 void DE1Device::disconnect()
 {
+    m_mmr->reset();
+
     if (m_service) {
         delete m_service;
         m_service = nullptr;
@@ -61,8 +83,11 @@ void DE1Device::disconnect()
         m_controller = nullptr;
     }
 
+    m_hasTemperatures = false;
+
     if (m_connected) {
         m_connected = false;
+        m_infoGeneration.bump();
         emit connectedChanged(false);
     }
 
@@ -75,14 +100,18 @@ void DE1Device::disconnect()
 void DE1Device::onControllerConnected()
 {
     qCInfo(lcDE1) << "Connected, discovering services...";
+    ConnectionManager::requestLowLatency(m_controller);
     m_controller->discoverServices();
 }
 
 void DE1Device::onControllerDisconnected()
 {
     qCInfo(lcDE1) << "Disconnected";
+    m_mmr->reset();
     m_connected = false;
+    m_hasTemperatures = false;
     m_connecting = false;
+    m_infoGeneration.bump();
     emit connectedChanged(false);
     emit connectingChanged(false);
 }
@@ -99,6 +128,12 @@ void DE1Device::onServiceDiscovered(const QBluetoothUuid &uuid)
 
     if (uuid == DE1::SERVICE_UUID) {
         qCInfo(lcDE1) << "Found DE1 service";
+
+        // Layout known from an earlier connection: no need to wait for the
+        // remaining services before discovering the DE1 characteristics
+        if (m_knownServices.contains(DE1::SERVICE_UUID) && !m_service) {
+            openService();
+        }
     }
 }
 
@@ -106,8 +141,24 @@ void DE1Device::onServiceDiscoveryFinished()
 {
     qCInfo(lcDE1) << "Service discovery finished";
 
+    if (!m_service) {
+        openService();
+    }
+}
+
+QList<QBluetoothUuid> DE1Device::services() const
+{
+    return m_controller ? m_controller->services() : QList<QBluetoothUuid>();
+}
+
+void DE1Device::openService()
+{
     m_service = m_controller->createServiceObject(DE1::SERVICE_UUID, this);
     if (!m_service) {
+        // Some backends only publish services once discovery has finished
+        if (m_controller->state() == QLowEnergyController::DiscoveringState) {
+            return;
+        }
         qCWarning(lcDE1) << "DE1 service not found";
         emit error("DE1 service not found");
         disconnect();
@@ -120,6 +171,12 @@ void DE1Device::onServiceDiscoveryFinished()
             this, &DE1Device::onCharacteristicChanged);
     connect(m_service, &QLowEnergyService::characteristicRead,
             this, &DE1Device::onCharacteristicRead);
+    connect(m_service, &QLowEnergyService::characteristicWritten,
+            this, [this](const QLowEnergyCharacteristic &c, const QByteArray &) {
+        if (c.uuid() == DE1::Characteristic::WRITE_TO_MMR) {
+            m_mmr->handleWritten();
+        }
+    });
     connect(m_service, &QLowEnergyService::descriptorWritten,
             this, [](const QLowEnergyDescriptor &d, const QByteArray &value) {
         qCInfo(lcDE1) << "[DE1] Descriptor written:" << d.uuid().toString() << "value:" << value.toHex();
@@ -142,61 +199,120 @@ void DE1Device::onServiceStateChanged(QLowEnergyService::ServiceState state)
 
 void DE1Device::setupService()
 {
-    qCInfo(lcDE1) << "[DE1] setupService called";
+    qCInfo(lcDE1) << "[DE1] setupService called, ready" << m_connectTimer.elapsed()
+                  << "ms after connect" << (m_knownServices.isEmpty() ? "(first connection)" : "(known layout)");
 
     m_connecting = false;
     m_connected = true;
     emit connectingChanged(false);
+    m_infoGeneration.bump();
     emit connectedChanged(true);
 
     subscribeToCharacteristics();
 
     // Read initial state
-    auto stateChar = m_service->characteristic(DE1::Characteristic::STATE_INFO);
-    if (stateChar.isValid()) {
-        m_service->readCharacteristic(stateChar);
+    readCharacteristic(DE1::Characteristic::STATE_INFO);
+    readCharacteristic(DE1::Characteristic::VERSION);
+    readCharacteristic(DE1::Characteristic::WATER_LEVELS);
+    readCharacteristic(DE1::Characteristic::SHOT_SETTINGS);
+    readMachineInfo();
+}
+
+void DE1Device::readMachineInfo()
+{
+    // Three register reads in three round trips, sent together: the model
+    // word alone, GHC_INFO and SERIAL_NUMBER are too far apart to share a
+    // four-word window
+    m_mmr->read(DE1::MMR::MACHINE_MODEL, [this](bool ok, uint32_t value) {
+        if (!ok) return;
+        m_model = static_cast<DE1::MachineModel>(value);
+        qCInfo(lcDE1) << "Machine model:" << modelName();
+        m_infoGeneration.bump();
+        emit machineInfoChanged();
+    });
+    m_mmr->read(DE1::MMR::GHC_INFO, [this](bool ok, uint32_t value) {
+        if (!ok) return;
+        // Nonzero when a group head controller is fitted
+        m_hasGHC = value != 0;
+        m_infoGeneration.bump();
+        emit machineInfoChanged();
+    });
+    m_mmr->read(DE1::MMR::SERIAL_NUMBER, [this](bool ok, uint32_t value) {
+        if (!ok) return;
+        m_serialNumber = QString::number(value);
+        m_infoGeneration.bump();
+        emit machineInfoChanged();
+    });
+}
+
+void DE1Device::readCharacteristic(const QBluetoothUuid &uuid)
+{
+    auto characteristic = m_service->characteristic(uuid);
+    if (characteristic.isValid()) {
+        m_service->readCharacteristic(characteristic);
     }
+}
+
+void DE1Device::subscribeToCharacteristics()
+{
+    qCInfo(lcDE1) << "[DE1] subscribeToCharacteristics called";
 
-    auto versionChar = m_service->characteristic(DE1::Characteristic::VERSION);
-    if (versionChar.isValid()) {
-        m_service->readCharacteristic(versionChar);
+    setNotifications(DE1::Characteristic::STATE_INFO, true);
+    // Register read responses arrive as notifications
+    setNotifications(DE1::Characteristic::READ_FROM_MMR, true);
+    for (const QBluetoothUuid &uuid : std::as_const(m_wantedNotifications)) {
+        setNotifications(uuid, true);
     }
+}
 
-    auto waterChar = m_service->characteristic(DE1::Characteristic::WATER_LEVELS);
-    if (waterChar.isValid()) {
-        m_service->readCharacteristic(waterChar);
+void DE1Device::setNotifications(const QBluetoothUuid &uuid, bool enable)
+{
+    const QString name = characteristicName(uuid);
+    auto characteristic = m_service->characteristic(uuid);
+    if (!characteristic.isValid()) {
+        qCWarning(lcDE1) << "Characteristic not found:" << name;
+        return;
     }
 
-    auto shotSettingsChar = m_service->characteristic(DE1::Characteristic::SHOT_SETTINGS);
-    if (shotSettingsChar.isValid()) {
-        m_service->readCharacteristic(shotSettingsChar);
+    auto descriptor = characteristic.descriptor(
+        QBluetoothUuid::DescriptorType::ClientCharacteristicConfiguration);
+    if (!descriptor.isValid()) {
+        qCWarning(lcDE1) << "No CCCD descriptor for" << name;
+        return;
     }
+
+    qCInfo(lcDE1) << "[DE1]" << (enable ? "Enabling" : "Disabling") << "notifications for" << name;
+    m_service->writeDescriptor(descriptor, QByteArray::fromHex(enable ? "0100" : "0000"));
 }
 
-void DE1Device::subscribeToCharacteristics()
+bool DE1Device::notificationsWanted(const QBluetoothUuid &characteristic) const
 {
-    qCInfo(lcDE1) << "[DE1] subscribeToCharacteristics called";
+    return characteristic == DE1::Characteristic::STATE_INFO
+        || m_wantedNotifications.contains(characteristic);
+}
+
+void DE1Device::setNotificationsWanted(const QBluetoothUuid &characteristic, bool wanted)
+{
+    if (characteristic == DE1::Characteristic::STATE_INFO) return;
+    if (m_wantedNotifications.contains(characteristic) == wanted) return;
 
-    auto enableNotify = [this](const QBluetoothUuid &uuid, const QString &name) {
-        auto characteristic = m_service->characteristic(uuid);
-        if (characteristic.isValid()) {
-            auto descriptor = characteristic.descriptor(
-                QBluetoothUuid::DescriptorType::ClientCharacteristicConfiguration);
-            if (descriptor.isValid()) {
-                qCInfo(lcDE1) << "[DE1] Enabling notifications for" << name;
-                m_service->writeDescriptor(descriptor, QByteArray::fromHex("0100"));
-            } else {
-                qCWarning(lcDE1) << "No CCCD descriptor for" << name;
-            }
-        } else {
-            qCWarning(lcDE1) << "Characteristic not found:" << name;
+    if (wanted) {
+        m_wantedNotifications.insert(characteristic);
+    } else {
+        m_wantedNotifications.remove(characteristic);
+        if (characteristic == DE1::Characteristic::TEMPERATURES) {
+            m_hasTemperatures = false;
         }
-    };
+    }
 
-    enableNotify(DE1::Characteristic::STATE_INFO, "STATE_INFO");
-    enableNotify(DE1::Characteristic::SHOT_SAMPLE, "SHOT_SAMPLE");
-    enableNotify(DE1::Characteristic::WATER_LEVELS, "WATER_LEVELS");
-    enableNotify(DE1::Characteristic::TEMPERATURES, "TEMPERATURES");
+    if (!m_connected || !m_service) return;
+
+    setNotifications(characteristic, wanted);
+    // Levels and heater readings only notify on change; read once so a new
+    // consumer starts from the current value instead of a stale one
+    if (wanted && characteristic != DE1::Characteristic::SHOT_SAMPLE) {
+        readCharacteristic(characteristic);
+    }
 }
 
 void DE1Device::onCharacteristicChanged(const QLowEnergyCharacteristic &c, const QByteArray &value)
@@ -211,6 +327,11 @@ void DE1Device::onCharacteristicChanged(const QLowEnergyCharacteristic &c, const
         parseWaterLevels(value);
     } else if (c.uuid() == DE1::Characteristic::SHOT_SETTINGS) {
         parseShotSettings(value);
+    } else if (c.uuid() == DE1::Characteristic::TEMPERATURES
+               && m_wantedNotifications.contains(DE1::Characteristic::TEMPERATURES)) {
+        parseTemperatures(value);
+    } else if (c.uuid() == DE1::Characteristic::READ_FROM_MMR) {
+        m_mmr->handleReadResponse(value);
     }
 }
 
@@ -235,6 +356,9 @@ void DE1Device::parseStateInfo(const QByteArray &data)
         qCInfo(lcDE1) << "State:" << stateString() << "/" << subStateString();
     }
 
+    m_stateGeneration.bump();
+    m_stateInfoGeneration.bump();
+
     QJsonObject state;
     state["state"] = stateString();
     state["substate"] = subStateString();
@@ -243,30 +367,20 @@ void DE1Device::parseStateInfo(const QByteArray &data)
 
 void DE1Device::parseShotSample(const QByteArray &data)
 {
-    if (data.size() < 16) return;
+    DE1::ShotSample shot;
+    if (!DE1::ShotSampleLayout::decode(data, shot)) return;
 
     qCDebug(lcDE1) << "[DE1] Shot sample received, parsing...";
 
-    // Parse shot sample (DE1 T_ShotSample BLE characteristic)
-    // Bytes 0-1:   Timer (uint16 BE, 0.01s units)
-    // Byte 2:      GroupPressure (U8P4)
-    // Byte 3:      GroupFlow (U8P4)
-    // Bytes 4-5:   MixTemp (U16P8)
-    // Bytes 6-7:   HeadTemp (U16P8)
-    // Bytes 8-9:   SetMixTemp (U16P8)
-    // Bytes 10-11: SetHeadTemp (U16P8, offset +73)
-    // Byte 12:     SetGroupPressure (U8P4)
-    // Byte 13:     SetGroupFlow (U8P4)
-    // Byte 14:     FrameNumber
-    // Byte 15:     SteamTemp (U8P0)
-
-    m_pressure = BinaryCodec::decodeU8P4(static_cast<uint8_t>(data[2]));
-    m_flow = BinaryCodec::decodeU8P4(static_cast<uint8_t>(data[3]));
-    m_mixTemp = BinaryCodec::decodeU16P8(BinaryCodec::decodeShortBE(data, 4));
-    m_headTemp = BinaryCodec::decodeU16P8(BinaryCodec::decodeShortBE(data, 6));
-    m_targetPressure = BinaryCodec::decodeU8P4(static_cast<uint8_t>(data[12]));
-    m_targetFlow = BinaryCodec::decodeU8P4(static_cast<uint8_t>(data[13]));
-    m_steamTemp = static_cast<double>(static_cast<uint8_t>(data[15]));
+    // Layout of the T_ShotSample characteristic: see DE1::ShotSampleLayout
+    m_pressure = shot.groupPressure;
+    m_flow = shot.groupFlow;
+    m_mixTemp = shot.mixTemp;
+    m_headTemp = shot.headTemp;
+    m_targetPressure = shot.setGroupPressure;
+    m_targetFlow = shot.setGroupFlow;
+    m_steamTemp = shot.steamTemp;
+    m_stateGeneration.bump();
 
     QJsonObject sample;
     sample["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
@@ -277,7 +391,7 @@ void DE1Device::parseShotSample(const QByteArray &data)
     sample["targetPressure"] = m_targetPressure;
     sample["targetFlow"] = m_targetFlow;
     sample["steamTemperature"] = m_steamTemp;
-    sample["profileFrame"] = static_cast<int>(static_cast<uint8_t>(data[14]));
+    sample["profileFrame"] = static_cast<int>(shot.frameNumber);
 
     QJsonObject stateObj;
     stateObj["state"] = stateString();
@@ -289,15 +403,15 @@ void DE1Device::parseShotSample(const QByteArray &data)
 
 void DE1Device::parseWaterLevels(const QByteArray &data)
 {
-    if (data.size() < 4) return;
+    DE1::WaterLevels water;
+    if (!DE1::WaterLevelsLayout::decode(data, water)) return;
 
-    // Bytes 0-1: Current level (uint16 BE, mm)
-    // Bytes 2-3: Start level (uint16 BE, mm)
-    m_waterLevel = BinaryCodec::decodeShortBE(data, 0);
+    m_waterLevel = water.currentLevel;
+    m_waterLevelGeneration.bump();
 
     QJsonObject levels;
     levels["currentLevel"] = m_waterLevel;
-    levels["startLevel"] = static_cast<int>(BinaryCodec::decodeShortBE(data, 2));
+    levels["startLevel"] = static_cast<int>(water.startLevel);
 
     emit waterLevelsChanged(levels);
 }
@@ -312,35 +426,71 @@ void DE1Device::parseVersions(const QByteArray &data)
     int fwMajor = static_cast<uint8_t>(data[1]);
     int fwMinor = static_cast<uint8_t>(data[2]);
     m_firmwareVersion = QString("%1.%2").arg(fwMajor).arg(fwMinor);
+    m_infoGeneration.bump();
 
     qCInfo(lcDE1) << "Firmware version:" << m_firmwareVersion;
 }
 
 void DE1Device::parseShotSettings(const QByteArray &data)
 {
-    if (data.size() < 9) return;
-
-    // ShotSettings characteristic format (9 bytes):
-    // Byte 0: Steam setting (0-3)
-    // Byte 1: Target steam temp (C)
-    // Byte 2: Target steam duration (s)
-    // Byte 3: Target hot water temp (C)
-    // Byte 4: Target hot water volume (ml)
-    // Byte 5: Target hot water duration (s)
-    // Byte 6: Target shot volume (ml)
-    // Bytes 7-8: Group temp (U16P8 big-endian)
-
-    m_steamSetting = static_cast<uint8_t>(data[0]);
-    m_targetSteamTemp = static_cast<uint8_t>(data[1]);
-    m_targetSteamDuration = static_cast<uint8_t>(data[2]);
-    m_targetHotWaterTemp = static_cast<uint8_t>(data[3]);
-    m_targetHotWaterVolume = static_cast<uint8_t>(data[4]);
-    m_targetHotWaterDuration = static_cast<uint8_t>(data[5]);
-    m_targetShotVolume = static_cast<uint8_t>(data[6]);
-    m_targetGroupTemp = BinaryCodec::decodeU16P8(BinaryCodec::decodeShortBE(data, 7));
+    DE1::ShotSettings settings;
+    if (!DE1::ShotSettingsLayout::decode(data, settings)) return;
+
+    m_steamSetting = settings.steamSetting;
+    m_targetSteamTemp = settings.targetSteamTemp;
+    m_targetSteamDuration = settings.targetSteamDuration;
+    m_targetHotWaterTemp = settings.targetHotWaterTemp;
+    m_targetHotWaterVolume = settings.targetHotWaterVolume;
+    m_targetHotWaterDuration = settings.targetHotWaterDuration;
+    m_targetShotVolume = settings.targetShotVolume;
+    m_targetGroupTemp = settings.groupTemp;
+    m_shotSettingsGeneration.bump();
 
     qCInfo(lcDE1) << "Shot settings: steam" << m_targetSteamTemp << "C, hotWater"
                   << m_targetHotWaterTemp << "C, group" << m_targetGroupTemp << "C";
+    emit shotSettingsChanged();
+}
+
+void DE1Device::parseTemperatures(const QByteArray &data)
+{
+    DE1::Temperatures temps;
+    if (!DE1::TemperaturesLayout::decode(data, temps)) return;
+
+    const bool first = !m_hasTemperatures;
+    m_temperatures = temps;
+    m_hasTemperatures = true;
+
+    // Heaters report continuously; only pass on changes a client would notice
+    auto moved = [](double now, double sent) { return qAbs(now - sent) >= TEMPERATURE_THRESHOLD; };
+    const DE1::Temperatures &sent = m_sentTemperatures;
+    if (!first
+        && !moved(temps.waterHeater, sent.waterHeater)
+        && !moved(temps.steamHeater, sent.steamHeater)
+        && !moved(temps.groupHead, sent.groupHead)
+        && !moved(temps.coldWater, sent.coldWater)
+        && !moved(temps.targetWaterHeater, sent.targetWaterHeater)
+        && !moved(temps.targetSteamHeater, sent.targetSteamHeater)
+        && !moved(temps.targetGroupHead, sent.targetGroupHead)
+        && !moved(temps.targetColdWater, sent.targetColdWater)) {
+        return;
+    }
+
+    m_sentTemperatures = temps;
+    emit temperaturesChanged(temperaturesToJson());
+}
+
+QJsonObject DE1Device::temperaturesToJson() const
+{
+    QJsonObject obj;
+    obj["waterHeater"] = m_temperatures.waterHeater;
+    obj["steamHeater"] = m_temperatures.steamHeater;
+    obj["groupHead"] = m_temperatures.groupHead;
+    obj["coldWater"] = m_temperatures.coldWater;
+    obj["targetWaterHeater"] = m_temperatures.targetWaterHeater;
+    obj["targetSteamHeater"] = m_temperatures.targetSteamHeater;
+    obj["targetGroupHead"] = m_temperatures.targetGroupHead;
+    obj["targetColdWater"] = m_temperatures.targetColdWater;
+    return obj;
 }
 
 bool DE1Device::requestState(const QString &stateName)
@@ -382,20 +532,20 @@ void DE1Device::setUsbCharger(bool enable)
 {
     if (!m_connected) return;
 
-    QByteArray data(4, 0);
-    data[0] = enable ? 1 : 0;
-    writeMMR(DE1::MMR::USB_CHARGER, data);
     m_usbCharger = enable;
+    m_mmr->write(DE1::MMR::USB_CHARGER, enable ? 1 : 0, [](bool ok) {
+        if (!ok) qCWarning(lcDE1) << "USB charger setting not acknowledged";
+    });
 }
 
 void DE1Device::setFanThreshold(int temp)
 {
     if (!m_connected) return;
 
-    QByteArray data(4, 0);
-    data[0] = static_cast<char>(temp);
-    writeMMR(DE1::MMR::FAN_THRESHOLD, data);
     m_fanThreshold = temp;
+    m_mmr->write(DE1::MMR::FAN_THRESHOLD, static_cast<uint32_t>(temp), [](bool ok) {
+        if (!ok) qCWarning(lcDE1) << "Fan threshold not acknowledged";
+    });
 }
 
 void DE1Device::setShotSettings(int steamSetting, int steamTemp, int steamDuration,
@@ -404,21 +554,17 @@ void DE1Device::setShotSettings(int steamSetting, int steamTemp, int steamDurati
 {
     if (!m_connected || !m_service) return;
 
-    QByteArray data(9, 0);
-    data[0] = static_cast<char>(steamSetting);
-    data[1] = static_cast<char>(steamTemp);
-    data[2] = static_cast<char>(steamDuration);
-    data[3] = static_cast<char>(hotWaterTemp);
-    data[4] = static_cast<char>(hotWaterVolume);
-    data[5] = static_cast<char>(hotWaterDuration);
-    data[6] = static_cast<char>(shotVolume);
-
-    uint16_t groupTempEncoded = BinaryCodec::encodeU16P8(groupTemp);
-    QByteArray groupTempBE = BinaryCodec::encodeShortBE(groupTempEncoded);
-    data[7] = groupTempBE[0];
-    data[8] = groupTempBE[1];
+    DE1::ShotSettings settings;
+    settings.steamSetting = static_cast<uint8_t>(steamSetting);
+    settings.targetSteamTemp = static_cast<uint8_t>(steamTemp);
+    settings.targetSteamDuration = static_cast<uint8_t>(steamDuration);
+    settings.targetHotWaterTemp = static_cast<uint8_t>(hotWaterTemp);
+    settings.targetHotWaterVolume = static_cast<uint8_t>(hotWaterVolume);
+    settings.targetHotWaterDuration = static_cast<uint8_t>(hotWaterDuration);
+    settings.targetShotVolume = static_cast<uint8_t>(shotVolume);
+    settings.groupTemp = groupTemp;
 
-    writeCharacteristic(DE1::Characteristic::SHOT_SETTINGS, data);
+    writeCharacteristic(DE1::Characteristic::SHOT_SETTINGS, DE1::ShotSettingsLayout::toByteArray(settings));
 
     // Update local values
     m_steamSetting = steamSetting;
@@ -429,8 +575,10 @@ void DE1Device::setShotSettings(int steamSetting, int steamTemp, int steamDurati
     m_targetHotWaterDuration = hotWaterDuration;
     m_targetShotVolume = shotVolume;
     m_targetGroupTemp = groupTemp;
+    m_shotSettingsGeneration.bump();
 
     qCInfo(lcDE1) << "Shot settings updated";
+    emit shotSettingsChanged();
 }
 
 QJsonObject DE1Device::shotSettingsToJson() const
@@ -538,21 +686,6 @@ void DE1Device::writeCharacteristic(const QBluetoothUuid &uuid, const QByteArray
     }
 }
 
-void DE1Device::readMMR(uint32_t address)
-{
-    QByteArray data = BinaryCodec::encodeU24P0(address);
-    data.prepend(static_cast<char>(data.size())); // Length byte
-    writeCharacteristic(DE1::Characteristic::READ_FROM_MMR, data);
-}
-
-void DE1Device::writeMMR(uint32_t address, const QByteArray &payload)
-{
-    QByteArray data = BinaryCodec::encodeU24P0(address);
-    data.append(payload);
-    data.prepend(static_cast<char>(data.size())); // Length byte
-    writeCharacteristic(DE1::Characteristic::WRITE_TO_MMR, data);
-}
-
 QString DE1Device::modelName() const
 {
     switch (m_model) {
@@ -583,6 +716,10 @@ QJsonObject DE1Device::toSnapshot() const
     obj["targetFlow"] = m_targetFlow;
     obj["steamTemperature"] = m_steamTemp;
 
+    if (m_hasTemperatures) {
+        obj["temperatures"] = temperaturesToJson();
+    }
+
     return obj;
 }
 
@@ -3,11 +3,17 @@
 
 #include <QObject>
 #include <QBluetoothDeviceInfo>
+#include <QElapsedTimer>
 #include <QLowEnergyController>
 #include <QLowEnergyService>
 #include <QJsonObject>
+#include <QSet>
 
+#include "datageneration.h"
 #include "protocol/de1characteristics.h"
+#include "protocol/de1packets.h"
+
+class MmrClient;
 
 /**
  * @brief DE1 espresso machine BLE communication
@@ -33,6 +39,12 @@ public:
     bool isConnected() const { return m_connected; }
     bool isConnecting() const { return m_connecting; }
 
+    // Services seen on this machine before; lets the next connection start
+    // on the DE1 service as soon as it shows up instead of after full discovery
+    void setKnownServices(const QList<QBluetoothUuid> &services) { m_knownServices = services; }
+    // Services found during the current connection
+    QList<QBluetoothUuid> services() const;
+
     // Device info
     QString name() const { return m_name; }
     QString address() const { return m_address; }
@@ -57,6 +69,17 @@ public:
     double targetFlow() const { return m_targetFlow; }
     int waterLevel() const { return m_waterLevel; }
 
+    // Heater temperatures, only kept current while temperature notifications are on
+    bool hasTemperatures() const { return m_hasTemperatures; }
+    const DE1::Temperatures &temperatures() const { return m_temperatures; }
+    QJsonObject temperaturesToJson() const;
+
+    // SHOT_SAMPLE, WATER_LEVELS and TEMPERATURES are only subscribed while
+    // someone consumes them; STATE_INFO is always on. Applied immediately
+    // when connected, otherwise on the next connection.
+    void setNotificationsWanted(const QBluetoothUuid &characteristic, bool wanted);
+    bool notificationsWanted(const QBluetoothUuid &characteristic) const;
+
     // Commands
     bool requestState(const QString &stateName);
     bool requestState(DE1::State state);
@@ -89,6 +112,16 @@ public:
     QJsonObject toSnapshot() const;
     QJsonObject toMachineInfo() const;
 
+    // Change stamps (see DataGeneration) for caching what is built from:
+    // connection, name and machine info
+    quint64 infoGeneration() const { return m_infoGeneration.value(); }
+    // state, substate and shot sample readings
+    quint64 stateGeneration() const { return m_stateGeneration.value(); }
+    // state and substate only
+    quint64 stateInfoGeneration() const { return m_stateInfoGeneration.value(); }
+    quint64 waterLevelGeneration() const { return m_waterLevelGeneration.value(); }
+    quint64 shotSettingsGeneration() const { return m_shotSettingsGeneration.value(); }
+
 signals:
     void connectedChanged(bool connected);
     void connectingChanged(bool connecting);
@@ -96,6 +129,12 @@ signals:
     void stateChanged(const QJsonObject &state);
     void shotSampleReceived(const QJsonObject &sample);
     void waterLevelsChanged(const QJsonObject &levels);
+    // Read from the machine or written through setShotSettings()
+    void shotSettingsChanged();
+    // Emitted when any reading moved by TEMPERATURE_THRESHOLD since the last emit
+    void temperaturesChanged(const QJsonObject &temperatures);
+    // Model, serial number or GHC read from the machine's registers
+    void machineInfoChanged();
     void error(const QString &message);
 
 private slots:
@@ -109,19 +148,25 @@ private slots:
     void onCharacteristicRead(const QLowEnergyCharacteristic &c, const QByteArray &value);
 
 private:
+    void openService();
     void setupService();
     void subscribeToCharacteristics();
+    void setNotifications(const QBluetoothUuid &uuid, bool enable);
+    void readCharacteristic(const QBluetoothUuid &uuid);
     void parseStateInfo(const QByteArray &data);
     void parseShotSample(const QByteArray &data);
     void parseWaterLevels(const QByteArray &data);
     void parseVersions(const QByteArray &data);
     void parseShotSettings(const QByteArray &data);
-    void readMMR(uint32_t address);
-    void writeMMR(uint32_t address, const QByteArray &data);
+    void parseTemperatures(const QByteArray &data);
+    void readMachineInfo();
     void writeCharacteristic(const QBluetoothUuid &uuid, const QByteArray &data);
 
     QLowEnergyController *m_controller = nullptr;
     QLowEnergyService *m_service = nullptr;
+    QList<QBluetoothUuid> m_knownServices;
+    QElapsedTimer m_connectTimer;
+    MmrClient *m_mmr = nullptr;
 
     bool m_connected = false;
     bool m_connecting = false;
@@ -148,6 +193,21 @@ private:
     double m_targetFlow = 0;
     int m_waterLevel = 0;
 
+    // Notifications requested on top of STATE_INFO
+    QSet<QBluetoothUuid> m_wantedNotifications;
+
+    // Temperatures
+    bool m_hasTemperatures = false;
+    DE1::Temperatures m_temperatures;
+    DE1::Temperatures m_sentTemperatures;
+    static constexpr double TEMPERATURE_THRESHOLD = 0.25;  // C
+
+    DataGeneration m_infoGeneration;
+    DataGeneration m_stateGeneration;
+    DataGeneration m_stateInfoGeneration;
+    DataGeneration m_waterLevelGeneration;
+    DataGeneration m_shotSettingsGeneration;
+
     // Settings
     bool m_usbCharger = false;
     int m_fanThreshold = 50;
@@ -0,0 +1,99 @@
+#include "devicecache.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLoggingCategory>
+#include <QSaveFile>
+
+Q_LOGGING_CATEGORY(lcDeviceCache, "bridge.ble.cache")
+
+DeviceCache::DeviceCache(const QString &path)
+    : m_path(path)
+{
+}
+
+void DeviceCache::load()
+{
+    m_entries.clear();
+
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    const QJsonObject devices = QJsonDocument::fromJson(file.readAll()).object();
+    for (auto it = devices.constBegin(); it != devices.constEnd(); ++it) {
+        const QJsonObject obj = it.value().toObject();
+        const QString name = obj["name"].toString();
+        const QString address = obj["address"].toString();
+
+        // Apple platforms hide MAC addresses and identify peripherals by UUID
+        Entry entry;
+        if (!address.isEmpty()) {
+            entry.device = QBluetoothDeviceInfo(QBluetoothAddress(address), name, 0);
+        } else {
+            entry.device = QBluetoothDeviceInfo(QBluetoothUuid(QUuid(obj["uuid"].toString())), name, 0);
+        }
+        entry.device.setCoreConfigurations(QBluetoothDeviceInfo::LowEnergyCoreConfiguration);
+        entry.type = obj["type"].toString();
+        for (const QJsonValue &service : obj["services"].toArray()) {
+            entry.services.append(QBluetoothUuid(QUuid(service.toString())));
+        }
+        m_entries.insert(it.key(), entry);
+    }
+
+    qCInfo(lcDeviceCache) << "Loaded" << m_entries.size() << "known devices";
+}
+
+void DeviceCache::remember(const QString &id, const QBluetoothDeviceInfo &device, const QString &type,
+                           const QList<QBluetoothUuid> &services)
+{
+    Entry &entry = m_entries[id];
+    entry.device = device;
+    entry.type = type;
+    if (!services.isEmpty()) {
+        entry.services = services;
+    }
+    save();
+}
+
+void DeviceCache::forget(const QString &id)
+{
+    if (m_entries.remove(id)) {
+        save();
+    }
+}
+
+void DeviceCache::save() const
+{
+    QJsonObject devices;
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        const Entry &entry = it.value();
+        QJsonObject obj;
+        obj["name"] = entry.device.name();
+        if (!entry.device.address().isNull()) {
+            obj["address"] = entry.device.address().toString();
+        } else {
+            obj["uuid"] = entry.device.deviceUuid().toString(QUuid::WithoutBraces);
+        }
+        obj["type"] = entry.type;
+        QJsonArray services;
+        for (const QBluetoothUuid &service : entry.services) {
+            services.append(service.toString(QUuid::WithoutBraces));
+        }
+        obj["services"] = services;
+        devices[it.key()] = obj;
+    }
+
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+    QSaveFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly)
+        || file.write(QJsonDocument(devices).toJson(QJsonDocument::Indented)) < 0
+        || !file.commit()) {
+        qCWarning(lcDeviceCache) << "Failed to save device cache:" << m_path;
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef DEVICECACHE_H
+#define DEVICECACHE_H
+
+#include <QBluetoothDeviceInfo>
+#include <QBluetoothUuid>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief Devices the bridge has connected to before
+ *
+ * Persists identity (address or platform UUID, name, type) and the GATT
+ * services found on each device, keyed by connection manager link id
+ * ("de1", "scale", "sensor:<address>"). On startup the bridge connects
+ * directly to these devices instead of waiting for a scan to find them.
+ */
+class DeviceCache
+{
+public:
+    struct Entry {
+        QBluetoothDeviceInfo device;
+        QString type;
+        QList<QBluetoothUuid> services;
+    };
+
+    explicit DeviceCache(const QString &path);
+
+    void load();
+
+    QStringList ids() const { return m_entries.keys(); }
+    bool contains(const QString &id) const { return m_entries.contains(id); }
+    Entry entry(const QString &id) const { return m_entries.value(id); }
+
+    // Records a successful connection; services are kept unless given
+    void remember(const QString &id, const QBluetoothDeviceInfo &device, const QString &type,
+                  const QList<QBluetoothUuid> &services = {});
+    void forget(const QString &id);
+
+private:
+    void save() const;
+
+    QString m_path;
+    QHash<QString, Entry> m_entries;
+};
+
+#endif // DEVICECACHE_H
@@ -0,0 +1,268 @@
+#include "deviceclassifier.h"
+#include "protocol/de1characteristics.h"
+
+#include <QHash>
+#include <array>
+#include <vector>
+
+namespace {
+
+struct Rule {
+    DeviceType type;
+    const char *namePrefix = nullptr;   // lowercase
+    QBluetoothUuid service;
+    quint16 manufacturerId = 0;
+};
+
+// Name patterns from de1app. Only services no other supported device uses
+// are listed: Decent, Varia and generic scales share FFF0, Felicita and the
+// Bookoo Monitor share FFE0, and Acaia uses the ISSC UART service.
+const Rule RULES[] = {
+    { DeviceType::DE1, "de1" },
+    { DeviceType::DE1, nullptr, DE1::SERVICE_UUID },
+
+    { DeviceType::DecentScale, "decent scale" },
+    { DeviceType::Acaia, "acaia" },
+    { DeviceType::Acaia, "lunar" },
+    { DeviceType::Acaia, "pearl" },
+    { DeviceType::Acaia, "proch" },
+    { DeviceType::AcaiaPyxis, "pyxis" },
+    { DeviceType::Felicita, "felicita" },
+    { DeviceType::Felicita, "ecompass" },
+    { DeviceType::Skale, "skale" },
+    { DeviceType::Skale, nullptr, Scale::Skale::SERVICE },
+    { DeviceType::HiroiaJimmy, "hiroia" },
+    { DeviceType::HiroiaJimmy, "jimmy" },
+    { DeviceType::HiroiaJimmy, nullptr, Scale::HiroiaJimmy::SERVICE },
+    { DeviceType::Bookoo, "bookoo" },
+    { DeviceType::Bookoo, "bkscale" },
+    { DeviceType::SmartChef, "smartchef" },
+    { DeviceType::Difluid, "difluid" },
+    { DeviceType::Difluid, "microbalance" },
+    { DeviceType::Difluid, nullptr, Scale::DiFluid::SERVICE },
+    { DeviceType::EurekaPrecisa, "eureka" },
+    { DeviceType::EurekaPrecisa, "precisa" },
+    { DeviceType::EurekaPrecisa, "cfs-9002" },
+    { DeviceType::SoloBarista, "solo barista" },
+    { DeviceType::SoloBarista, "lsj-001" },
+    { DeviceType::AtomheartEclair, "eclair" },
+    { DeviceType::AtomheartEclair, "atomheart" },
+    { DeviceType::AtomheartEclair, nullptr, Scale::AtomheartEclair::SERVICE },
+    { DeviceType::VariaAku, "aku" },
+    { DeviceType::VariaAku, "varia" },
+
+    // Every separator the monitor's firmware revisions have used
+    { DeviceType::BookooMonitor, "bookooem" },
+    { DeviceType::BookooMonitor, "bookoo em" },
+    { DeviceType::BookooMonitor, "bookoo-em" },
+    { DeviceType::BookooMonitor, "bookoo_em" },
+    { DeviceType::BookooMonitor, "bookoomonitor" },
+    { DeviceType::BookooMonitor, "bookoo monitor" },
+    { DeviceType::BookooMonitor, "bookoo-monitor" },
+    { DeviceType::BookooMonitor, "bookoo_monitor" },
+};
+
+// Matched anywhere in the name, and only when no prefix rule matched. The DE1
+// has always been recognised by "decent" anywhere in its name ("Decent Scale"
+// is a prefix rule and wins).
+const Rule NAME_FRAGMENTS[] = {
+    { DeviceType::DE1, "decent" },
+};
+
+// Characters that occur in advertised names we match; anything else ends the walk
+constexpr int ALPHABET = 40;
+
+int slot(char16_t c)
+{
+    if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a';
+    if (c >= '0' && c <= '9') return 26 + (c - '0');
+    switch (c) {
+    case ' ': return 36;
+    case '-': return 37;
+    case '_': return 38;
+    case '.': return 39;
+    default: return -1;
+    }
+}
+
+// Case-folding trie over lowercase patterns; a walk returns the longest match
+class Trie
+{
+public:
+    Trie() { m_nodes.emplace_back(); }
+
+    void insert(const char *pattern, DeviceType type)
+    {
+        int node = 0;
+        for (const char *p = pattern; *p; ++p) {
+            int s = slot(char16_t(*p));
+            Q_ASSERT(s >= 0);
+            if (m_nodes[node].next[s] == 0) {
+                m_nodes[node].next[s] = quint16(m_nodes.size());
+                m_nodes.emplace_back();
+            }
+            node = m_nodes[node].next[s];
+        }
+        m_nodes[node].type = type;
+    }
+
+    DeviceType longestPrefix(QStringView name) const
+    {
+        DeviceType match = DeviceType::Unknown;
+        int node = 0;
+        for (QChar c : name) {
+            int s = slot(c.unicode());
+            if (s < 0) break;
+            node = m_nodes[node].next[s];
+            if (node == 0) break;
+            if (m_nodes[node].type != DeviceType::Unknown) {
+                match = m_nodes[node].type;
+            }
+        }
+        return match;
+    }
+
+private:
+    struct Node {
+        std::array<quint16, ALPHABET> next{};   // 0 = no child (the root is never a child)
+        DeviceType type = DeviceType::Unknown;
+    };
+
+    std::vector<Node> m_nodes;
+};
+
+class Index
+{
+public:
+    Index()
+    {
+        for (const Rule &rule : RULES) {
+            if (rule.namePrefix) {
+                m_prefixes.insert(rule.namePrefix, rule.type);
+            }
+            if (!rule.service.isNull()) {
+                m_services.insert(rule.service, rule.type);
+            }
+            if (rule.manufacturerId != 0) {
+                m_manufacturers.insert(rule.manufacturerId, rule.type);
+            }
+        }
+        for (const Rule &rule : NAME_FRAGMENTS) {
+            m_fragments.insert(rule.namePrefix, rule.type);
+        }
+    }
+
+    DeviceType matchName(QStringView name) const
+    {
+        DeviceType match = m_prefixes.longestPrefix(name);
+        for (qsizetype i = 0; match == DeviceType::Unknown && i < name.size(); ++i) {
+            match = m_fragments.longestPrefix(name.mid(i));
+        }
+        return match;
+    }
+
+    DeviceType matchAdvertisement(const QBluetoothDeviceInfo &device) const
+    {
+        for (const QBluetoothUuid &uuid : device.serviceUuids()) {
+            auto it = m_services.constFind(uuid);
+            if (it != m_services.constEnd()) return it.value();
+        }
+        for (quint16 id : device.manufacturerIds()) {
+            auto it = m_manufacturers.constFind(id);
+            if (it != m_manufacturers.constEnd()) return it.value();
+        }
+        return DeviceType::Unknown;
+    }
+
+private:
+    Trie m_prefixes;
+    Trie m_fragments;
+    QHash<QBluetoothUuid, DeviceType> m_services;
+    QHash<quint16, DeviceType> m_manufacturers;
+};
+
+const Index &classifierIndex()
+{
+    static const Index s_index;
+    return s_index;
+}
+
+} // namespace
+
+DeviceType DeviceClassifier::classify(const QBluetoothDeviceInfo &device)
+{
+    DeviceType type = classifierIndex().matchName(device.name());
+    if (type != DeviceType::Unknown) {
+        return type;
+    }
+    return classifierIndex().matchAdvertisement(device);
+}
+
+DeviceType DeviceClassifier::classifyName(QStringView name)
+{
+    return classifierIndex().matchName(name);
+}
+
+DeviceCategory DeviceClassifier::category(DeviceType type)
+{
+    switch (type) {
+    case DeviceType::Unknown:
+        return DeviceCategory::Unknown;
+    case DeviceType::DE1:
+        return DeviceCategory::Machine;
+    case DeviceType::BookooMonitor:
+        return DeviceCategory::Sensor;
+    default:
+        return DeviceCategory::Scale;
+    }
+}
+
+QString DeviceClassifier::typeName(DeviceType type)
+{
+    switch (type) {
+    case DeviceType::DE1: return "DE1";
+    case DeviceType::DecentScale: return "Decent Scale";
+    case DeviceType::Acaia: return "Acaia";
+    case DeviceType::AcaiaPyxis: return "Acaia Pyxis";
+    case DeviceType::Felicita: return "Felicita";
+    case DeviceType::Skale: return "Skale";
+    case DeviceType::HiroiaJimmy: return "Hiroia Jimmy";
+    case DeviceType::Bookoo: return "Bookoo";
+    case DeviceType::SmartChef: return "SmartChef";
+    case DeviceType::Difluid: return "Difluid";
+    case DeviceType::EurekaPrecisa: return "Eureka Precisa";
+    case DeviceType::SoloBarista: return "Solo Barista";
+    case DeviceType::AtomheartEclair: return "Atomheart Eclair";
+    case DeviceType::VariaAku: return "Varia Aku";
+    case DeviceType::BookooMonitor: return "BookooMonitor";
+    case DeviceType::Unknown: break;
+    }
+    return "Unknown";
+}
+
+QString DeviceClassifier::apiName(DeviceType type)
+{
+    switch (type) {
+    case DeviceType::DecentScale: return "Decent";
+    case DeviceType::HiroiaJimmy: return "Hiroia";
+    case DeviceType::Difluid: return "DiFluid";
+    case DeviceType::EurekaPrecisa: return "Eureka";
+    case DeviceType::VariaAku: return "Varia";
+    default: return typeName(type);
+    }
+}
+
+DeviceType DeviceClassifier::typeFromName(QStringView name)
+{
+    static const QHash<QString, DeviceType> s_names = [] {
+        QHash<QString, DeviceType> names;
+        for (int i = int(DeviceType::DE1); i <= int(DeviceType::BookooMonitor); ++i) {
+            DeviceType type = DeviceType(i);
+            names.insert(typeName(type).toLower(), type);
+            names.insert(apiName(type).toLower(), type);
+        }
+        return names;
+    }();
+    return s_names.value(name.toString().toLower(), DeviceType::Unknown);
+}
@@ -0,0 +1,60 @@
+#ifndef DEVICECLASSIFIER_H
+#define DEVICECLASSIFIER_H
+
+#include <QBluetoothDeviceInfo>
+#include <QString>
+#include <QStringView>
+
+// Every device model the bridge can drive
+enum class DeviceType {
+    Unknown,
+    DE1,
+    // Scales
+    DecentScale,
+    Acaia,
+    AcaiaPyxis,
+    Felicita,
+    Skale,
+    HiroiaJimmy,
+    Bookoo,
+    SmartChef,
+    Difluid,
+    EurekaPrecisa,
+    SoloBarista,
+    AtomheartEclair,
+    VariaAku,
+    // Sensors
+    BookooMonitor
+};
+
+enum class DeviceCategory { Unknown, Machine, Scale, Sensor };
+
+/**
+ * @brief Identifies BLE advertisers from a single rule table
+ *
+ * Rules match a case-insensitive name prefix, an advertised service UUID or
+ * a manufacturer company ID. Name prefixes are compiled into a trie on first
+ * use, so a lookup is one pass over the name with no allocation; the longest
+ * matching prefix wins ("bookoo_em" over "bookoo"). A few name fragments
+ * that old releases matched anywhere in the name ("decent") are tried only
+ * when no prefix matches. Service and manufacturer rules are only consulted
+ * when the name does not match, as several scales share generic UART service
+ * UUIDs.
+ */
+class DeviceClassifier
+{
+public:
+    static DeviceType classify(const QBluetoothDeviceInfo &device);
+    static DeviceType classifyName(QStringView name);
+
+    static DeviceCategory category(DeviceType type);
+    // Human-readable model name, "Unknown" for DeviceType::Unknown
+    static QString typeName(DeviceType type);
+    // Name reported as scaleType/sensorType by the REST API; kept stable for
+    // clients, so it differs from typeName for some models ("Decent", "Hiroia")
+    static QString apiName(DeviceType type);
+    // Inverse of typeName and apiName (case-insensitive), Unknown if neither matches
+    static DeviceType typeFromName(QStringView name);
+};
+
+#endif // DEVICECLASSIFIER_H
@@ -0,0 +1,235 @@
+#include "mmrclient.h"
+#include "protocol/binarycodec.h"
+#include "protocol/de1characteristics.h"
+
+#include <QLoggingCategory>
+#include <algorithm>
+#include <utility>
+
+Q_LOGGING_CATEGORY(lcMmr, "bridge.de1.mmr")
+
+namespace {
+
+constexpr int PACKET_SIZE = 20;
+constexpr int HEADER_SIZE = 4;     // Length byte and 24-bit address
+constexpr int WORD_SIZE = 4;
+
+uint32_t readU32LE(const uint8_t *p)
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8)
+         | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+QByteArray u32LE(uint32_t value)
+{
+    QByteArray data(WORD_SIZE, Qt::Uninitialized);
+    for (int i = 0; i < WORD_SIZE; ++i) {
+        data[i] = static_cast<char>(value >> (8 * i));
+    }
+    return data;
+}
+
+QByteArray packet(uint8_t length, uint32_t address, const QByteArray &payload = QByteArray())
+{
+    QByteArray data(PACKET_SIZE, 0);
+    uint8_t *p = BinaryCodec::bytes(data);
+    p[0] = length;
+    BinaryCodec::writeU24BE(p + 1, address);
+    std::copy(payload.cbegin(), payload.cend(), data.begin() + HEADER_SIZE);
+    return data;
+}
+
+} // namespace
+
+MmrClient::MmrClient(Transport transport, QObject *parent)
+    : QObject(parent)
+    , m_transport(std::move(transport))
+{
+    m_timeout.setSingleShot(true);
+    m_timeout.setInterval(RESPONSE_TIMEOUT_MS);
+    connect(&m_timeout, &QTimer::timeout, this, &MmrClient::onTimeout);
+}
+
+void MmrClient::read(uint32_t address, ReadCallback callback)
+{
+    // Piggyback on a request already covering this register
+    for (auto it = m_readsInFlight.begin(); it != m_readsInFlight.end(); ++it) {
+        if (address >= it->start && address < it->start + uint32_t(it->words * WORD_SIZE)
+            && (address - it->start) % WORD_SIZE == 0) {
+            it->callbacks[address].append(std::move(callback));
+            return;
+        }
+    }
+
+    m_queuedReads[address].append(std::move(callback));
+    scheduleFlush();
+}
+
+void MmrClient::write(uint32_t address, uint32_t value, WriteCallback callback)
+{
+    // Continue the previous write if this register follows it directly
+    if (!m_queuedWrites.isEmpty()) {
+        WriteBatch &last = m_queuedWrites.last();
+        if (last.start + uint32_t(last.data.size()) == address
+            && last.data.size() + WORD_SIZE <= MAX_WORDS * WORD_SIZE) {
+            last.data.append(u32LE(value));
+            if (callback) last.callbacks.append(std::move(callback));
+            return;
+        }
+    }
+
+    WriteBatch batch;
+    batch.start = address;
+    batch.data = u32LE(value);
+    if (callback) batch.callbacks.append(std::move(callback));
+    m_queuedWrites.append(batch);
+    scheduleFlush();
+}
+
+void MmrClient::scheduleFlush()
+{
+    if (m_flushPending) return;
+    m_flushPending = true;
+    QTimer::singleShot(0, this, &MmrClient::flush);
+}
+
+void MmrClient::flush()
+{
+    m_flushPending = false;
+
+    // Writes first, so a read queued after a write sees the new value
+    for (const WriteBatch &batch : std::as_const(m_queuedWrites)) {
+        qCDebug(lcMmr) << "Write" << Qt::hex << batch.start << Qt::dec << batch.data.size() << "bytes";
+        m_transport(DE1::Characteristic::WRITE_TO_MMR,
+                    packet(static_cast<uint8_t>(batch.data.size()), batch.start, batch.data));
+        m_writesInFlight.append(batch.callbacks);
+    }
+    m_queuedWrites.clear();
+
+    // Cover the sorted registers with as few four-word windows as possible;
+    // reading a skipped register inside a window is cheaper than a round trip
+    auto it = m_queuedReads.begin();
+    while (it != m_queuedReads.end()) {
+        ReadBatch batch;
+        batch.start = it.key();
+        const uint32_t windowEnd = batch.start + MAX_WORDS * WORD_SIZE;
+        while (it != m_queuedReads.end() && it.key() < windowEnd
+               && (it.key() - batch.start) % WORD_SIZE == 0) {
+            batch.words = int(it.key() - batch.start) / WORD_SIZE + 1;
+            batch.callbacks.insert(it.key(), it.value());
+            it = m_queuedReads.erase(it);
+        }
+
+        // Two windows starting at one address could not be told apart; the
+        // later one waits for the earlier to finish
+        if (m_readsInFlight.contains(batch.start)) {
+            for (auto cb = batch.callbacks.cbegin(); cb != batch.callbacks.cend(); ++cb) {
+                m_queuedReads[cb.key()].append(cb.value());
+            }
+            break;
+        }
+
+        qCDebug(lcMmr) << "Read" << Qt::hex << batch.start << Qt::dec << batch.words << "words";
+        m_transport(DE1::Characteristic::READ_FROM_MMR,
+                    packet(static_cast<uint8_t>(batch.words - 1), batch.start));
+        m_readsInFlight.insert(batch.start, batch);
+    }
+
+    if ((!m_readsInFlight.isEmpty() || !m_writesInFlight.isEmpty()) && !m_timeout.isActive()) {
+        m_timeout.start();
+    }
+}
+
+void MmrClient::handleReadResponse(const QByteArray &data)
+{
+    if (data.size() < HEADER_SIZE) return;
+
+    const uint8_t *p = BinaryCodec::bytes(data);
+    const uint32_t address = BinaryCodec::readU24BE(p + 1);
+    auto it = m_readsInFlight.find(address);
+    if (it == m_readsInFlight.end()) {
+        qCDebug(lcMmr) << "Unsolicited response for" << Qt::hex << address;
+        return;
+    }
+    const ReadBatch batch = *it;
+    m_readsInFlight.erase(it);
+
+    const int available = (data.size() - HEADER_SIZE) / WORD_SIZE;
+    for (auto cb = batch.callbacks.cbegin(); cb != batch.callbacks.cend(); ++cb) {
+        const int word = int(cb.key() - batch.start) / WORD_SIZE;
+        const bool ok = word < available;
+        const uint32_t value = ok ? readU32LE(p + HEADER_SIZE + word * WORD_SIZE) : 0;
+        for (const ReadCallback &callback : cb.value()) {
+            callback(ok, value);
+        }
+    }
+
+    if (m_readsInFlight.isEmpty() && m_writesInFlight.isEmpty()) {
+        m_timeout.stop();
+    } else {
+        m_timeout.start();
+    }
+    // Reads held back behind a window with the same start can go now
+    if (!m_queuedReads.isEmpty()) {
+        scheduleFlush();
+    }
+}
+
+void MmrClient::handleWritten()
+{
+    if (m_writesInFlight.isEmpty()) return;
+
+    const QList<WriteCallback> callbacks = m_writesInFlight.takeFirst();
+    for (const WriteCallback &callback : callbacks) {
+        callback(true);
+    }
+
+    if (m_readsInFlight.isEmpty() && m_writesInFlight.isEmpty()) {
+        m_timeout.stop();
+    } else {
+        m_timeout.start();
+    }
+}
+
+void MmrClient::onTimeout()
+{
+    qCWarning(lcMmr) << "No response from machine:" << m_readsInFlight.size() << "reads and"
+                     << m_writesInFlight.size() << "writes failed";
+    failInFlight();
+
+    if (!m_queuedReads.isEmpty()) {
+        scheduleFlush();
+    }
+}
+
+void MmrClient::reset()
+{
+    // Take everything first: callbacks may queue new requests
+    const auto queuedReads = std::exchange(m_queuedReads, {});
+    const auto queuedWrites = std::exchange(m_queuedWrites, {});
+    failInFlight();
+
+    for (const QList<ReadCallback> &callbacks : queuedReads) {
+        for (const ReadCallback &callback : callbacks) callback(false, 0);
+    }
+    for (const WriteBatch &batch : queuedWrites) {
+        for (const WriteCallback &callback : batch.callbacks) callback(false);
+    }
+}
+
+void MmrClient::failInFlight()
+{
+    m_timeout.stop();
+
+    const auto reads = std::exchange(m_readsInFlight, {});
+    const auto writes = std::exchange(m_writesInFlight, {});
+
+    for (const ReadBatch &batch : reads) {
+        for (const QList<ReadCallback> &callbacks : batch.callbacks) {
+            for (const ReadCallback &callback : callbacks) callback(false, 0);
+        }
+    }
+    for (const QList<WriteCallback> &callbacks : writes) {
+        for (const WriteCallback &callback : callbacks) callback(false);
+    }
+}
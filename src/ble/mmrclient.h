@@ -0,0 +1,87 @@
+#ifndef MMRCLIENT_H
+#define MMRCLIENT_H
+
+#include <QObject>
+#include <QBluetoothUuid>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QTimer>
+#include <functional>
+
+/**
+ * @brief Queued access to the DE1's memory-mapped registers
+ *
+ * Registers are 32-bit little-endian words. A read is a 20-byte write to
+ * READ_FROM_MMR (word count - 1, 24-bit address, zero padding) answered by
+ * a READ_FROM_MMR notification echoing the length and address followed by
+ * up to four words. A write to WRITE_TO_MMR carries the byte count, the
+ * address and up to 16 bytes of data.
+ *
+ * Requests made in the same event loop pass are sent together on the next
+ * one. Reads whose registers fall within one four-word window are merged
+ * into a single request; all batches are sent back to back and responses
+ * are matched to them by address, so N windows cost N round trips in
+ * parallel rather than in sequence. Writes to adjacent registers are merged
+ * the same way and complete when the GATT write is acknowledged.
+ *
+ * Callbacks always run, with ok false when the machine does not answer
+ * within RESPONSE_TIMEOUT_MS, the response is too short, or the link is
+ * reset.
+ */
+class MmrClient : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Sends one packet to the given characteristic
+    using Transport = std::function<void(const QBluetoothUuid &characteristic, const QByteArray &packet)>;
+    using ReadCallback = std::function<void(bool ok, uint32_t value)>;
+    using WriteCallback = std::function<void(bool ok)>;
+
+    static constexpr int MAX_WORDS = 4;
+    static constexpr int RESPONSE_TIMEOUT_MS = 2000;
+
+    explicit MmrClient(Transport transport, QObject *parent = nullptr);
+
+    void read(uint32_t address, ReadCallback callback);
+    void write(uint32_t address, uint32_t value, WriteCallback callback = nullptr);
+
+    // READ_FROM_MMR notification
+    void handleReadResponse(const QByteArray &packet);
+    // WRITE_TO_MMR write acknowledged by the machine
+    void handleWritten();
+
+    // Fails everything queued or in flight, e.g. on disconnect
+    void reset();
+
+private:
+    struct ReadBatch {
+        uint32_t start = 0;
+        int words = 0;
+        QMap<uint32_t, QList<ReadCallback>> callbacks;   // By register address
+    };
+
+    struct WriteBatch {
+        uint32_t start = 0;
+        QByteArray data;
+        QList<WriteCallback> callbacks;
+    };
+
+    void scheduleFlush();
+    void flush();
+    void onTimeout();
+    void failInFlight();
+
+    Transport m_transport;
+    QTimer m_timeout;
+    bool m_flushPending = false;
+
+    QMap<uint32_t, QList<ReadCallback>> m_queuedReads;  // Sorted, so windows come out in order
+    QList<WriteBatch> m_queuedWrites;
+    QHash<uint32_t, ReadBatch> m_readsInFlight;         // By start address, as echoed back
+    QList<QList<WriteCallback>> m_writesInFlight;       // Acknowledged in order
+};
+
+#endif // MMRCLIENT_H
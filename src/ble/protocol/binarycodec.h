@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <QByteArray>
 
@@ -16,60 +19,233 @@
  *   U8P1  = 8-bit unsigned, 1 fractional bit,  range 0-127.5
  *   U16P8 = 16-bit unsigned, 8 fractional bits, range 0-255.996
  *   F8_1_7 = custom float format for durations
+ *
+ * Everything is constexpr and works on raw bytes: multi-byte values are
+ * read from and written to caller-provided buffers, so encoding a packet
+ * needs no allocation beyond the final QByteArray handed to Qt.
  */
 class BinaryCodec {
 public:
     // U8P4: 8-bit with 4 fractional bits (range 0-15.9375)
     // Used for: pressure (bar), flow (mL/s)
-    static uint8_t encodeU8P4(double value);
-    static double decodeU8P4(uint8_t value);
+    static constexpr uint8_t encodeU8P4(double value) {
+        return static_cast<uint8_t>(roundHalfAway(std::clamp(value, 0.0, 16.0) * 16.0));
+    }
+    static constexpr double decodeU8P4(uint8_t value) { return value / 16.0; }
 
     // U8P1: 8-bit with 1 fractional bit (range 0-127.5)
     // Used for: temperature (Celsius)
-    static uint8_t encodeU8P1(double value);
-    static double decodeU8P1(uint8_t value);
+    static constexpr uint8_t encodeU8P1(double value) {
+        return static_cast<uint8_t>(roundHalfAway(std::clamp(value, 0.0, 128.0) * 2.0));
+    }
+    static constexpr double decodeU8P1(uint8_t value) { return value / 2.0; }
 
     // U8P0: 8-bit integer (range 0-255)
     // Used for: volume, time, counts
-    static uint8_t encodeU8P0(double value);
-    static double decodeU8P0(uint8_t value);
+    static constexpr uint8_t encodeU8P0(double value) {
+        return static_cast<uint8_t>(roundHalfAway(std::clamp(value, 0.0, 256.0)));
+    }
+    static constexpr double decodeU8P0(uint8_t value) { return static_cast<double>(value); }
 
     // U16P8: 16-bit with 8 fractional bits (range 0-255.996)
     // Used for: precise temperature
-    static uint16_t encodeU16P8(double value);
-    static double decodeU16P8(uint16_t value);
+    static constexpr uint16_t encodeU16P8(double value) {
+        return static_cast<uint16_t>(roundHalfAway(std::clamp(value, 0.0, 256.0) * 256.0));
+    }
+    static constexpr double decodeU16P8(uint16_t value) { return value / 256.0; }
 
     // S32P16: Signed 32-bit with 16 fractional bits
     // Used for: calibration values
-    static int32_t encodeS32P16(double value);
-    static double decodeS32P16(int32_t value);
+    static constexpr int32_t encodeS32P16(double value) {
+        return static_cast<int32_t>(roundHalfAway(std::clamp(value, -65536.0, 65536.0) * 65536.0));
+    }
+    static constexpr double decodeS32P16(int32_t value) { return value / 65536.0; }
 
     // F8_1_7: Custom float format for frame duration
-    // If value < 12.75: uses 0.1s precision
-    // If value >= 12.75: uses 1s precision with high bit set
-    static uint8_t encodeF8_1_7(double value);
-    static double decodeF8_1_7(uint8_t value);
+    // If value < 12.75: round(value * 10), 0.1s precision
+    // If value >= 12.75: round(value) | 0x80, 1s precision
+    static constexpr uint8_t encodeF8_1_7(double value) {
+        if (value < 12.75) {
+            return static_cast<uint8_t>(roundHalfAway(value * 10.0));
+        }
+        return static_cast<uint8_t>(roundHalfAway(std::clamp(value, 0.0, 127.0))) | 0x80;
+    }
+    static constexpr double decodeF8_1_7(uint8_t value) {
+        return (value & 0x80) == 0 ? value / 10.0 : static_cast<double>(value & 0x7F);
+    }
 
-    // U10P0: 10-bit integer with flag bit (bit 10 set)
+    // U10P0: 10-bit integer with flag bit (bit 10 always set)
     // Used for: volume limits in shot frames
-    static uint16_t encodeU10P0(double value);
-    static double decodeU10P0(uint16_t value);
+    static constexpr uint16_t encodeU10P0(double value) {
+        return static_cast<uint16_t>(roundHalfAway(std::clamp(value, 0.0, 1023.0))) | 0x0400;
+    }
+    static constexpr double decodeU10P0(uint16_t value) { return static_cast<double>(value & 0x03FF); }
 
-    // U24P0: 24-bit big-endian integer
+    // U24P0: 24-bit big-endian integer from its bytes
     // Used for: MMR addresses
-    static QByteArray encodeU24P0(uint32_t value);
-    static uint32_t decodeU24P0(const QByteArray& data);
-    static uint32_t decodeU24P0(uint8_t high, uint8_t mid, uint8_t low);
-
-    // U32P0: 32-bit big-endian integer
-    static QByteArray encodeU32P0(uint32_t value);
-    static uint32_t decodeU32P0(const QByteArray& data);
+    static constexpr uint32_t decodeU24P0(uint8_t high, uint8_t mid, uint8_t low) {
+        return (static_cast<uint32_t>(high) << 16) | (static_cast<uint32_t>(mid) << 8) | low;
+    }
 
     // Utility: Convert 3 chars to U24P16 fixed point
-    static double decode3CharToU24P16(uint8_t char1, uint8_t char2, uint8_t char3);
+    static constexpr double decode3CharToU24P16(uint8_t char1, uint8_t char2, uint8_t char3) {
+        return static_cast<double>(char1) + (char2 / 256.0) + (char3 / 65536.0);
+    }
+
+    // Big-endian integers at a position in a byte buffer; the caller checks the length
+    static constexpr uint16_t readU16BE(const uint8_t* p) {
+        return static_cast<uint16_t>((p[0] << 8) | p[1]);
+    }
+    static constexpr int16_t readS16BE(const uint8_t* p) {
+        return static_cast<int16_t>(readU16BE(p));
+    }
+    static constexpr uint32_t readU24BE(const uint8_t* p) {
+        return decodeU24P0(p[0], p[1], p[2]);
+    }
+    static constexpr uint32_t readU32BE(const uint8_t* p) {
+        return (static_cast<uint32_t>(p[0]) << 24) | readU24BE(p + 1);
+    }
+
+    static constexpr void writeU16BE(uint8_t* p, uint16_t value) {
+        p[0] = static_cast<uint8_t>(value >> 8);
+        p[1] = static_cast<uint8_t>(value);
+    }
+    static constexpr void writeU24BE(uint8_t* p, uint32_t value) {
+        p[0] = static_cast<uint8_t>(value >> 16);
+        p[1] = static_cast<uint8_t>(value >> 8);
+        p[2] = static_cast<uint8_t>(value);
+    }
+    static constexpr void writeU32BE(uint8_t* p, uint32_t value) {
+        p[0] = static_cast<uint8_t>(value >> 24);
+        writeU24BE(p + 1, value);
+    }
+
+    // Byte view of a characteristic value
+    static const uint8_t* bytes(const QByteArray& data) {
+        return reinterpret_cast<const uint8_t*>(data.constData());
+    }
+    static uint8_t* bytes(QByteArray& data) {
+        return reinterpret_cast<uint8_t*>(data.data());
+    }
+
+private:
+    // std::round is not constexpr before C++23. Same result: half away from
+    // zero, computed exactly for the magnitudes used here.
+    static constexpr int64_t roundHalfAway(double value) {
+        int64_t truncated = static_cast<int64_t>(value);
+        double fraction = value - static_cast<double>(truncated);
+        if (fraction >= 0.5) return truncated + 1;
+        if (fraction <= -0.5) return truncated - 1;
+        return truncated;
+    }
+};
+
+/**
+ * Wire formats for StructLayout fields. Each maps Size bytes to a value.
+ */
+namespace BinaryFormat {
+
+struct U8 {
+    static constexpr std::size_t Size = 1;
+    static constexpr uint8_t decode(const uint8_t* p) { return p[0]; }
+    static constexpr void encode(uint8_t* p, uint8_t value) { p[0] = value; }
+};
+
+struct U8P0 {
+    static constexpr std::size_t Size = 1;
+    static constexpr double decode(const uint8_t* p) { return BinaryCodec::decodeU8P0(p[0]); }
+    static constexpr void encode(uint8_t* p, double value) { p[0] = BinaryCodec::encodeU8P0(value); }
+};
+
+struct U8P1 {
+    static constexpr std::size_t Size = 1;
+    static constexpr double decode(const uint8_t* p) { return BinaryCodec::decodeU8P1(p[0]); }
+    static constexpr void encode(uint8_t* p, double value) { p[0] = BinaryCodec::encodeU8P1(value); }
+};
+
+struct U8P4 {
+    static constexpr std::size_t Size = 1;
+    static constexpr double decode(const uint8_t* p) { return BinaryCodec::decodeU8P4(p[0]); }
+    static constexpr void encode(uint8_t* p, double value) { p[0] = BinaryCodec::encodeU8P4(value); }
+};
+
+struct U16BE {
+    static constexpr std::size_t Size = 2;
+    static constexpr uint16_t decode(const uint8_t* p) { return BinaryCodec::readU16BE(p); }
+    static constexpr void encode(uint8_t* p, uint16_t value) { BinaryCodec::writeU16BE(p, value); }
+};
+
+struct U16P8BE {
+    static constexpr std::size_t Size = 2;
+    static constexpr double decode(const uint8_t* p) {
+        return BinaryCodec::decodeU16P8(BinaryCodec::readU16BE(p));
+    }
+    static constexpr void encode(uint8_t* p, double value) {
+        BinaryCodec::writeU16BE(p, BinaryCodec::encodeU16P8(value));
+    }
+};
+
+struct U24BE {
+    static constexpr std::size_t Size = 3;
+    static constexpr uint32_t decode(const uint8_t* p) { return BinaryCodec::readU24BE(p); }
+    static constexpr void encode(uint8_t* p, uint32_t value) { BinaryCodec::writeU24BE(p, value); }
+};
+
+struct U32BE {
+    static constexpr std::size_t Size = 4;
+    static constexpr uint32_t decode(const uint8_t* p) { return BinaryCodec::readU32BE(p); }
+    static constexpr void encode(uint8_t* p, uint32_t value) { BinaryCodec::writeU32BE(p, value); }
+};
+
+} // namespace BinaryFormat
+
+// One struct member stored at a fixed byte offset in a given wire format
+template <auto Member, std::size_t Offset, typename Format>
+struct Field {
+    static constexpr std::size_t End = Offset + Format::Size;
+
+    template <typename T>
+    static constexpr void decode(const uint8_t* data, T& out) {
+        out.*Member = Format::decode(data + Offset);
+    }
+    template <typename T>
+    static constexpr void encode(const T& in, uint8_t* data) {
+        Format::encode(data + Offset, in.*Member);
+    }
+};
+
+/**
+ * Declarative packet layout: unpacks or packs every field of T in one call.
+ *
+ *   using Layout = StructLayout<Settings,
+ *       Field<&Settings::mode, 0, BinaryFormat::U8>,
+ *       Field<&Settings::temp, 1, BinaryFormat::U16P8BE>>;
+ *
+ * Bytes not covered by a field encode as zero.
+ */
+template <typename T, typename... Fields>
+struct StructLayout {
+    static_assert(sizeof...(Fields) > 0, "Layout needs at least one field");
+
+    static constexpr std::size_t Size = std::max({Fields::End...});
+
+    // False (and out untouched) if the data is shorter than the layout
+    static constexpr bool decode(const uint8_t* data, std::size_t size, T& out) {
+        if (size < Size) return false;
+        (Fields::decode(data, out), ...);
+        return true;
+    }
+    static bool decode(const QByteArray& data, T& out) {
+        return decode(BinaryCodec::bytes(data), static_cast<std::size_t>(data.size()), out);
+    }
 
-    // Short (16-bit) big-endian encoding/decoding
-    static QByteArray encodeShortBE(uint16_t value);
-    static uint16_t decodeShortBE(const QByteArray& data, int offset = 0);
-    static int16_t decodeSignedShortBE(const QByteArray& data, int offset = 0);
+    static constexpr std::array<uint8_t, Size> encode(const T& in) {
+        std::array<uint8_t, Size> out{};
+        (Fields::encode(in, out.data()), ...);
+        return out;
+    }
+    static QByteArray toByteArray(const T& in) {
+        const std::array<uint8_t, Size> packed = encode(in);
+        return QByteArray(reinterpret_cast<const char*>(packed.data()), static_cast<int>(Size));
+    }
 };
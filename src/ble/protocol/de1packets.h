@@ -0,0 +1,100 @@
+#pragma once
+
+#include "binarycodec.h"
+
+namespace DE1 {
+
+// ShotSample characteristic (A00D), ~5 Hz while the machine is active
+struct ShotSample {
+    uint16_t timer = 0;             // sample time, 0.01 s units
+    double groupPressure = 0;       // bar
+    double groupFlow = 0;           // mL/s
+    double mixTemp = 0;             // C
+    double headTemp = 0;            // C
+    double setMixTemp = 0;          // C
+    double setHeadTemp = 0;         // C
+    double setGroupPressure = 0;    // bar
+    double setGroupFlow = 0;        // mL/s
+    uint8_t frameNumber = 0;
+    double steamTemp = 0;           // C
+};
+
+using ShotSampleLayout = StructLayout<ShotSample,
+    Field<&ShotSample::timer,            0,  BinaryFormat::U16BE>,
+    Field<&ShotSample::groupPressure,    2,  BinaryFormat::U8P4>,
+    Field<&ShotSample::groupFlow,        3,  BinaryFormat::U8P4>,
+    Field<&ShotSample::mixTemp,          4,  BinaryFormat::U16P8BE>,
+    Field<&ShotSample::headTemp,         6,  BinaryFormat::U16P8BE>,
+    Field<&ShotSample::setMixTemp,       8,  BinaryFormat::U16P8BE>,
+    Field<&ShotSample::setHeadTemp,      10, BinaryFormat::U16P8BE>,
+    Field<&ShotSample::setGroupPressure, 12, BinaryFormat::U8P4>,
+    Field<&ShotSample::setGroupFlow,     13, BinaryFormat::U8P4>,
+    Field<&ShotSample::frameNumber,      14, BinaryFormat::U8>,
+    Field<&ShotSample::steamTemp,        15, BinaryFormat::U8P0>>;
+
+static_assert(ShotSampleLayout::Size == 16, "ShotSample is 16 bytes");
+
+// ShotSettings characteristic (A00B): steam, hot water and group targets
+struct ShotSettings {
+    uint8_t steamSetting = 0;           // 0-3
+    uint8_t targetSteamTemp = 0;        // C
+    uint8_t targetSteamDuration = 0;    // s
+    uint8_t targetHotWaterTemp = 0;     // C
+    uint8_t targetHotWaterVolume = 0;   // mL
+    uint8_t targetHotWaterDuration = 0; // s
+    uint8_t targetShotVolume = 0;       // mL
+    double groupTemp = 0;               // C
+};
+
+using ShotSettingsLayout = StructLayout<ShotSettings,
+    Field<&ShotSettings::steamSetting,           0, BinaryFormat::U8>,
+    Field<&ShotSettings::targetSteamTemp,        1, BinaryFormat::U8>,
+    Field<&ShotSettings::targetSteamDuration,    2, BinaryFormat::U8>,
+    Field<&ShotSettings::targetHotWaterTemp,     3, BinaryFormat::U8>,
+    Field<&ShotSettings::targetHotWaterVolume,   4, BinaryFormat::U8>,
+    Field<&ShotSettings::targetHotWaterDuration, 5, BinaryFormat::U8>,
+    Field<&ShotSettings::targetShotVolume,       6, BinaryFormat::U8>,
+    Field<&ShotSettings::groupTemp,              7, BinaryFormat::U16P8BE>>;
+
+static_assert(ShotSettingsLayout::Size == 9, "ShotSettings is 9 bytes");
+
+// WaterLevels characteristic (A011)
+struct WaterLevels {
+    uint16_t currentLevel = 0;  // mm
+    uint16_t startLevel = 0;    // mm
+};
+
+using WaterLevelsLayout = StructLayout<WaterLevels,
+    Field<&WaterLevels::currentLevel, 0, BinaryFormat::U16BE>,
+    Field<&WaterLevels::startLevel,   2, BinaryFormat::U16BE>>;
+
+// Temperatures characteristic (A00A): heater readings and their targets, all U16P8
+struct Temperatures {
+    double waterHeater = 0;
+    double steamHeater = 0;
+    double groupHead = 0;
+    double coldWater = 0;
+    double targetWaterHeater = 0;
+    double targetSteamHeater = 0;
+    double targetGroupHead = 0;
+    double targetColdWater = 0;
+};
+
+using TemperaturesLayout = StructLayout<Temperatures,
+    Field<&Temperatures::waterHeater,       0,  BinaryFormat::U16P8BE>,
+    Field<&Temperatures::steamHeater,       2,  BinaryFormat::U16P8BE>,
+    Field<&Temperatures::groupHead,         4,  BinaryFormat::U16P8BE>,
+    Field<&Temperatures::coldWater,         6,  BinaryFormat::U16P8BE>,
+    Field<&Temperatures::targetWaterHeater, 8,  BinaryFormat::U16P8BE>,
+    Field<&Temperatures::targetSteamHeater, 10, BinaryFormat::U16P8BE>,
+    Field<&Temperatures::targetGroupHead,   12, BinaryFormat::U16P8BE>,
+    Field<&Temperatures::targetColdWater,   14, BinaryFormat::U16P8BE>>;
+
+static_assert(TemperaturesLayout::Size == 16, "Temperatures is 16 bytes");
+
+// The codec is constexpr, so the fixed-point path is checked at compile time
+static_assert(ShotSettingsLayout::encode(ShotSettings{1, 160, 120, 85, 200, 60, 36, 93.5})[7] == 0x5D
+              && ShotSettingsLayout::encode(ShotSettings{1, 160, 120, 85, 200, 60, 36, 93.5})[8] == 0x80,
+              "93.5 C encodes as U16P8 0x5D80");
+
+} // namespace DE1
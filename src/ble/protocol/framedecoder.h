@@ -0,0 +1,141 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <QByteArray>
+
+/**
+ * Streaming splitter for packetized scale protocols.
+ *
+ * BLE notifications do not line up with protocol frames: one notification
+ * may carry several frames, or a frame may be split across notifications.
+ * FrameDecoder keeps unconsumed bytes in a fixed-size ring buffer and hands
+ * every complete frame to a callback in one pass, without allocating.
+ *
+ * The wire format is described by a policy type:
+ *
+ *   struct ExampleFraming {
+ *       // Sync bytes every frame starts with (may be empty)
+ *       static constexpr std::array<uint8_t, 2> Header = {0xEF, 0xDD};
+ *       // Bytes needed before frameLength() can be called
+ *       static constexpr int PrefixLength = 4;
+ *       static constexpr int MaxFrameLength = 64;
+ *       // Total frame length from its first PrefixLength bytes, or -1 if implausible
+ *       static int frameLength(const uint8_t* prefix);
+ *       // Always true for protocols whose checksum is not verified
+ *       static bool checksumValid(const uint8_t* frame, int length);
+ *   };
+ *
+ * Garbage before a header, implausible lengths and, where the policy checks
+ * one, bad checksums are skipped one byte at a time until the stream
+ * resynchronizes.
+ */
+template <typename Policy, int Capacity = 512>
+class FrameDecoder {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(Policy::MaxFrameLength <= Capacity, "Capacity must hold a full frame");
+    static_assert(Policy::PrefixLength >= int(Policy::Header.size()), "Prefix must cover the header");
+
+public:
+    // Appends data and calls onFrame(const uint8_t* frame, int length) for each
+    // complete frame. The frame pointer is only valid during the call.
+    // Returns the number of frames decoded.
+    template <typename Handler>
+    int feed(const QByteArray& data, Handler&& onFrame) {
+        append(reinterpret_cast<const uint8_t*>(data.constData()), int(data.size()));
+
+        int frames = 0;
+        while (m_size >= Policy::PrefixLength) {
+            if (!headerAtFront()) {
+                skip();
+                continue;
+            }
+
+            uint8_t prefix[Policy::PrefixLength];
+            copyOut(prefix, Policy::PrefixLength);
+            int length = Policy::frameLength(prefix);
+            if (length < Policy::PrefixLength || length > Policy::MaxFrameLength) {
+                skip();
+                continue;
+            }
+            if (m_size < length) break;
+
+            const uint8_t* frame = contiguous(length);
+            if (!Policy::checksumValid(frame, length)) {
+                skip();
+                continue;
+            }
+
+            onFrame(frame, length);
+            discard(length);
+            frames++;
+        }
+        return frames;
+    }
+
+    void reset() { m_head = 0; m_size = 0; }
+    int buffered() const { return m_size; }
+    // Bytes thrown away while resynchronizing or on overflow (diagnostics)
+    int droppedBytes() const { return m_dropped; }
+
+private:
+    static constexpr int Mask = Capacity - 1;
+
+    uint8_t at(int i) const { return m_ring[(m_head + i) & Mask]; }
+
+    bool headerAtFront() const {
+        for (int i = 0; i < int(Policy::Header.size()); i++) {
+            if (at(i) != Policy::Header[i]) return false;
+        }
+        return true;
+    }
+
+    void append(const uint8_t* data, int size) {
+        // Keep the newest bytes if a notification would overflow the ring
+        if (size > Capacity) {
+            m_dropped += size - Capacity;
+            data += size - Capacity;
+            size = Capacity;
+        }
+        if (m_size + size > Capacity) {
+            m_dropped += m_size + size - Capacity;
+            discard(m_size + size - Capacity);
+        }
+
+        int tail = (m_head + m_size) & Mask;
+        int first = qMin(size, Capacity - tail);
+        std::memcpy(m_ring.data() + tail, data, size_t(first));
+        std::memcpy(m_ring.data(), data + first, size_t(size - first));
+        m_size += size;
+    }
+
+    void copyOut(uint8_t* out, int length) const {
+        int first = qMin(length, Capacity - m_head);
+        std::memcpy(out, m_ring.data() + m_head, size_t(first));
+        std::memcpy(out + first, m_ring.data(), size_t(length - first));
+    }
+
+    // Frame bytes in one piece: in place unless the frame wraps the ring
+    const uint8_t* contiguous(int length) {
+        if (m_head + length <= Capacity) return m_ring.data() + m_head;
+        copyOut(m_scratch.data(), length);
+        return m_scratch.data();
+    }
+
+    void skip() {
+        discard(1);
+        m_dropped++;
+    }
+
+    void discard(int count) {
+        m_head = (m_head + count) & Mask;
+        m_size -= count;
+    }
+
+    std::array<uint8_t, Capacity> m_ring{};
+    std::array<uint8_t, Policy::MaxFrameLength> m_scratch{};
+    int m_head = 0;
+    int m_size = 0;
+    int m_dropped = 0;
+};
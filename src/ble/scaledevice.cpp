@@ -1,4 +1,5 @@
 #include "scaledevice.h"
+#include "transport/scalebletransport.h"
 #include <QDateTime>
 
 ScaleDevice::ScaleDevice(QObject* parent)
@@ -38,6 +39,17 @@ void ScaleDevice::setSimulationMode(bool enabled) {
     emit connectedChanged();
 }
 
+void ScaleDevice::setNotificationsPaused(bool paused) {
+    if (!supportsNotificationPause()) {
+        return;
+    }
+    // Drivers take ownership of their transport
+    auto* transport = findChild<ScaleBleTransport*>(QString(), Qt::FindDirectChildrenOnly);
+    if (transport) {
+        transport->setNotificationsPaused(paused);
+    }
+}
+
 void ScaleDevice::disconnectFromScale() {
     if (m_service) {
         // Disconnect signals first to prevent callbacks during deletion
@@ -67,6 +79,7 @@ void ScaleDevice::disconnectFromScale() {
 void ScaleDevice::setConnected(bool connected) {
     if (m_connected != connected) {
         m_connected = connected;
+        m_generation.bump();
         emit connectedChanged();
     }
 }
@@ -75,6 +88,7 @@ void ScaleDevice::setWeight(double weight) {
     if (m_weight != weight) {
         calculateFlowRate(weight);
         m_weight = weight;
+        m_generation.bump();
         emit weightChanged(weight);
     }
 }
@@ -82,6 +96,7 @@ void ScaleDevice::setWeight(double weight) {
 void ScaleDevice::setFlowRate(double rate) {
     if (m_flowRate != rate) {
         m_flowRate = rate;
+        m_generation.bump();
         emit flowRateChanged(rate);
     }
 }
@@ -89,6 +104,7 @@ void ScaleDevice::setFlowRate(double rate) {
 void ScaleDevice::setBatteryLevel(int level) {
     if (m_batteryLevel != level) {
         m_batteryLevel = level;
+        m_generation.bump();
         emit batteryLevelChanged(level);
     }
 }
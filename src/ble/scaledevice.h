@@ -6,6 +6,8 @@
 #include <QLowEnergyService>
 #include <QList>
 
+#include "datageneration.h"
+
 class ScaleDevice : public QObject {
     Q_OBJECT
 
@@ -26,12 +28,19 @@ public:
     double weight() const { return m_weight; }
     double flowRate() const { return m_flowRate; }
     int batteryLevel() const { return m_batteryLevel; }
+    // Change stamp for connection state, weight, flow and battery (see DataGeneration)
+    quint64 generation() const { return m_generation.value(); }
     virtual QString name() const = 0;
     virtual QString type() const = 0;
 
     bool simulationMode() const { return m_simulationMode; }
     void setSimulationMode(bool enabled);
 
+    // Stop weight notifications while nobody consumes them; the link stays up.
+    // Drivers whose session depends on a steady stream opt out.
+    virtual bool supportsNotificationPause() const { return true; }
+    void setNotificationsPaused(bool paused);
+
 public slots:
     virtual void tare() = 0;
     virtual void startTimer() {}
@@ -73,6 +82,7 @@ private:
     double m_weight = 0.0;
     double m_flowRate = 0.0;
     int m_batteryLevel = 100;
+    DataGeneration m_generation;
 
     // Flow rate calculation
     double m_prevWeight = 0.0;
@@ -79,7 +79,7 @@ void AcaiaScale::connectToDevice(const QBluetoothDeviceInfo& device) {
     m_weightReceived = false;
     m_isConnecting = true;
     m_identRetryCount = 0;
-    m_buffer.clear();
+    m_decoder.reset();
 
     m_name = device.name();
     m_transport->connectToDevice(device);
@@ -302,64 +302,32 @@ void AcaiaScale::sendCommand(const QByteArray& command) {
 }
 
 void AcaiaScale::parseResponse(const QByteArray& data) {
-    // Append to buffer
-    m_buffer.append(data);
-
-    // Need at least 6 bytes for a valid message
-    if (m_buffer.size() < 6) return;
-
-    const uint8_t* buf = reinterpret_cast<const uint8_t*>(m_buffer.constData());
-
-    // Find message start (0xEF 0xDD)
-    int msgStart = -1;
-    for (int i = 0; i < m_buffer.size() - 1; i++) {
-        if (buf[i] == 0xEF && buf[i + 1] == 0xDD) {
-            msgStart = i;
-            break;
-        }
-    }
-
-    if (msgStart < 0) {
-        m_buffer.clear();
-        return;
-    }
-
-    // Skip bytes before message start
-    if (msgStart > 0) {
-        m_buffer = m_buffer.mid(msgStart);
-        buf = reinterpret_cast<const uint8_t*>(m_buffer.constData());
-    }
-
-    // Check if we have enough data for metadata
-    if (m_buffer.size() < ACAIA_METADATA_LEN + 1) return;
+    // A notification may hold several messages, or part of one
+    m_decoder.feed(data, [this](const uint8_t* frame, int length) {
+        handleFrame(frame, length);
+    });
+}
 
-    uint8_t msgType = buf[2];
-    uint8_t length = buf[3];
-    uint8_t eventType = buf[4];
+void AcaiaScale::handleFrame(const uint8_t* frame, int length) {
+    uint8_t msgType = frame[2];
+    uint8_t eventType = frame[4];
 
     // Mark that we're receiving notifications (not just info messages)
     if (msgType != 7) {
         m_receivingNotifications = true;
     }
 
-    // Check if we have the complete message
-    int msgEnd = ACAIA_METADATA_LEN + length;
-    if (m_buffer.size() < msgEnd) return;
-
     // Only process weight messages (msgType 0x0C, eventType 5 or 11)
     if (msgType == 0x0C && (eventType == 5 || eventType == 11)) {
         int payloadOffset = (eventType == 5) ? ACAIA_METADATA_LEN : ACAIA_METADATA_LEN + 3;
-        decodeWeight(m_buffer, payloadOffset);
+        decodeWeight(frame, length, payloadOffset);
     }
-
-    // Clear buffer after processing
-    m_buffer.clear();
 }
 
-void AcaiaScale::decodeWeight(const QByteArray& data, int payloadOffset) {
-    if (data.size() < payloadOffset + 6) return;
+void AcaiaScale::decodeWeight(const uint8_t* frame, int length, int payloadOffset) {
+    if (length < payloadOffset + 6) return;
 
-    const uint8_t* payload = reinterpret_cast<const uint8_t*>(data.constData()) + payloadOffset;
+    const uint8_t* payload = frame + payloadOffset;
 
     // Weight is 3 bytes, little-endian
     int32_t value = ((payload[2] & 0xFF) << 16) |
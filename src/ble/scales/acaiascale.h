@@ -2,6 +2,7 @@
 
 #include "../scaledevice.h"
 #include "../transport/scalebletransport.h"
+#include "../protocol/framedecoder.h"
 #include <QTimer>
 #include <QByteArray>
 
@@ -15,6 +16,8 @@ public:
     void connectToDevice(const QBluetoothDeviceInfo& device) override;
     QString name() const override { return m_name; }
     QString type() const override { return m_isPyxis ? "acaiapyxis" : "acaia"; }
+    // The heartbeat and weight stream keep the session alive
+    bool supportsNotificationPause() const override { return false; }
 
 public slots:
     void tare() override;
@@ -37,8 +40,19 @@ private slots:
     void onInitTimer();  // Handles ident/config retry sequence
 
 private:
+    // EF DD | msgType | length | event | ... ; total length is 5 + length
+    struct Framing {
+        static constexpr std::array<uint8_t, 2> Header = {0xEF, 0xDD};
+        static constexpr int PrefixLength = 4;
+        static constexpr int MaxFrameLength = 5 + 255;
+        static int frameLength(const uint8_t* prefix) { return 5 + prefix[3]; }
+        // The two trailing checksum bytes are not verified, as before
+        static bool checksumValid(const uint8_t*, int) { return true; }
+    };
+
     void parseResponse(const QByteArray& data);
-    void decodeWeight(const QByteArray& payload, int payloadOffset);
+    void handleFrame(const uint8_t* frame, int length);
+    void decodeWeight(const uint8_t* frame, int length, int payloadOffset);
     QByteArray encodePacket(uint8_t msgType, const QByteArray& payload);
     void sendCommand(const QByteArray& command);
     void sendTareCommand();  // Internal: sends a single tare command
@@ -61,7 +75,7 @@ private:
     int m_identRetryCount = 0;
 
     // Message parsing state
-    QByteArray m_buffer;
+    FrameDecoder<Framing> m_decoder;
 
     // Constants
     static constexpr int ACAIA_METADATA_LEN = 5;
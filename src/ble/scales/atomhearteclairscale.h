@@ -1,40 +1,35 @@
 #pragma once
 
-#include "../scaledevice.h"
-#include "../transport/scalebletransport.h"
-
-class AtomheartEclairScale : public ScaleDevice {
-    Q_OBJECT
-
-public:
-    explicit AtomheartEclairScale(ScaleBleTransport* transport, QObject* parent = nullptr);
-    ~AtomheartEclairScale() override;
-
-    void connectToDevice(const QBluetoothDeviceInfo& device) override;
-    QString name() const override { return m_name; }
-    QString type() const override { return "atomheart_eclair"; }
-
-public slots:
-    void tare() override;
-    void startTimer() override;
-    void stopTimer() override;
-    void resetTimer() override;
-
-private slots:
-    void onTransportConnected();
-    void onTransportDisconnected();
-    void onTransportError(const QString& message);
-    void onServiceDiscovered(const QBluetoothUuid& uuid);
-    void onServicesDiscoveryFinished();
-    void onCharacteristicsDiscoveryFinished(const QBluetoothUuid& serviceUuid);
-    void onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value);
-
-private:
-    void sendCommand(const QByteArray& cmd);
-    bool validateXor(const QByteArray& data);
-
-    ScaleBleTransport* m_transport = nullptr;
-    QString m_name = "Atomheart Eclair";
-    bool m_serviceFound = false;
-    bool m_characteristicsReady = false;
+#include "protocolscale.h"
+#include "../protocol/de1characteristics.h"
+
+// Atomheart Eclair: 'W' (0x57) header, 4-byte signed weight in milligrams
+// (little-endian), 4-byte timer, XOR of the bytes after the header
+struct AtomheartEclairProtocol {
+    static constexpr const char* Type = "atomheart_eclair";
+    static constexpr const char* DisplayName = "Atomheart Eclair";
+    static constexpr const char* LogTag = "AtomheartEclairScale";
+    static const QBluetoothUuid& service() { return Scale::AtomheartEclair::SERVICE; }
+    static const QBluetoothUuid& status() { return Scale::AtomheartEclair::STATUS; }
+    static const QBluetoothUuid& command() { return Scale::AtomheartEclair::CMD; }
+    static constexpr auto WriteType = ScaleBleTransport::WriteType::WithResponse;
+
+    static constexpr std::array<uint8_t, 1> Header = {0x57};
+    static constexpr int MinFrameLength = 9;
+    static constexpr auto Checksum = ScaleProtocol::Checksum::XorAfterHeader;
+    static constexpr ScaleProtocol::WeightField Weight = {1, 4, ScaleProtocol::Endian::Little, true, 1000.0};
+    static constexpr ScaleProtocol::SignRule Sign = {};
+
+    // de1app uses 200ms delay for Atomheart Eclair
+    static constexpr ScaleProtocol::InitStep Init[] = {
+        {200, ScaleProtocol::InitAction::EnableNotifications},
+    };
+    static constexpr ScaleProtocol::Bytes Tare = ScaleProtocol::bytes("\x54\x01\x01");
+    static constexpr ScaleProtocol::Bytes StartTimer = ScaleProtocol::bytes("\x43\x01\x01");
+    static constexpr ScaleProtocol::Bytes StopTimer = ScaleProtocol::bytes("\x43\x00\x00");
+    // Eclair resets timer on tare
+    static constexpr ScaleProtocol::Bytes ResetTimer = Tare;
+    static constexpr ScaleProtocol::Bytes Sleep = {};
 };
+
+using AtomheartEclairScale = ProtocolScale<AtomheartEclairProtocol>;
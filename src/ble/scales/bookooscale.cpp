@@ -52,6 +52,7 @@ void BookooScale::connectToDevice(const QBluetoothDeviceInfo& device) {
     }
 
     m_name = device.name();
+    m_decoder.reset();
     m_serviceFound = false;
     m_characteristicsReady = false;
 
@@ -143,23 +144,23 @@ void BookooScale::onNotificationsEnabled(const QBluetoothUuid& characteristicUui
 }
 
 void BookooScale::parseWeightData(const QByteArray& data) {
-    // Bookoo format: h1 h2 h3 h4 h5 h6 sign w1 w2 w3 (10 bytes)
-    // de1app checks >= 9 bytes, we check >= 10 to be safe
-    if (data.size() >= 10) {
-        const uint8_t* d = reinterpret_cast<const uint8_t*>(data.constData());
-
-        char sign = static_cast<char>(d[6]);
+    m_decoder.feed(data, [this](const uint8_t* frame, int) {
+        handleFrame(frame);
+    });
+}
 
-        // Weight is 3 bytes big-endian in hundredths of gram
-        uint32_t weightRaw = (d[7] << 16) | (d[8] << 8) | d[9];
-        double weight = weightRaw / 100.0;
+void BookooScale::handleFrame(const uint8_t* d) {
+    char sign = static_cast<char>(d[6]);
 
-        if (sign == '-') {
-            weight = -weight;
-        }
+    // Weight is 3 bytes big-endian in hundredths of gram
+    uint32_t weightRaw = (d[7] << 16) | (d[8] << 8) | d[9];
+    double weight = weightRaw / 100.0;
 
-        setWeight(weight);
+    if (sign == '-') {
+        weight = -weight;
     }
+
+    setWeight(weight);
 }
 
 void BookooScale::sendCommand(const QByteArray& cmd) {
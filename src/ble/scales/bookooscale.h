@@ -2,6 +2,7 @@
 
 #include "../scaledevice.h"
 #include "../transport/scalebletransport.h"
+#include "../protocol/framedecoder.h"
 #include <QLowEnergyCharacteristic>
 
 class BookooScale : public ScaleDevice {
@@ -33,10 +34,23 @@ private slots:
 
 private:
     void sendCommand(const QByteArray& cmd);
+    // Weight frame: 03 0B | ms[3] | unit | sign | weight[3] | ... (20 bytes)
+    struct Framing {
+        static constexpr std::array<uint8_t, 2> Header = {0x03, 0x0B};
+        static constexpr int PrefixLength = 2;
+        static constexpr int MaxFrameLength = 20;
+        static int frameLength(const uint8_t*) { return 20; }
+        // Byte 19 is a checksum, but the known timer commands do not fit a
+        // plain XOR, so it is not verified (the old parser did not either)
+        static bool checksumValid(const uint8_t*, int) { return true; }
+    };
+
     void parseWeightData(const QByteArray& data);
+    void handleFrame(const uint8_t* d);
 
     ScaleBleTransport* m_transport = nullptr;
     QString m_name = "Bookoo";
     bool m_serviceFound = false;
     bool m_characteristicsReady = false;
+    FrameDecoder<Framing, 64> m_decoder;
 };
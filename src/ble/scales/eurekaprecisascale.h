@@ -1,44 +1,40 @@
 #pragma once
 
-#include "../scaledevice.h"
-#include "../transport/scalebletransport.h"
-
-class EurekaPrecisaScale : public ScaleDevice {
-    Q_OBJECT
-
-public:
-    explicit EurekaPrecisaScale(ScaleBleTransport* transport, QObject* parent = nullptr);
-    ~EurekaPrecisaScale() override;
-
-    void connectToDevice(const QBluetoothDeviceInfo& device) override;
-    QString name() const override { return m_name; }
-    QString type() const override { return "eureka_precisa"; }
-
-public slots:
-    void tare() override;
-    void startTimer() override;
-    void stopTimer() override;
-    void resetTimer() override;
-    void sleep() override { turnOff(); }
-
-    void setUnitToGrams();
-    void turnOff();
-    void beepTwice();
-
-private slots:
-    void onTransportConnected();
-    void onTransportDisconnected();
-    void onTransportError(const QString& message);
-    void onServiceDiscovered(const QBluetoothUuid& uuid);
-    void onServicesDiscoveryFinished();
-    void onCharacteristicsDiscoveryFinished(const QBluetoothUuid& serviceUuid);
-    void onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value);
-
-private:
-    void sendCommand(const QByteArray& cmd);
-
-    ScaleBleTransport* m_transport = nullptr;
-    QString m_name = "Eureka Precisa";
-    bool m_serviceFound = false;
-    bool m_characteristicsReady = false;
+#include "protocolscale.h"
+#include "../protocol/de1characteristics.h"
+
+// Eureka Precisa (from de1app binary scan "cucucu cu su cu su"):
+//   Bytes 0-2: header (0xAA, 0x09, 0x41)
+//   Byte 3: timer_running
+//   Bytes 4-5: timer (16-bit little-endian)
+//   Byte 6: sign (1 = negative)
+//   Bytes 7-8: weight (16-bit little-endian, tenths of gram)
+struct EurekaPrecisaProtocol {
+    static constexpr const char* Type = "eureka_precisa";
+    static constexpr const char* DisplayName = "Eureka Precisa";
+    static constexpr const char* LogTag = "EurekaPrecisaScale";
+    static const QBluetoothUuid& service() { return Scale::Generic::SERVICE; }
+    static const QBluetoothUuid& status() { return Scale::Generic::STATUS; }
+    static const QBluetoothUuid& command() { return Scale::Generic::CMD; }
+    // FFF2 only supports Write Without Response
+    static constexpr auto WriteType = ScaleBleTransport::WriteType::WithoutResponse;
+
+    static constexpr std::array<uint8_t, 3> Header = {0xAA, 0x09, 0x41};
+    static constexpr int MinFrameLength = 9;
+    static constexpr auto Checksum = ScaleProtocol::Checksum::None;
+    static constexpr ScaleProtocol::WeightField Weight = {7, 2, ScaleProtocol::Endian::Little, false, 10.0};
+    static constexpr ScaleProtocol::SignRule Sign = {ScaleProtocol::SignRule::ByteEquals, 6, 1};
+
+    // de1app uses 200ms delay, then sets the unit to grams
+    static constexpr ScaleProtocol::InitStep Init[] = {
+        {200, ScaleProtocol::InitAction::EnableNotifications},
+        {0, ScaleProtocol::InitAction::Write, ScaleProtocol::bytes("\xAA\x03\x36\x00")},
+    };
+    static constexpr ScaleProtocol::Bytes Tare = ScaleProtocol::bytes("\xAA\x02\x31\x31");
+    static constexpr ScaleProtocol::Bytes StartTimer = ScaleProtocol::bytes("\xAA\x02\x33\x33");
+    static constexpr ScaleProtocol::Bytes StopTimer = ScaleProtocol::bytes("\xAA\x02\x34\x34");
+    static constexpr ScaleProtocol::Bytes ResetTimer = ScaleProtocol::bytes("\xAA\x02\x35\x35");
+    static constexpr ScaleProtocol::Bytes Sleep = ScaleProtocol::bytes("\xAA\x02\x32\x32");  // turn off
 };
+
+using EurekaPrecisaScale = ProtocolScale<EurekaPrecisaProtocol>;
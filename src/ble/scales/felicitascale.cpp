@@ -50,6 +50,7 @@ void FelicitaScale::connectToDevice(const QBluetoothDeviceInfo& device) {
     }
 
     m_name = device.name();
+    m_decoder.reset();
     m_serviceFound = false;
     m_characteristicsReady = false;
 
@@ -122,19 +123,17 @@ void FelicitaScale::onCharacteristicChanged(const QBluetoothUuid& characteristic
 }
 
 void FelicitaScale::parseResponse(const QByteArray& data) {
-    // Felicita format: header1 header2 sign weight[6] ... battery
-    if (data.size() < 9) return;
-
-    const uint8_t* d = reinterpret_cast<const uint8_t*>(data.constData());
-
-    // Check headers
-    if (d[0] != 0x01 || d[1] != 0x02) return;
+    m_decoder.feed(data, [this](const uint8_t* frame, int) {
+        handleFrame(frame);
+    });
+}
 
+void FelicitaScale::handleFrame(const uint8_t* d) {
     // Sign is at byte 2 ('+' or '-')
     char sign = static_cast<char>(d[2]);
 
     // Weight is 6 ASCII digits starting at byte 3
-    QByteArray weightStr = data.mid(3, 6);
+    QByteArray weightStr = QByteArray::fromRawData(reinterpret_cast<const char*>(d) + 3, 6);
     bool ok;
     int weightInt = weightStr.toInt(&ok);
     if (!ok) return;
@@ -146,14 +145,11 @@ void FelicitaScale::parseResponse(const QByteArray& data) {
 
     setWeight(weight);
 
-    // Battery level is at byte 15 if available
-    if (data.size() >= 16) {
-        uint8_t battery = d[15];
-        // Battery formula from de1app: ((battery - 129) / 29.0) * 100
-        int battLevel = static_cast<int>(((battery - 129) / 29.0) * 100);
-        battLevel = qBound(0, battLevel, 100);
-        setBatteryLevel(battLevel);
-    }
+    // Battery formula from de1app: ((battery - 129) / 29.0) * 100
+    uint8_t battery = d[15];
+    int battLevel = static_cast<int>(((battery - 129) / 29.0) * 100);
+    battLevel = qBound(0, battLevel, 100);
+    setBatteryLevel(battLevel);
 }
 
 void FelicitaScale::sendCommand(uint8_t cmd) {
@@ -2,6 +2,7 @@
 
 #include "../scaledevice.h"
 #include "../transport/scalebletransport.h"
+#include "../protocol/framedecoder.h"
 
 class FelicitaScale : public ScaleDevice {
     Q_OBJECT
@@ -30,11 +31,23 @@ private slots:
     void onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value);
 
 private:
+    // 01 02 | sign | weight[6] ASCII | ... | battery @15 (18 bytes)
+    struct Framing {
+        static constexpr std::array<uint8_t, 2> Header = {0x01, 0x02};
+        static constexpr int PrefixLength = 2;
+        static constexpr int MaxFrameLength = 18;
+        static int frameLength(const uint8_t*) { return 18; }
+        // The protocol has no checksum
+        static bool checksumValid(const uint8_t*, int) { return true; }
+    };
+
     void parseResponse(const QByteArray& data);
+    void handleFrame(const uint8_t* d);
     void sendCommand(uint8_t cmd);
 
     ScaleBleTransport* m_transport = nullptr;
     QString m_name = "Felicita";
     bool m_serviceFound = false;
     bool m_characteristicsReady = false;
+    FrameDecoder<Framing, 64> m_decoder;
 };
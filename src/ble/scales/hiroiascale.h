@@ -1,34 +1,34 @@
 #pragma once
 
-#include "../scaledevice.h"
-#include "../transport/scalebletransport.h"
+#include "protocolscale.h"
+#include "../protocol/de1characteristics.h"
 
-class HiroiaScale : public ScaleDevice {
-    Q_OBJECT
+// Hiroia Jimmy: 4 bytes header, then 24-bit little-endian weight in tenths of gram
+struct HiroiaProtocol {
+    static constexpr const char* Type = "hiroiajimmy";
+    static constexpr const char* DisplayName = "Hiroia Jimmy";
+    static constexpr const char* LogTag = "HiroiaScale";
+    static const QBluetoothUuid& service() { return Scale::HiroiaJimmy::SERVICE; }
+    static const QBluetoothUuid& status() { return Scale::HiroiaJimmy::STATUS; }
+    static const QBluetoothUuid& command() { return Scale::HiroiaJimmy::CMD; }
+    static constexpr auto WriteType = ScaleBleTransport::WriteType::WithResponse;
 
-public:
-    explicit HiroiaScale(ScaleBleTransport* transport, QObject* parent = nullptr);
-    ~HiroiaScale() override;
+    static constexpr std::array<uint8_t, 0> Header = {};
+    static constexpr int MinFrameLength = 7;
+    static constexpr auto Checksum = ScaleProtocol::Checksum::None;
+    static constexpr ScaleProtocol::WeightField Weight = {4, 3, ScaleProtocol::Endian::Little, false, 10.0};
+    // Values >= 8388608 are negative
+    static constexpr ScaleProtocol::SignRule Sign = {ScaleProtocol::SignRule::Offset24};
 
-    void connectToDevice(const QBluetoothDeviceInfo& device) override;
-    QString name() const override { return m_name; }
-    QString type() const override { return "hiroiajimmy"; }
-
-public slots:
-    void tare() override;
-
-private slots:
-    void onTransportConnected();
-    void onTransportDisconnected();
-    void onTransportError(const QString& message);
-    void onServiceDiscovered(const QBluetoothUuid& uuid);
-    void onServicesDiscoveryFinished();
-    void onCharacteristicsDiscoveryFinished(const QBluetoothUuid& serviceUuid);
-    void onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value);
-
-private:
-    ScaleBleTransport* m_transport = nullptr;
-    QString m_name = "Hiroia Jimmy";
-    bool m_serviceFound = false;
-    bool m_characteristicsReady = false;
+    // de1app uses 200ms delay before enabling Hiroia notifications
+    static constexpr ScaleProtocol::InitStep Init[] = {
+        {200, ScaleProtocol::InitAction::EnableNotifications},
+    };
+    static constexpr ScaleProtocol::Bytes Tare = ScaleProtocol::bytes("\x07\x00");
+    static constexpr ScaleProtocol::Bytes StartTimer = {};
+    static constexpr ScaleProtocol::Bytes StopTimer = {};
+    static constexpr ScaleProtocol::Bytes ResetTimer = {};
+    static constexpr ScaleProtocol::Bytes Sleep = {};
 };
+
+using HiroiaScale = ProtocolScale<HiroiaProtocol>;
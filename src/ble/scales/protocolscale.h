@@ -0,0 +1,281 @@
+#pragma once
+
+#include "../scaledevice.h"
+#include "../transport/scalebletransport.h"
+#include <QDebug>
+#include <QTimer>
+#include <array>
+#include <cstdint>
+#include <iterator>
+
+/**
+ * Compile-time protocol descriptions for simple notify/write scales.
+ *
+ * Many scales follow the same pattern: one service with a status (notify)
+ * and a command (write) characteristic, a short init schedule after
+ * characteristic discovery, and a weight field at a fixed offset in every
+ * notification. Such a scale is described by a struct of constexpr values
+ * and ProtocolScale<Descriptor> provides the driver:
+ *
+ *   struct ExampleProtocol {
+ *       static constexpr const char* Type = "example";        // ScaleDevice::type()
+ *       static constexpr const char* DisplayName = "Example"; // default name, error messages
+ *       static constexpr const char* LogTag = "ExampleScale";
+ *       static const QBluetoothUuid& service();
+ *       static const QBluetoothUuid& status();
+ *       static const QBluetoothUuid& command();
+ *       static constexpr auto WriteType = ScaleBleTransport::WriteType::WithResponse;
+ *
+ *       static constexpr std::array<uint8_t, 1> Header = {0x57};
+ *       static constexpr int MinFrameLength = 9;
+ *       static constexpr auto Checksum = ScaleProtocol::Checksum::None;
+ *       static constexpr ScaleProtocol::WeightField Weight = {...};
+ *       static constexpr ScaleProtocol::SignRule Sign = {};
+ *
+ *       static constexpr ScaleProtocol::InitStep Init[] = {
+ *           {200, ScaleProtocol::InitAction::EnableNotifications},
+ *       };
+ *       static constexpr ScaleProtocol::Bytes Tare = ScaleProtocol::bytes("\x54\x01\x01");
+ *       static constexpr ScaleProtocol::Bytes StartTimer = {};   // empty = unsupported
+ *       static constexpr ScaleProtocol::Bytes StopTimer = {};
+ *       static constexpr ScaleProtocol::Bytes ResetTimer = {};
+ *       static constexpr ScaleProtocol::Bytes Sleep = {};
+ *   };
+ *
+ * Weight decoding is a static, allocation-free function of the notification
+ * bytes (ProtocolScale<P>::decodeWeight) that the compiler fully inlines.
+ */
+namespace ScaleProtocol {
+
+enum class Endian { Little, Big };
+
+struct WeightField {
+    int offset = 0;
+    int width = 2;            // bytes, 1-4
+    Endian endian = Endian::Little;
+    bool isSigned = false;    // two's complement
+    double divisor = 1.0;     // raw units per gram
+};
+
+struct SignRule {
+    enum Kind {
+        None,
+        ByteEquals,     // negative when frame[offset] == value
+        ByteGreater,    // negative when frame[offset] > value
+        Offset24        // 24-bit raw >= 0x800000 encodes -(0xFFFFFF - raw)
+    };
+    Kind kind = None;
+    int offset = 0;
+    uint8_t value = 0;
+};
+
+enum class Checksum {
+    None,
+    XorAfterHeader      // last byte is the XOR of everything between header and itself
+};
+
+struct Bytes {
+    const char* data = nullptr;
+    int size = 0;
+    constexpr bool isEmpty() const { return size == 0; }
+};
+
+// Byte string literal, e.g. bytes("\xAA\x02\x31\x31")
+template <int N>
+constexpr Bytes bytes(const char (&literal)[N]) { return {literal, N - 1}; }
+
+enum class InitAction { EnableNotifications, Write };
+
+struct InitStep {
+    int delayMs;        // after the previous step (or after characteristics are ready)
+    InitAction action;
+    Bytes command = {};
+};
+
+} // namespace ScaleProtocol
+
+template <typename Protocol>
+class ProtocolScale : public ScaleDevice {
+public:
+    explicit ProtocolScale(ScaleBleTransport* transport, QObject* parent = nullptr)
+        : ScaleDevice(parent)
+        , m_transport(transport)
+    {
+        if (!m_transport) return;
+        m_transport->setParent(this);
+
+        connect(m_transport, &ScaleBleTransport::connected, this, [this]() {
+            log("Transport connected, starting service discovery");
+            m_transport->discoverServices();
+        });
+        connect(m_transport, &ScaleBleTransport::disconnected, this, [this]() {
+            log("Transport disconnected");
+            setConnected(false);
+        });
+        connect(m_transport, &ScaleBleTransport::error, this, [this](const QString& message) {
+            log(QString("Transport error: %1").arg(message));
+            emit errorOccurred(displayName() + " scale connection error");
+            setConnected(false);
+        });
+        connect(m_transport, &ScaleBleTransport::serviceDiscovered, this, [this](const QBluetoothUuid& uuid) {
+            log(QString("Service discovered: %1").arg(uuid.toString()));
+            if (uuid == Protocol::service()) {
+                log(QString("Found %1 service").arg(displayName()));
+                m_serviceFound = true;
+            }
+        });
+        connect(m_transport, &ScaleBleTransport::servicesDiscoveryFinished, this, [this]() {
+            log(QString("Service discovery finished, service found: %1").arg(m_serviceFound));
+            if (!m_serviceFound) {
+                log(QString("%1 service %2 not found!").arg(displayName(), Protocol::service().toString()));
+                emit errorOccurred(displayName() + " service not found");
+                return;
+            }
+            m_transport->discoverCharacteristics(Protocol::service());
+        });
+        connect(m_transport, &ScaleBleTransport::characteristicsDiscoveryFinished,
+                this, [this](const QBluetoothUuid& serviceUuid) {
+            if (serviceUuid != Protocol::service()) return;
+            if (m_characteristicsReady) {
+                log("Characteristics already set up, ignoring duplicate callback");
+                return;
+            }
+            log("Characteristics discovered");
+            m_characteristicsReady = true;
+            setConnected(true);
+            scheduleInitStep(0);
+        });
+        connect(m_transport, &ScaleBleTransport::characteristicChanged,
+                this, [this](const QBluetoothUuid& characteristicUuid, const QByteArray& value) {
+            if (characteristicUuid != Protocol::status()) return;
+            double weight = 0.0;
+            if (decodeWeight(reinterpret_cast<const uint8_t*>(value.constData()), int(value.size()), weight)) {
+                setWeight(weight);
+            }
+        });
+        // Forward transport logs to scale log
+        connect(m_transport, &ScaleBleTransport::logMessage,
+                this, &ScaleDevice::logMessage);
+    }
+
+    ~ProtocolScale() override {
+        if (m_transport) {
+            m_transport->disconnectFromDevice();
+        }
+    }
+
+    void connectToDevice(const QBluetoothDeviceInfo& device) override {
+        if (!m_transport) {
+            emit errorOccurred("No transport available");
+            return;
+        }
+
+        m_name = device.name();
+        m_serviceFound = false;
+        m_characteristicsReady = false;
+
+        log(QString("Connecting to %1 (%2)").arg(device.name(), device.address().toString()));
+        m_transport->connectToDevice(device);
+    }
+
+    QString name() const override { return m_name; }
+    QString type() const override { return QString::fromLatin1(Protocol::Type); }
+
+    void tare() override {
+        if (Protocol::Tare.isEmpty()) {
+            log("Tare not supported - press button on scale");
+            return;
+        }
+        sendCommand(Protocol::Tare);
+    }
+    void startTimer() override { sendCommand(Protocol::StartTimer); }
+    void stopTimer() override { sendCommand(Protocol::StopTimer); }
+    void resetTimer() override { sendCommand(Protocol::ResetTimer); }
+    void sleep() override { sendCommand(Protocol::Sleep); }
+
+    // Weight from one notification; false if it is not a valid weight frame
+    static bool decodeWeight(const uint8_t* d, int size, double& weight) {
+        using namespace ScaleProtocol;
+
+        if (size < Protocol::MinFrameLength) return false;
+        for (size_t i = 0; i < Protocol::Header.size(); i++) {
+            if (d[i] != Protocol::Header[i]) return false;
+        }
+
+        if constexpr (Protocol::Checksum == Checksum::XorAfterHeader) {
+            uint8_t x = 0;
+            for (int i = int(Protocol::Header.size()); i < size - 1; i++) {
+                x ^= d[i];
+            }
+            if (x != d[size - 1]) return false;
+        }
+
+        constexpr WeightField f = Protocol::Weight;
+        static_assert(f.width >= 1 && f.width <= 4, "Weight field must be 1-4 bytes");
+        static_assert(f.offset + f.width <= Protocol::MinFrameLength, "Weight field beyond minimum frame");
+
+        uint32_t raw = 0;
+        for (int i = 0; i < f.width; i++) {
+            int index = (f.endian == Endian::Little) ? f.offset + f.width - 1 - i : f.offset + i;
+            raw = (raw << 8) | d[index];
+        }
+
+        double value;
+        if constexpr (f.isSigned) {
+            constexpr int shift = 32 - 8 * f.width;
+            value = static_cast<double>(static_cast<int32_t>(raw << shift) >> shift);
+        } else {
+            value = static_cast<double>(raw);
+        }
+
+        constexpr SignRule sign = Protocol::Sign;
+        if constexpr (sign.kind == SignRule::ByteEquals) {
+            if (d[sign.offset] == sign.value) value = -value;
+        } else if constexpr (sign.kind == SignRule::ByteGreater) {
+            if (d[sign.offset] > sign.value) value = -value;
+        } else if constexpr (sign.kind == SignRule::Offset24) {
+            if (raw >= 0x800000) value = -static_cast<double>(0xFFFFFF - raw);
+        }
+
+        weight = value / f.divisor;
+        return true;
+    }
+
+private:
+    void scheduleInitStep(size_t index) {
+        if (index >= std::size(Protocol::Init)) return;
+        const ScaleProtocol::InitStep& step = Protocol::Init[index];
+
+        QTimer::singleShot(step.delayMs, this, [this, index]() {
+            if (!m_transport || !m_characteristicsReady) return;
+            const ScaleProtocol::InitStep& step = Protocol::Init[index];
+            if (step.action == ScaleProtocol::InitAction::EnableNotifications) {
+                log("Enabling notifications");
+                m_transport->enableNotifications(Protocol::service(), Protocol::status());
+            } else {
+                sendCommand(step.command);
+            }
+            scheduleInitStep(index + 1);
+        });
+    }
+
+    void sendCommand(ScaleProtocol::Bytes command) {
+        if (command.isEmpty() || !m_transport || !m_characteristicsReady) return;
+        m_transport->writeCharacteristic(Protocol::service(), Protocol::command(),
+                                         QByteArray::fromRawData(command.data, command.size),
+                                         Protocol::WriteType);
+    }
+
+    static QString displayName() { return QString::fromLatin1(Protocol::DisplayName); }
+
+    void log(const QString& message) {
+        QString msg = QString("[BLE %1] ").arg(QLatin1String(Protocol::LogTag)) + message;
+        qDebug().noquote() << msg;
+        emit logMessage(msg);
+    }
+
+    ScaleBleTransport* m_transport = nullptr;
+    QString m_name = displayName();
+    bool m_serviceFound = false;
+    bool m_characteristicsReady = false;
+};
@@ -12,16 +12,22 @@
 #include "atomhearteclairscale.h"
 #include "variaakuscale.h"
 
+#include <QDateTime>
+#include <QDir>
 #include <QLoggingCategory>
 
 Q_LOGGING_CATEGORY(lcScaleFactory, "bridge.scale.factory")
 
 // Transport implementations
 #include "../transport/qtscalebletransport.h"
+#include "../transport/replayscalebletransport.h"
+#include "../transport/scalecapture.h"
 #ifdef Q_OS_IOS
 #include "../transport/corebluetooth/corebluetoothscalebletransport.h"
 #endif
 
+QString ScaleFactory::s_captureDirectory;
+
 namespace {
     ScaleBleTransport* createTransportForPlatform() {
 #ifdef Q_OS_IOS
@@ -37,24 +43,8 @@ namespace {
 }
 
 ScaleType ScaleFactory::detectScaleType(const QBluetoothDeviceInfo& device) {
-    QString name = device.name().toLower();
-
-    // Check each scale type by name pattern
-    if (isDecentScale(name)) return ScaleType::DecentScale;
-    // All Acaia scales (Lunar, Pearl, Pyxis) now use unified AcaiaScale with auto-detection
-    if (isAcaiaPyxis(name) || isAcaiaScale(name)) return ScaleType::Acaia;
-    if (isFelicitaScale(name)) return ScaleType::Felicita;
-    if (isSkaleScale(name)) return ScaleType::Skale;
-    if (isHiroiaJimmy(name)) return ScaleType::HiroiaJimmy;
-    if (isBookooScale(name)) return ScaleType::Bookoo;
-    if (isSmartChefScale(name)) return ScaleType::SmartChef;
-    if (isDifluidScale(name)) return ScaleType::Difluid;
-    if (isEurekaPrecisa(name)) return ScaleType::EurekaPrecisa;
-    if (isSoloBarista(name)) return ScaleType::SoloBarista;
-    if (isAtomheartEclair(name)) return ScaleType::AtomheartEclair;
-    if (isVariaAku(name)) return ScaleType::VariaAku;
-
-    return ScaleType::Unknown;
+    ScaleType type = DeviceClassifier::classify(device);
+    return DeviceClassifier::category(type) == DeviceCategory::Scale ? type : ScaleType::Unknown;
 }
 
 std::unique_ptr<ScaleDevice> ScaleFactory::createScale(const QBluetoothDeviceInfo& device, QObject* parent) {
@@ -62,36 +52,8 @@ std::unique_ptr<ScaleDevice> ScaleFactory::createScale(const QBluetoothDeviceInf
     qCInfo(lcScaleFactory) << "Creating scale for" << device.name()
                            << "detected type:" << scaleTypeName(type);
 
-    switch (type) {
-        case ScaleType::DecentScale:
-            return std::make_unique<DecentScale>(createTransportForPlatform(), parent);
-        case ScaleType::Acaia:
-        case ScaleType::AcaiaPyxis:
-            // Unified AcaiaScale auto-detects IPS vs Pyxis protocol
-            return std::make_unique<AcaiaScale>(createTransportForPlatform(), parent);
-        case ScaleType::Felicita:
-            return std::make_unique<FelicitaScale>(createTransportForPlatform(), parent);
-        case ScaleType::Skale:
-            return std::make_unique<SkaleScale>(createTransportForPlatform(), parent);
-        case ScaleType::HiroiaJimmy:
-            return std::make_unique<HiroiaScale>(createTransportForPlatform(), parent);
-        case ScaleType::Bookoo:
-            return std::make_unique<BookooScale>(createTransportForPlatform(), parent);
-        case ScaleType::SmartChef:
-            return std::make_unique<SmartChefScale>(createTransportForPlatform(), parent);
-        case ScaleType::Difluid:
-            return std::make_unique<DifluidScale>(createTransportForPlatform(), parent);
-        case ScaleType::EurekaPrecisa:
-            return std::make_unique<EurekaPrecisaScale>(createTransportForPlatform(), parent);
-        case ScaleType::SoloBarista:
-            return std::make_unique<SoloBarristaScale>(createTransportForPlatform(), parent);
-        case ScaleType::AtomheartEclair:
-            return std::make_unique<AtomheartEclairScale>(createTransportForPlatform(), parent);
-        case ScaleType::VariaAku:
-            return std::make_unique<VariaAkuScale>(createTransportForPlatform(), parent);
-        default:
-            return nullptr;
-    }
+    if (type == ScaleType::Unknown) return nullptr;
+    return createScaleOfType(type, createTransport(device, type), parent);
 }
 
 bool ScaleFactory::isKnownScale(const QBluetoothDeviceInfo& device) {
@@ -99,146 +61,89 @@ bool ScaleFactory::isKnownScale(const QBluetoothDeviceInfo& device) {
 }
 
 std::unique_ptr<ScaleDevice> ScaleFactory::createScale(const QBluetoothDeviceInfo& device, const QString& typeName, QObject* parent) {
-    // Map type name to ScaleType enum
-    ScaleType type = ScaleType::Unknown;
-
-    QString name = typeName.toLower();
-    if (name.contains("decent")) type = ScaleType::DecentScale;
-    else if (name.contains("pyxis")) type = ScaleType::AcaiaPyxis;
-    else if (name.contains("acaia")) type = ScaleType::Acaia;
-    else if (name.contains("felicita")) type = ScaleType::Felicita;
-    else if (name.contains("skale")) type = ScaleType::Skale;
-    else if (name.contains("hiroia") || name.contains("jimmy")) type = ScaleType::HiroiaJimmy;
-    else if (name.contains("bookoo")) type = ScaleType::Bookoo;
-    else if (name.contains("smartchef")) type = ScaleType::SmartChef;
-    else if (name.contains("difluid")) type = ScaleType::Difluid;
-    else if (name.contains("eureka") || name.contains("precisa")) type = ScaleType::EurekaPrecisa;
-    else if (name.contains("solo") || name.contains("barista")) type = ScaleType::SoloBarista;
-    else if (name.contains("eclair") || name.contains("atomheart")) type = ScaleType::AtomheartEclair;
-    else if (name.contains("aku") || name.contains("varia")) type = ScaleType::VariaAku;
+    ScaleType type = scaleTypeFromName(typeName);
 
     if (type == ScaleType::Unknown) {
         // Fall back to detection from device name
         return createScale(device, parent);
     }
 
+    return createScaleOfType(type, createTransport(device, type), parent);
+}
+
+std::unique_ptr<ScaleDevice> ScaleFactory::createReplayScale(const ScaleCapture& capture, double speed, QObject* parent) {
+    ScaleType type = scaleTypeFromName(capture.scaleType);
+    if (type == ScaleType::Unknown) {
+        qCWarning(lcScaleFactory) << "Capture has unknown scale type:" << capture.scaleType;
+        return nullptr;
+    }
+
+    qCInfo(lcScaleFactory) << "Creating" << scaleTypeName(type) << "driver for capture of" << capture.deviceName;
+    return createScaleOfType(type, new ReplayScaleBleTransport(capture, speed), parent);
+}
+
+void ScaleFactory::setCaptureDirectory(const QString& dir) {
+    s_captureDirectory = dir;
+    if (!dir.isEmpty()) {
+        QDir().mkpath(dir);
+        qCInfo(lcScaleFactory) << "Recording scale traffic to" << dir;
+    }
+}
+
+ScaleBleTransport* ScaleFactory::createTransport(const QBluetoothDeviceInfo& device, ScaleType type) {
+    ScaleBleTransport* transport = createTransportForPlatform();
+    if (!s_captureDirectory.isEmpty()) {
+        QString fileName = QString("%1-%2.jsonl")
+            .arg(scaleTypeName(type).remove(' ').toLower(),
+                 QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss"));
+        new ScaleCaptureRecorder(transport, QDir(s_captureDirectory).filePath(fileName),
+                                 scaleTypeName(type), device.name());
+    }
+    return transport;
+}
+
+ScaleType ScaleFactory::scaleTypeFromName(const QString& typeName) {
+    // A model or API name ("Varia Aku", "Varia"), else an advertised name
+    ScaleType type = DeviceClassifier::typeFromName(typeName);
+    if (type == ScaleType::Unknown) type = DeviceClassifier::classifyName(typeName);
+    return DeviceClassifier::category(type) == DeviceCategory::Scale ? type : ScaleType::Unknown;
+}
+
+std::unique_ptr<ScaleDevice> ScaleFactory::createScaleOfType(ScaleType type, ScaleBleTransport* transport, QObject* parent) {
     switch (type) {
         case ScaleType::DecentScale:
-            return std::make_unique<DecentScale>(createTransportForPlatform(), parent);
+            return std::make_unique<DecentScale>(transport, parent);
         case ScaleType::Acaia:
         case ScaleType::AcaiaPyxis:
             // Unified AcaiaScale auto-detects IPS vs Pyxis protocol
-            return std::make_unique<AcaiaScale>(createTransportForPlatform(), parent);
+            return std::make_unique<AcaiaScale>(transport, parent);
         case ScaleType::Felicita:
-            return std::make_unique<FelicitaScale>(createTransportForPlatform(), parent);
+            return std::make_unique<FelicitaScale>(transport, parent);
         case ScaleType::Skale:
-            return std::make_unique<SkaleScale>(createTransportForPlatform(), parent);
+            return std::make_unique<SkaleScale>(transport, parent);
         case ScaleType::HiroiaJimmy:
-            return std::make_unique<HiroiaScale>(createTransportForPlatform(), parent);
+            return std::make_unique<HiroiaScale>(transport, parent);
         case ScaleType::Bookoo:
-            return std::make_unique<BookooScale>(createTransportForPlatform(), parent);
+            return std::make_unique<BookooScale>(transport, parent);
         case ScaleType::SmartChef:
-            return std::make_unique<SmartChefScale>(createTransportForPlatform(), parent);
+            return std::make_unique<SmartChefScale>(transport, parent);
         case ScaleType::Difluid:
-            return std::make_unique<DifluidScale>(createTransportForPlatform(), parent);
+            return std::make_unique<DifluidScale>(transport, parent);
         case ScaleType::EurekaPrecisa:
-            return std::make_unique<EurekaPrecisaScale>(createTransportForPlatform(), parent);
+            return std::make_unique<EurekaPrecisaScale>(transport, parent);
         case ScaleType::SoloBarista:
-            return std::make_unique<SoloBarristaScale>(createTransportForPlatform(), parent);
+            return std::make_unique<SoloBarristaScale>(transport, parent);
         case ScaleType::AtomheartEclair:
-            return std::make_unique<AtomheartEclairScale>(createTransportForPlatform(), parent);
+            return std::make_unique<AtomheartEclairScale>(transport, parent);
         case ScaleType::VariaAku:
-            return std::make_unique<VariaAkuScale>(createTransportForPlatform(), parent);
+            return std::make_unique<VariaAkuScale>(transport, parent);
         default:
+            delete transport;
             return nullptr;
     }
 }
 
 QString ScaleFactory::scaleTypeName(ScaleType type) {
-    switch (type) {
-        case ScaleType::DecentScale: return "Decent Scale";
-        case ScaleType::Acaia: return "Acaia";
-        case ScaleType::AcaiaPyxis: return "Acaia Pyxis";
-        case ScaleType::Felicita: return "Felicita";
-        case ScaleType::Skale: return "Skale";
-        case ScaleType::HiroiaJimmy: return "Hiroia Jimmy";
-        case ScaleType::Bookoo: return "Bookoo";
-        case ScaleType::SmartChef: return "SmartChef";
-        case ScaleType::Difluid: return "Difluid";
-        case ScaleType::EurekaPrecisa: return "Eureka Precisa";
-        case ScaleType::SoloBarista: return "Solo Barista";
-        case ScaleType::AtomheartEclair: return "Atomheart Eclair";
-        case ScaleType::VariaAku: return "Varia Aku";
-        default: return "Unknown";
-    }
-}
-
-// Detection functions based on device name patterns from de1app
-bool ScaleFactory::isDecentScale(const QString& name) {
-    return name.contains("decent scale");
-}
-
-bool ScaleFactory::isAcaiaScale(const QString& name) {
-    // Acaia scales: ACAIA, LUNAR, PEARL, PROCH
-    return name.contains("acaia") ||
-           name.contains("lunar") ||
-           name.contains("pearl") ||
-           name.contains("proch");
-}
-
-bool ScaleFactory::isAcaiaPyxis(const QString& name) {
-    return name.contains("pyxis");
-}
-
-bool ScaleFactory::isFelicitaScale(const QString& name) {
-    return name.contains("felicita") ||
-           name.contains("ecompass");
-}
-
-bool ScaleFactory::isSkaleScale(const QString& name) {
-    return name.contains("skale");
-}
-
-bool ScaleFactory::isHiroiaJimmy(const QString& name) {
-    return name.contains("hiroia") ||
-           name.contains("jimmy");
-}
-
-bool ScaleFactory::isBookooScale(const QString& name) {
-    // Match bookoo_sc (Themis scale) but NOT bookoo_em (Espresso Monitor pressure sensor)
-    if (name.contains("bookoo_em")) {
-        return false;  // Espresso Monitor is a pressure sensor, not a scale
-    }
-    return name.contains("bookoo") ||
-           name.contains("bkscale");
-}
-
-bool ScaleFactory::isSmartChefScale(const QString& name) {
-    return name.contains("smartchef");
-}
-
-bool ScaleFactory::isDifluidScale(const QString& name) {
-    return name.contains("difluid") ||
-           name.contains("microbalance");
-}
-
-bool ScaleFactory::isEurekaPrecisa(const QString& name) {
-    return name.contains("eureka") ||
-           name.contains("precisa") ||
-           name.contains("cfs-9002");
-}
-
-bool ScaleFactory::isSoloBarista(const QString& name) {
-    return name.contains("solo barista") ||
-           name.contains("lsj-001");
-}
-
-bool ScaleFactory::isAtomheartEclair(const QString& name) {
-    return name.contains("eclair") ||
-           name.contains("atomheart");
-}
-
-bool ScaleFactory::isVariaAku(const QString& name) {
-    return name.contains("aku") ||
-           name.contains("varia");
+    if (DeviceClassifier::category(type) != DeviceCategory::Scale) return "Unknown";
+    return DeviceClassifier::typeName(type);
 }
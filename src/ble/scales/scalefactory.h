@@ -1,28 +1,16 @@
 #pragma once
 
+#include "../deviceclassifier.h"
 #include <QObject>
 #include <QBluetoothDeviceInfo>
 #include <memory>
 
 class ScaleDevice;
+class ScaleBleTransport;
+struct ScaleCapture;
 
-// Scale types supported
-enum class ScaleType {
-    Unknown,
-    DecentScale,
-    Acaia,
-    AcaiaPyxis,
-    Felicita,
-    Skale,
-    HiroiaJimmy,
-    Bookoo,
-    SmartChef,
-    Difluid,
-    EurekaPrecisa,
-    SoloBarista,
-    AtomheartEclair,
-    VariaAku
-};
+// Scale types are the scale entries of the shared device classification
+using ScaleType = DeviceType;
 
 class ScaleFactory {
 public:
@@ -35,6 +23,14 @@ public:
     // Create scale with explicit type (for direct connect without device name)
     static std::unique_ptr<ScaleDevice> createScale(const QBluetoothDeviceInfo& device, const QString& typeName, QObject* parent = nullptr);
 
+    // Create the driver a capture was recorded from, fed by a replay transport
+    // (speed 1.0 = real time, 0 = as fast as possible)
+    static std::unique_ptr<ScaleDevice> createReplayScale(const ScaleCapture& capture, double speed, QObject* parent = nullptr);
+
+    // Record the BLE traffic of every scale created from now on as a capture
+    // file in dir (empty disables recording)
+    static void setCaptureDirectory(const QString& dir);
+
     // Check if a device is a known scale
     static bool isKnownScale(const QBluetoothDeviceInfo& device);
 
@@ -42,18 +38,9 @@ public:
     static QString scaleTypeName(ScaleType type);
 
 private:
-    // Device name patterns for detection
-    static bool isDecentScale(const QString& name);
-    static bool isAcaiaScale(const QString& name);
-    static bool isAcaiaPyxis(const QString& name);
-    static bool isFelicitaScale(const QString& name);
-    static bool isSkaleScale(const QString& name);
-    static bool isHiroiaJimmy(const QString& name);
-    static bool isBookooScale(const QString& name);
-    static bool isSmartChefScale(const QString& name);
-    static bool isDifluidScale(const QString& name);
-    static bool isEurekaPrecisa(const QString& name);
-    static bool isSoloBarista(const QString& name);
-    static bool isAtomheartEclair(const QString& name);
-    static bool isVariaAku(const QString& name);
+    static ScaleType scaleTypeFromName(const QString& typeName);
+    static ScaleBleTransport* createTransport(const QBluetoothDeviceInfo& device, ScaleType type);
+    static std::unique_ptr<ScaleDevice> createScaleOfType(ScaleType type, ScaleBleTransport* transport, QObject* parent);
+
+    static QString s_captureDirectory;
 };
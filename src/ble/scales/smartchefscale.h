@@ -1,34 +1,35 @@
 #pragma once
 
-#include "../scaledevice.h"
-#include "../transport/scalebletransport.h"
+#include "protocolscale.h"
+#include "../protocol/de1characteristics.h"
 
-class SmartChefScale : public ScaleDevice {
-    Q_OBJECT
+// SmartChef: weight in bytes 5-6 as big-endian short (tenths of gram),
+// negative when byte 3 > 10
+struct SmartChefProtocol {
+    static constexpr const char* Type = "smartchef";
+    static constexpr const char* DisplayName = "SmartChef";
+    static constexpr const char* LogTag = "SmartChefScale";
+    static const QBluetoothUuid& service() { return Scale::Generic::SERVICE; }
+    static const QBluetoothUuid& status() { return Scale::Generic::STATUS; }
+    static const QBluetoothUuid& command() { return Scale::Generic::CMD; }
+    static constexpr auto WriteType = ScaleBleTransport::WriteType::WithResponse;
 
-public:
-    explicit SmartChefScale(ScaleBleTransport* transport, QObject* parent = nullptr);
-    ~SmartChefScale() override;
+    static constexpr std::array<uint8_t, 0> Header = {};
+    static constexpr int MinFrameLength = 7;
+    static constexpr auto Checksum = ScaleProtocol::Checksum::None;
+    static constexpr ScaleProtocol::WeightField Weight = {5, 2, ScaleProtocol::Endian::Big, true, 10.0};
+    static constexpr ScaleProtocol::SignRule Sign = {ScaleProtocol::SignRule::ByteGreater, 3, 10};
 
-    void connectToDevice(const QBluetoothDeviceInfo& device) override;
-    QString name() const override { return m_name; }
-    QString type() const override { return "smartchef"; }
-
-public slots:
-    void tare() override;  // SmartChef doesn't support software tare
-
-private slots:
-    void onTransportConnected();
-    void onTransportDisconnected();
-    void onTransportError(const QString& message);
-    void onServiceDiscovered(const QBluetoothUuid& uuid);
-    void onServicesDiscoveryFinished();
-    void onCharacteristicsDiscoveryFinished(const QBluetoothUuid& serviceUuid);
-    void onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value);
-
-private:
-    ScaleBleTransport* m_transport = nullptr;
-    QString m_name = "SmartChef";
-    bool m_serviceFound = false;
-    bool m_characteristicsReady = false;
+    // de1app uses 100ms delay for SmartChef
+    static constexpr ScaleProtocol::InitStep Init[] = {
+        {100, ScaleProtocol::InitAction::EnableNotifications},
+    };
+    // SmartChef doesn't support software tare - the user presses the button on the scale
+    static constexpr ScaleProtocol::Bytes Tare = {};
+    static constexpr ScaleProtocol::Bytes StartTimer = {};
+    static constexpr ScaleProtocol::Bytes StopTimer = {};
+    static constexpr ScaleProtocol::Bytes ResetTimer = {};
+    static constexpr ScaleProtocol::Bytes Sleep = {};
 };
+
+using SmartChefScale = ProtocolScale<SmartChefProtocol>;
@@ -3,15 +3,10 @@
 #include "eurekaprecisascale.h"
 
 // Solo Barista uses the same protocol as Eureka Precisa
-class SoloBarristaScale : public EurekaPrecisaScale {
-    Q_OBJECT
-
-public:
-    explicit SoloBarristaScale(ScaleBleTransport* transport, QObject* parent = nullptr);
-
-    QString name() const override { return m_scaleName; }
-    QString type() const override { return "solo_barista"; }
-
-private:
-    QString m_scaleName = "Solo Barista";
+struct SoloBaristaProtocol : EurekaPrecisaProtocol {
+    static constexpr const char* Type = "solo_barista";
+    static constexpr const char* DisplayName = "Solo Barista";
+    static constexpr const char* LogTag = "SoloBarristaScale";
 };
+
+using SoloBarristaScale = ProtocolScale<SoloBaristaProtocol>;
@@ -60,6 +60,7 @@ void VariaAkuScale::connectToDevice(const QBluetoothDeviceInfo& device) {
     }
 
     m_name = device.name();
+    m_decoder.reset();
     m_serviceFound = false;
     m_characteristicsReady = false;
 
@@ -210,44 +211,43 @@ void VariaAkuScale::onTickleTimeout() {
 
 void VariaAkuScale::onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value) {
     if (characteristicUuid == Scale::VariaAku::STATUS) {
-        // Varia Aku format: header command length payload xor
-        // Weight notification: command 0x01, length 0x03, payload w1 w2 w3 xor
-        if (value.size() >= 4) {
-            const uint8_t* d = reinterpret_cast<const uint8_t*>(value.constData());
-
-            uint8_t command = d[1];
-            uint8_t length = d[2];
-
-            // Weight notification
-            if (command == 0x01 && length == 0x03 && value.size() >= 7) {
-                // Tickle watchdog on every weight update
-                tickleWatchdog();
-
-                uint8_t w1 = d[3];
-                uint8_t w2 = d[4];
-                uint8_t w3 = d[5];
-
-                // Sign is in highest nibble of w1 (0x10 means negative)
-                bool isNegative = (w1 & 0x10) != 0;
-
-                // Weight is 3 bytes big-endian in hundredths of gram
-                // Strip sign nibble from w1
-                uint32_t weightRaw = ((w1 & 0x0F) << 16) | (w2 << 8) | w3;
-                double weight = weightRaw / 100.0;
-
-                if (isNegative) {
-                    weight = -weight;
-                }
-
-                setWeight(weight);
-            }
-            // Battery notification
-            else if (command == 0x85 && length == 0x01 && value.size() >= 5) {
-                uint8_t battery = d[3];
-                VARIA_LOG(QString("Battery update: %1%").arg(battery));
-                setBatteryLevel(battery);
-            }
+        m_decoder.feed(value, [this](const uint8_t* frame, int length) {
+            handleFrame(frame, length);
+        });
+    }
+}
+
+void VariaAkuScale::handleFrame(const uint8_t* d, int length) {
+    uint8_t command = d[1];
+
+    // Weight notification: command 0x01, length 0x03, payload w1 w2 w3 xor
+    if (command == 0x01 && length == 7) {
+        // Tickle watchdog on every weight update
+        tickleWatchdog();
+
+        uint8_t w1 = d[3];
+        uint8_t w2 = d[4];
+        uint8_t w3 = d[5];
+
+        // Sign is in highest nibble of w1 (0x10 means negative)
+        bool isNegative = (w1 & 0x10) != 0;
+
+        // Weight is 3 bytes big-endian in hundredths of gram
+        // Strip sign nibble from w1
+        uint32_t weightRaw = ((w1 & 0x0F) << 16) | (w2 << 8) | w3;
+        double weight = weightRaw / 100.0;
+
+        if (isNegative) {
+            weight = -weight;
         }
+
+        setWeight(weight);
+    }
+    // Battery notification
+    else if (command == 0x85 && length == 5) {
+        uint8_t battery = d[3];
+        VARIA_LOG(QString("Battery update: %1%").arg(battery));
+        setBatteryLevel(battery);
     }
 }
 
@@ -2,6 +2,7 @@
 
 #include "../scaledevice.h"
 #include "../transport/scalebletransport.h"
+#include "../protocol/framedecoder.h"
 #include <QTimer>
 
 class VariaAkuScale : public ScaleDevice {
@@ -14,6 +15,8 @@ public:
     void connectToDevice(const QBluetoothDeviceInfo& device) override;
     QString name() const override { return m_name; }
     QString type() const override { return "varia_aku"; }
+    // The watchdog treats a silent scale as lost
+    bool supportsNotificationPause() const override { return false; }
 
 public slots:
     void tare() override;
@@ -30,6 +33,18 @@ private slots:
     void onTickleTimeout();
 
 private:
+    // FA | command | length | payload[length] | xor
+    struct Framing {
+        static constexpr std::array<uint8_t, 1> Header = {0xFA};
+        static constexpr int PrefixLength = 3;
+        static constexpr int MaxFrameLength = 4 + 16;
+        static int frameLength(const uint8_t* prefix) { return prefix[2] <= 16 ? 4 + prefix[2] : -1; }
+        // Not verified until checked against captures from real scales;
+        // the old parser ignored it too
+        static bool checksumValid(const uint8_t*, int) { return true; }
+    };
+
+    void handleFrame(const uint8_t* d, int length);
     void sendCommand(const QByteArray& cmd);
     void enableNotifications();
     void startWatchdog();
@@ -46,6 +61,8 @@ private:
     QTimer* m_tickleTimer = nullptr;
     int m_watchdogRetries = 0;
     bool m_updatesReceived = false;
+
+    FrameDecoder<Framing, 64> m_decoder;
     static constexpr int WATCHDOG_TIMEOUT_MS = 1000;      // Retry interval
     static constexpr int TICKLE_TIMEOUT_MS = 2000;        // No-update timeout
     static constexpr int MAX_WATCHDOG_RETRIES = 10;
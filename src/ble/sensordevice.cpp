@@ -1,9 +1,13 @@
 #include "sensordevice.h"
+#include "transport/scalecapture.h"
 #include <QLoggingCategory>
 #include <QDateTime>
+#include <QDir>
 
 Q_LOGGING_CATEGORY(lcSensor, "bridge.sensor")
 
+QString SensorDevice::s_captureDirectory;
+
 SensorDevice::SensorDevice(QObject *parent)
     : QObject(parent)
 {
@@ -22,10 +26,20 @@ void SensorDevice::connectToDevice(const QBluetoothDeviceInfo &device)
 
     m_name = device.name();
     m_address = device.address().toString();
-    m_id = QString("%1_%2").arg(sensorType().toLower()).arg(m_address.replace(":", ""));
+    // The address keeps its colons: the bridge derives the link id from it
+    m_id = QString("%1_%2").arg(sensorType().toLower(), QString(m_address).remove(':'));
 
     qCInfo(lcSensor) << "Connecting to sensor" << m_name << "at" << m_address;
 
+    m_capture.reset();
+    if (!s_captureDirectory.isEmpty()) {
+        QString fileName = QString("%1-%2.jsonl")
+            .arg(sensorType().remove(' ').toLower(),
+                 QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss"));
+        m_capture = std::make_unique<CaptureWriter>(QDir(s_captureDirectory).filePath(fileName),
+                                                    "decentbridge-sensor", sensorType(), m_name);
+    }
+
     m_controller = QLowEnergyController::createCentral(device, this);
 
     connect(m_controller, &QLowEnergyController::connected,
@@ -105,8 +119,15 @@ void SensorDevice::onServiceDiscoveryFinished()
         }
     });
 
+    // One notification may set several channels; they go out as one update
     connect(m_service, &QLowEnergyService::characteristicChanged,
-            this, &SensorDevice::onCharacteristicChanged);
+            this, [this](const QLowEnergyCharacteristic &c, const QByteArray &value) {
+        if (m_capture && !m_capture->writeNotification(c.uuid(), value)) {
+            m_capture.reset();
+        }
+        onCharacteristicChanged(c, value);
+        commitChannels();
+    });
 
     m_service->discoverDetails();
 }
@@ -118,25 +139,37 @@ void SensorDevice::onCharacteristicChanged(const QLowEnergyCharacteristic &c, co
     // Override in subclasses
 }
 
-double SensorDevice::value(const QString &key) const
+void SensorDevice::setCaptureDirectory(const QString &dir)
 {
-    for (const auto &channel : m_channels) {
-        if (channel.key == key) {
-            return channel.value;
-        }
+    s_captureDirectory = dir;
+    if (!dir.isEmpty()) {
+        QDir().mkpath(dir);
+        qCInfo(lcSensor) << "Recording sensor traffic to" << dir;
     }
-    return 0;
 }
 
-void SensorDevice::updateChannel(const QString &key, double value)
+int SensorDevice::addChannel(const QString &key, const QString &type, const QString &unit)
 {
-    for (auto &channel : m_channels) {
-        if (channel.key == key) {
-            channel.value = value;
-            emit dataUpdated(toSnapshot());
-            return;
-        }
-    }
+    Q_ASSERT(!m_channelIndex.contains(key));
+    int index = m_channels.size();
+    m_channels.append({key, type, unit});
+    m_values.append(0);
+    m_channelIndex.insert(key, index);
+    return index;
+}
+
+void SensorDevice::setChannelValue(int channel, double value)
+{
+    Q_ASSERT(channel >= 0 && channel < m_values.size());
+    m_values[channel] = value;
+    m_valuesPending = true;
+}
+
+void SensorDevice::commitChannels()
+{
+    if (!m_valuesPending) return;
+    m_valuesPending = false;
+    emit dataUpdated(toSnapshot());
 }
 
 QJsonObject SensorDevice::toJson() const
@@ -166,8 +199,8 @@ QJsonObject SensorDevice::toSnapshot() const
     obj["id"] = m_id;
 
     QJsonObject values;
-    for (const auto &channel : m_channels) {
-        values[channel.key] = channel.value;
+    for (int i = 0; i < m_channels.size(); ++i) {
+        values[m_channels[i].key] = m_values[i];
     }
     obj["values"] = values;
 
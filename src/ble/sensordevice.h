@@ -7,6 +7,10 @@
 #include <QLowEnergyService>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QHash>
+#include <memory>
+
+class CaptureWriter;
 
 /**
  * @brief Base class for BLE sensor devices
@@ -24,7 +28,6 @@ public:
         QString key;
         QString type;  // "number", "boolean", "string"
         QString unit;  // "bar", "celsius", etc.
-        double value = 0;
     };
 
     explicit SensorDevice(QObject *parent = nullptr);
@@ -41,14 +44,20 @@ public:
     QString address() const { return m_address; }
     virtual QString sensorType() const { return "generic"; }
 
-    // Data channels
+    // Data channels, addressed by the index addChannel() returned
     QList<DataChannel> dataChannels() const { return m_channels; }
-    double value(const QString &key) const;
+    int channelIndex(const QString &key) const { return m_channelIndex.value(key, -1); }
+    double value(int channel) const { return m_values.value(channel); }
+    double value(const QString &key) const { return value(channelIndex(key)); }
 
     // JSON representation
     QJsonObject toJson() const;
     QJsonObject toSnapshot() const;
 
+    // Record the notifications of every sensor connected from now on as a
+    // capture file in dir (empty disables recording); --decode-sensor reads it
+    static void setCaptureDirectory(const QString &dir);
+
 signals:
     void connected();
     void disconnected();
@@ -66,7 +75,14 @@ protected slots:
 protected:
     virtual void setupService() = 0;
     virtual QBluetoothUuid serviceUuid() const = 0;
-    void updateChannel(const QString &key, double value);
+
+    // Register a channel (in the constructor); returns its index
+    int addChannel(const QString &key, const QString &type, const QString &unit);
+    // Stage a value. Values staged while handling one notification are
+    // emitted together as a single dataUpdated afterwards.
+    void setChannelValue(int channel, double value);
+    // Emit staged values now, for updates outside a notification
+    void commitChannels();
 
     QLowEnergyController *m_controller = nullptr;
     QLowEnergyService *m_service = nullptr;
@@ -74,7 +90,15 @@ protected:
     QString m_id;
     QString m_name;
     QString m_address;
+
+private:
     QList<DataChannel> m_channels;
+    QList<double> m_values;                 // Parallel to m_channels
+    QHash<QString, int> m_channelIndex;     // Key -> index, for lookups by name
+    bool m_valuesPending = false;
+    std::unique_ptr<CaptureWriter> m_capture;
+
+    static QString s_captureDirectory;
 };
 
 #endif // SENSORDEVICE_H
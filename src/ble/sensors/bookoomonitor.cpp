@@ -11,19 +11,7 @@ BookooMonitor::BookooMonitor(QObject *parent)
     : SensorDevice(parent)
 {
     // Define data channels
-    m_channels.append({
-        "pressure",
-        "number",
-        "bar",
-        0
-    });
-}
-
-bool BookooMonitor::isBookooMonitor(const QBluetoothDeviceInfo &device)
-{
-    QString name = device.name().toUpper();
-    // Bookoo Espresso Monitor typically advertises as "BOOKOO_EM" or similar
-    return name.contains("BOOKOO") && (name.contains("EM") || name.contains("MONITOR"));
+    m_pressureChannel = addChannel("pressure", "number", "bar");
 }
 
 QBluetoothUuid BookooMonitor::serviceUuid() const
@@ -62,6 +50,6 @@ void BookooMonitor::parseData(const QByteArray &data)
     int rawPressure = (static_cast<uint8_t>(data[0]) << 8) | static_cast<uint8_t>(data[1]);
     m_pressure = rawPressure / 10.0;
 
-    updateChannel("pressure", m_pressure);
+    setChannelValue(m_pressureChannel, m_pressure);
     qCDebug(lcBookooMonitor) << "Pressure:" << m_pressure << "bar";
 }
@@ -19,9 +19,6 @@ public:
     QString sensorType() const override { return "BookooMonitor"; }
     double pressure() const { return m_pressure; }
 
-    // Detection
-    static bool isBookooMonitor(const QBluetoothDeviceInfo &device);
-
 protected:
     void setupService() override;
     QBluetoothUuid serviceUuid() const override;
@@ -30,6 +27,7 @@ protected:
 private:
     void parseData(const QByteArray &data);
 
+    int m_pressureChannel;
     double m_pressure = 0;
 };
 
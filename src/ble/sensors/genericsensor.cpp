@@ -0,0 +1,53 @@
+#include "genericsensor.h"
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(lcGenericSensor, "bridge.sensor.generic")
+
+GenericSensor::GenericSensor(std::shared_ptr<const SensorDescriptor> descriptor, QObject *parent)
+    : SensorDevice(parent)
+    , m_descriptor(std::move(descriptor))
+{
+    m_firstChannel = dataChannels().size();
+    for (const SensorDescriptor::Field &field : m_descriptor->fields) {
+        addChannel(field.key, "number", field.unit);
+    }
+}
+
+void GenericSensor::setupService()
+{
+    auto characteristic = m_service->characteristic(m_descriptor->characteristic);
+    if (!characteristic.isValid()) {
+        qCWarning(lcGenericSensor) << m_descriptor->type << "characteristic not found:"
+                                   << m_descriptor->characteristic.toString();
+        return;
+    }
+
+    auto descriptor = characteristic.descriptor(
+        QBluetoothUuid::DescriptorType::ClientCharacteristicConfiguration);
+    if (descriptor.isValid()) {
+        m_service->writeDescriptor(descriptor,
+            QLowEnergyCharacteristic::CCCDEnableNotification);
+        qCInfo(lcGenericSensor) << "Subscribed to" << m_descriptor->type << "notifications";
+    }
+}
+
+void GenericSensor::onCharacteristicChanged(const QLowEnergyCharacteristic &c, const QByteArray &value)
+{
+    handleNotification(c.uuid(), value);
+}
+
+void GenericSensor::handleNotification(const QBluetoothUuid &characteristic, const QByteArray &value)
+{
+    if (characteristic != m_descriptor->characteristic) return;
+
+    if (!m_descriptor->decode(value, m_decoded.data())) {
+        qCDebug(lcGenericSensor) << m_descriptor->type << "packet too short:" << value.size()
+                                 << "bytes, need" << m_descriptor->minLength;
+        return;
+    }
+
+    for (int i = 0; i < m_descriptor->fields.size(); ++i) {
+        setChannelValue(m_firstChannel + i, m_decoded[i]);
+    }
+    commitChannels();
+}
@@ -0,0 +1,40 @@
+#ifndef GENERICSENSOR_H
+#define GENERICSENSOR_H
+
+#include "ble/sensordevice.h"
+#include "sensordescriptor.h"
+
+#include <array>
+#include <memory>
+
+/**
+ * @brief Sensor driven entirely by a SensorDescriptor
+ *
+ * Subscribes to the described characteristic and maps each decoded field
+ * to a data channel of the same key.
+ */
+class GenericSensor : public SensorDevice
+{
+    Q_OBJECT
+
+public:
+    explicit GenericSensor(std::shared_ptr<const SensorDescriptor> descriptor, QObject *parent = nullptr);
+
+    QString sensorType() const override { return m_descriptor->type; }
+
+    // Decode one notification into the channels and emit dataUpdated.
+    // Notifications of other characteristics are ignored.
+    void handleNotification(const QBluetoothUuid &characteristic, const QByteArray &value);
+
+protected:
+    void setupService() override;
+    QBluetoothUuid serviceUuid() const override { return m_descriptor->service; }
+    void onCharacteristicChanged(const QLowEnergyCharacteristic &c, const QByteArray &value) override;
+
+private:
+    std::shared_ptr<const SensorDescriptor> m_descriptor;
+    int m_firstChannel = 0;     // Fields map to consecutive channels
+    std::array<double, SensorDescriptor::MAX_FIELDS> m_decoded{};
+};
+
+#endif // GENERICSENSOR_H
@@ -0,0 +1,253 @@
+#include "sensordescriptor.h"
+#include "ble/protocol/binarycodec.h"
+#include "ble/protocol/de1characteristics.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QLoggingCategory>
+#include <QSet>
+#include <cstring>
+
+Q_LOGGING_CATEGORY(lcSensorDescriptor, "bridge.sensor.descriptor")
+
+namespace {
+
+int formatSize(SensorDescriptor::Format format)
+{
+    switch (format) {
+    case SensorDescriptor::Format::U8:
+    case SensorDescriptor::Format::S8:
+        return 1;
+    case SensorDescriptor::Format::U16:
+    case SensorDescriptor::Format::S16:
+        return 2;
+    case SensorDescriptor::Format::U24:
+        return 3;
+    case SensorDescriptor::Format::U32:
+    case SensorDescriptor::Format::S32:
+    case SensorDescriptor::Format::F32:
+        return 4;
+    }
+    return 1;
+}
+
+bool parseFormat(const QString &name, SensorDescriptor::Format &out)
+{
+    static const struct { const char *name; SensorDescriptor::Format format; } FORMATS[] = {
+        { "u8", SensorDescriptor::Format::U8 },
+        { "s8", SensorDescriptor::Format::S8 },
+        { "u16", SensorDescriptor::Format::U16 },
+        { "s16", SensorDescriptor::Format::S16 },
+        { "u24", SensorDescriptor::Format::U24 },
+        { "u32", SensorDescriptor::Format::U32 },
+        { "s32", SensorDescriptor::Format::S32 },
+        { "f32", SensorDescriptor::Format::F32 },
+    };
+    for (const auto &entry : FORMATS) {
+        if (name.compare(QLatin1String(entry.name), Qt::CaseInsensitive) == 0) {
+            out = entry.format;
+            return true;
+        }
+    }
+    return false;
+}
+
+// "fff0" or a full UUID
+QBluetoothUuid parseUuid(const QString &text)
+{
+    if (text.size() == 4) {
+        bool ok = false;
+        quint16 shortUuid = text.toUShort(&ok, 16);
+        return ok ? QBluetoothUuid(shortUuid) : QBluetoothUuid();
+    }
+    return QBluetoothUuid(text);
+}
+
+// Services the built-in devices advertise, plus generic serial services many
+// other devices reuse. Advertising one of these says nothing about the model.
+bool isSharedService(const QBluetoothUuid &uuid)
+{
+    static const QBluetoothUuid SHARED[] = {
+        DE1::SERVICE_UUID,
+        Scale::Decent::SERVICE,             // FFF0, also Varia and generic scales
+        Scale::AcaiaIPS::SERVICE,
+        Scale::Acaia::SERVICE,              // ISSC transparent UART
+        Scale::Felicita::SERVICE,           // FFE0, also the Bookoo Monitor
+        Scale::Skale::SERVICE,
+        Scale::Bookoo::SERVICE,
+        Scale::DiFluid::SERVICE,
+        Scale::HiroiaJimmy::SERVICE,
+        Scale::AtomheartEclair::SERVICE,
+        QBluetoothUuid(QString("6E400001-B5A3-F393-E0A9-E50E24DCCA9E")),   // Nordic UART
+    };
+    for (const QBluetoothUuid &shared : SHARED) {
+        if (uuid == shared) return true;
+    }
+    return false;
+}
+
+uint32_t readUnsigned(const uint8_t *p, int size, bool bigEndian)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < size; ++i) {
+        value = (value << 8) | p[bigEndian ? i : size - 1 - i];
+    }
+    return value;
+}
+
+double readRaw(const uint8_t *p, SensorDescriptor::Format format, bool bigEndian)
+{
+    switch (format) {
+    case SensorDescriptor::Format::U8:
+        return p[0];
+    case SensorDescriptor::Format::S8:
+        return static_cast<int8_t>(p[0]);
+    case SensorDescriptor::Format::U16:
+        return readUnsigned(p, 2, bigEndian);
+    case SensorDescriptor::Format::S16:
+        return static_cast<int16_t>(readUnsigned(p, 2, bigEndian));
+    case SensorDescriptor::Format::U24:
+        return readUnsigned(p, 3, bigEndian);
+    case SensorDescriptor::Format::U32:
+        return readUnsigned(p, 4, bigEndian);
+    case SensorDescriptor::Format::S32:
+        return static_cast<int32_t>(readUnsigned(p, 4, bigEndian));
+    case SensorDescriptor::Format::F32: {
+        uint32_t bits = readUnsigned(p, 4, bigEndian);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    }
+    return 0;
+}
+
+} // namespace
+
+bool SensorDescriptor::fromJson(const QJsonObject &obj, SensorDescriptor &out, QString *errorMessage)
+{
+    auto fail = [errorMessage](const QString &message) {
+        if (errorMessage) *errorMessage = message;
+        return false;
+    };
+
+    SensorDescriptor descriptor;
+    descriptor.type = obj["type"].toString();
+    if (descriptor.type.isEmpty()) {
+        return fail("missing \"type\"");
+    }
+
+    for (const QJsonValue &name : obj["names"].toArray()) {
+        if (!name.toString().isEmpty()) {
+            descriptor.namePrefixes.append(name.toString().toLower());
+        }
+    }
+
+    descriptor.service = parseUuid(obj["service"].toString());
+    descriptor.characteristic = parseUuid(obj["characteristic"].toString());
+    if (descriptor.service.isNull() || descriptor.characteristic.isNull()) {
+        return fail("\"service\" and \"characteristic\" must be UUIDs");
+    }
+    if (descriptor.namePrefixes.isEmpty() && isSharedService(descriptor.service)) {
+        return fail(QString("service %1 is shared with other devices, \"names\" is required")
+                        .arg(descriptor.service.toString(QUuid::WithoutBraces)));
+    }
+
+    const QJsonArray fields = obj["fields"].toArray();
+    if (fields.isEmpty() || fields.size() > MAX_FIELDS) {
+        return fail(QString("needs 1 to %1 fields").arg(MAX_FIELDS));
+    }
+
+    QSet<QString> keys;
+    for (const QJsonValue &value : fields) {
+        const QJsonObject fieldObj = value.toObject();
+        Field field;
+        field.key = fieldObj["key"].toString();
+        field.unit = fieldObj["unit"].toString();
+        field.offset = fieldObj["offset"].toInt(-1);
+        field.scale = fieldObj["scale"].toDouble(1);
+        field.bias = fieldObj["bias"].toDouble(0);
+
+        if (field.key.isEmpty() || keys.contains(field.key)) {
+            return fail("every field needs a unique \"key\"");
+        }
+        if (field.offset < 0) {
+            return fail(QString("field %1: missing \"offset\"").arg(field.key));
+        }
+        if (!parseFormat(fieldObj["format"].toString(), field.format)) {
+            return fail(QString("field %1: unknown format \"%2\"")
+                            .arg(field.key, fieldObj["format"].toString()));
+        }
+        const QString endian = fieldObj["endian"].toString("big");
+        if (endian != "big" && endian != "little") {
+            return fail(QString("field %1: \"endian\" must be big or little").arg(field.key));
+        }
+        field.bigEndian = endian == "big";
+
+        keys.insert(field.key);
+        descriptor.minLength = qMax(descriptor.minLength, field.offset + formatSize(field.format));
+        descriptor.fields.append(field);
+    }
+
+    out = descriptor;
+    return true;
+}
+
+QList<SensorDescriptor> SensorDescriptor::loadFile(const QString &path)
+{
+    QList<SensorDescriptor> descriptors;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCDebug(lcSensorDescriptor) << "No sensor descriptions at" << path;
+        return descriptors;
+    }
+
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        qCWarning(lcSensorDescriptor) << "Failed to parse" << path << ":" << parseError.errorString();
+        return descriptors;
+    }
+
+    const QJsonArray entries = doc.isArray() ? doc.array() : doc.object()["sensors"].toArray();
+    for (const QJsonValue &entry : entries) {
+        SensorDescriptor descriptor;
+        QString error;
+        if (!fromJson(entry.toObject(), descriptor, &error)) {
+            qCWarning(lcSensorDescriptor) << "Skipping sensor description in" << path << ":" << error;
+            continue;
+        }
+        descriptors.append(descriptor);
+    }
+
+    qCInfo(lcSensorDescriptor) << "Loaded" << descriptors.size() << "sensor descriptions from" << path;
+    return descriptors;
+}
+
+bool SensorDescriptor::matches(const QBluetoothDeviceInfo &device) const
+{
+    const QString name = device.name().toLower();
+    for (const QString &prefix : namePrefixes) {
+        if (name.startsWith(prefix)) {
+            return true;
+        }
+    }
+    // A shared service alone would claim scales and other sensors
+    return !isSharedService(service) && device.serviceUuids().contains(service);
+}
+
+bool SensorDescriptor::decode(const QByteArray &packet, double *values) const
+{
+    if (packet.size() < minLength) {
+        return false;
+    }
+
+    const uint8_t *data = BinaryCodec::bytes(packet);
+    for (int i = 0; i < fields.size(); ++i) {
+        const Field &field = fields[i];
+        values[i] = readRaw(data + field.offset, field.format, field.bigEndian) * field.scale + field.bias;
+    }
+    return true;
+}
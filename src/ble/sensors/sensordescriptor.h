@@ -0,0 +1,77 @@
+#ifndef SENSORDESCRIPTOR_H
+#define SENSORDESCRIPTOR_H
+
+#include <QBluetoothDeviceInfo>
+#include <QBluetoothUuid>
+#include <QByteArray>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief Declarative description of a notify-only BLE sensor
+ *
+ * Lets a sensor that sends fixed-layout notifications be supported without
+ * code. Descriptions are JSON:
+ *
+ *   {
+ *     "type": "ThermoProbe",
+ *     "names": ["thermoprobe", "tp-"],
+ *     "service": "fff0",
+ *     "characteristic": "fff1",
+ *     "fields": [
+ *       { "key": "temperature", "unit": "celsius", "offset": 2,
+ *         "format": "s16", "endian": "little", "scale": 0.1 }
+ *     ]
+ *   }
+ *
+ * UUIDs are 16-bit short forms or full UUIDs. Formats are u8, s8, u16, s16,
+ * u24, u32, s32 and f32; endianness defaults to big, scale to 1 and bias to
+ * 0, and a value is raw * scale + bias. A device matches on a
+ * case-insensitive name prefix or its advertised service. Services other
+ * devices also use (FFF0, FFE0, the scales' and the DE1's) never match on
+ * their own, and a description on one of them must list "names".
+ *
+ * fromJson() validates everything up front, so decode() is a plain loop
+ * over the fields that cannot fail except on a short packet and allocates
+ * nothing.
+ */
+class SensorDescriptor
+{
+public:
+    static constexpr int MAX_FIELDS = 16;
+
+    enum class Format { U8, S8, U16, S16, U24, U32, S32, F32 };
+
+    struct Field {
+        QString key;
+        QString unit;
+        Format format = Format::U8;
+        int offset = 0;
+        bool bigEndian = true;
+        double scale = 1;
+        double bias = 0;
+    };
+
+    QString type;
+    QStringList namePrefixes;   // Lowercase
+    QBluetoothUuid service;
+    QBluetoothUuid characteristic;
+    QList<Field> fields;
+    int minLength = 0;          // Bytes needed to decode every field
+
+    // False with a message if the description is incomplete or inconsistent
+    static bool fromJson(const QJsonObject &obj, SensorDescriptor &out, QString *errorMessage = nullptr);
+    // A JSON array of descriptions, or an object with a "sensors" array.
+    // Invalid entries are skipped with a warning.
+    static QList<SensorDescriptor> loadFile(const QString &path);
+
+    bool matches(const QBluetoothDeviceInfo &device) const;
+
+    // Writes fields.size() values. False (values untouched) if the packet
+    // is shorter than minLength.
+    bool decode(const QByteArray &packet, double *values) const;
+};
+
+#endif // SENSORDESCRIPTOR_H
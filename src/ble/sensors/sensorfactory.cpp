@@ -1,36 +1,95 @@
 #include "sensorfactory.h"
 #include "bookoomonitor.h"
+#include "genericsensor.h"
+#include "sensordescriptor.h"
+#include "ble/deviceclassifier.h"
 #include "ble/sensordevice.h"
 
+#include <QList>
 #include <QLoggingCategory>
+#include <QStandardPaths>
 
 Q_LOGGING_CATEGORY(lcSensorFactory, "bridge.sensor.factory")
 
+namespace {
+
+// Shared so a running sensor keeps its description across a reload
+QList<std::shared_ptr<const SensorDescriptor>> &describedSensors()
+{
+    static QList<std::shared_ptr<const SensorDescriptor>> s_descriptors;
+    return s_descriptors;
+}
+
+} // namespace
+
 bool SensorFactory::isSensor(const QBluetoothDeviceInfo &device)
 {
-    if (BookooMonitor::isBookooMonitor(device)) {
-        return true;
-    }
-    // Add more sensor types here as they are implemented
-    return false;
+    return DeviceClassifier::category(DeviceClassifier::classify(device)) == DeviceCategory::Sensor
+        || descriptor(device) != nullptr;
 }
 
 QString SensorFactory::sensorType(const QBluetoothDeviceInfo &device)
 {
-    if (BookooMonitor::isBookooMonitor(device)) {
-        return "BookooMonitor";
+    DeviceType type = DeviceClassifier::classify(device);
+    if (DeviceClassifier::category(type) == DeviceCategory::Sensor) {
+        return DeviceClassifier::apiName(type);
+    }
+    if (auto described = descriptor(device)) {
+        return described->type;
     }
     return QString();
 }
 
 SensorDevice* SensorFactory::createSensor(const QBluetoothDeviceInfo &device, QObject *parent)
 {
-    if (BookooMonitor::isBookooMonitor(device)) {
+    switch (DeviceClassifier::classify(device)) {
+    case DeviceType::BookooMonitor:
         qCInfo(lcSensorFactory) << "Creating Bookoo Monitor sensor for" << device.name();
         return new BookooMonitor(parent);
+    default:
+        break;
+    }
+
+    if (auto described = descriptor(device)) {
+        qCInfo(lcSensorFactory) << "Creating" << described->type << "sensor for" << device.name();
+        return new GenericSensor(described, parent);
     }
-    // Add more sensor types here
 
     qCWarning(lcSensorFactory) << "Unknown sensor type:" << device.name();
     return nullptr;
 }
+
+int SensorFactory::loadDescriptors(const QString &path)
+{
+    auto &described = describedSensors();
+    described.clear();
+    for (const SensorDescriptor &descriptor : SensorDescriptor::loadFile(path)) {
+        described.append(std::make_shared<const SensorDescriptor>(descriptor));
+    }
+    return described.size();
+}
+
+QString SensorFactory::descriptorsPath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/sensors.json";
+}
+
+std::shared_ptr<const SensorDescriptor> SensorFactory::descriptor(const QBluetoothDeviceInfo &device)
+{
+    for (const auto &described : std::as_const(describedSensors())) {
+        if (described->matches(device)) {
+            return described;
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<const SensorDescriptor> SensorFactory::descriptor(const QString &type)
+{
+    for (const auto &described : std::as_const(describedSensors())) {
+        if (described->type.compare(type, Qt::CaseInsensitive) == 0) {
+            return described;
+        }
+    }
+    return nullptr;
+}
@@ -2,11 +2,16 @@
 #define SENSORFACTORY_H
 
 #include <QBluetoothDeviceInfo>
+#include <memory>
 
 class SensorDevice;
+class SensorDescriptor;
 
 /**
  * @brief Factory for creating sensor device instances
+ *
+ * Built-in sensors have their own driver class. Any other sensor can be
+ * described in JSON (see SensorDescriptor) and is driven by GenericSensor.
  */
 class SensorFactory
 {
@@ -25,6 +30,22 @@ public:
      * Create a sensor device instance for the given BLE device
      */
     static SensorDevice* createSensor(const QBluetoothDeviceInfo &device, QObject *parent = nullptr);
+
+    /**
+     * Replace the described sensors with those in a JSON file; returns how many loaded
+     */
+    static int loadDescriptors(const QString &path);
+
+    /**
+     * sensors.json in the app data directory
+     */
+    static QString descriptorsPath();
+
+    /**
+     * Described sensor matching a device or type name, nullptr if none
+     */
+    static std::shared_ptr<const SensorDescriptor> descriptor(const QBluetoothDeviceInfo &device);
+    static std::shared_ptr<const SensorDescriptor> descriptor(const QString &type);
 };
 
 #endif // SENSORFACTORY_H
@@ -36,6 +36,8 @@ public:
     void readCharacteristic(const QBluetoothUuid& serviceUuid,
                             const QBluetoothUuid& characteristicUuid) override;
 
+    void setNotificationsPaused(bool paused) override;
+
     bool isConnected() const override;
 
 private:
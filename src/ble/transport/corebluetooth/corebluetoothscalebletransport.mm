@@ -95,12 +95,17 @@ struct CoreBluetoothScaleBleTransport::Impl {
     QHash<QString, CBCharacteristic*> chars;
     QSet<QBluetoothUuid> charsDiscoveredForService;  // Track which services have had chars discovered
 
+    // Notifications requested by the driver (uuidKey), toggled by setNotificationsPaused()
+    QSet<QString> notifying;
+    bool paused = false;
+
     void log(const QString& m) { if (q && isValid) q->log(m); }
 
     void clearCaches() {
         services.clear();
         chars.clear();
         charsDiscoveredForService.clear();
+        notifying.clear();
         servicesDiscovered = false;
     }
 
@@ -396,6 +401,9 @@ didUpdateNotificationStateForCharacteristic:(CBCharacteristic *)characteristic
                .arg(cu.toString())
                .arg(isNotifying ? "true" : "false"));
 
+        // Switched off by setNotificationsPaused(), not an enable completing
+        if (!isNotifying) return;
+
         emit d->q->notificationsEnabled(cu);
     }, Qt::QueuedConnection);
 }
@@ -422,6 +430,7 @@ didUpdateValueForCharacteristic:(CBCharacteristic *)characteristic
 
     QMetaObject::invokeMethod(d->q, [d, uuidStr, bytes]{
         if (!d->isValid) return;  // Transport being destroyed
+        if (d->paused) return;    // Queued before notifications were switched off
         QBluetoothUuid cu = uuidFromString(uuidStr);
         // Don't log every notification - too verbose at high rates (10/sec for Bookoo)
         emit d->q->characteristicChanged(cu, bytes);
@@ -663,6 +672,12 @@ void CoreBluetoothScaleBleTransport::enableNotifications(const QBluetoothUuid& s
         return;
     }
 
+    d->notifying.insert(uuidKey(serviceUuid, characteristicUuid));
+    if (d->paused) {
+        log(QString("Notifications paused, enabling %1 on resume").arg(characteristicUuid.toString()));
+        return;
+    }
+
     log(QString("Enabling notifications for %1").arg(characteristicUuid.toString()));
     // On iOS, Qt main thread = dispatch main queue, so just call directly
     [d->periph setNotifyValue:YES forCharacteristic:ch];
@@ -672,6 +687,27 @@ void CoreBluetoothScaleBleTransport::enableNotifications(const QBluetoothUuid& s
 #endif
 }
 
+void CoreBluetoothScaleBleTransport::setNotificationsPaused(bool paused) {
+#ifdef Q_OS_IOS
+    if (!d || d->paused == paused) return;
+    d->paused = paused;
+
+    log(QString("%1 notifications for %2 characteristic(s)")
+        .arg(paused ? "Pausing" : "Resuming")
+        .arg(d->notifying.size()));
+
+    if (!d->periph) return;
+    for (const QString& key : d->notifying) {
+        CBCharacteristic* ch = d->chars.value(key, nullptr);
+        if (ch) {
+            [d->periph setNotifyValue:(paused ? NO : YES) forCharacteristic:ch];
+        }
+    }
+#else
+    Q_UNUSED(paused);
+#endif
+}
+
 void CoreBluetoothScaleBleTransport::writeCharacteristic(const QBluetoothUuid& serviceUuid,
                                                         const QBluetoothUuid& characteristicUuid,
                                                         const QByteArray& data,
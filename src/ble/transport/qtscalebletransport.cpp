@@ -1,4 +1,5 @@
 #include "qtscalebletransport.h"
+#include "../connectionmanager.h"
 #include <QDebug>
 #include <QTimer>
 
@@ -112,6 +113,7 @@ void QtScaleBleTransport::disconnectFromDevice() {
     }
     m_services.clear();
     m_pendingNotificationCharacteristic = QBluetoothUuid();
+    m_notifying.clear();
 
     if (m_controller) {
         m_controller->disconnect();
@@ -178,15 +180,49 @@ void QtScaleBleTransport::enableNotifications(const QBluetoothUuid& serviceUuid,
     QLowEnergyDescriptor cccd = characteristic.descriptor(
         QBluetoothUuid::DescriptorType::ClientCharacteristicConfiguration);
 
-    if (cccd.isValid()) {
-        QT_TRANSPORT_LOG("Writing CCCD to enable notifications");
-        // Track which characteristic we're enabling notifications for
-        m_pendingNotificationCharacteristic = characteristicUuid;
-        service->writeDescriptor(cccd, QByteArray::fromHex("0100"));
-    } else {
+    if (!cccd.isValid()) {
         QT_TRANSPORT_LOG("ERROR: CCCD descriptor not found");
         emit error("CCCD descriptor not found");
+        return;
+    }
+
+    m_notifying.insert(characteristicUuid, serviceUuid);
+    if (m_paused) {
+        QT_TRANSPORT_LOG("Notifications paused, enabling on resume");
+        return;
     }
+
+    QT_TRANSPORT_LOG("Writing CCCD to enable notifications");
+    // Track which characteristic we're enabling notifications for
+    m_pendingNotificationCharacteristic = characteristicUuid;
+    service->writeDescriptor(cccd, QByteArray::fromHex("0100"));
+}
+
+void QtScaleBleTransport::setNotificationsPaused(bool paused) {
+    if (m_paused == paused) return;
+    m_paused = paused;
+
+    QT_TRANSPORT_LOG(QString("%1 notifications for %2 characteristic(s)")
+        .arg(paused ? "Pausing" : "Resuming")
+        .arg(m_notifying.size()));
+
+    for (auto it = m_notifying.cbegin(); it != m_notifying.cend(); ++it) {
+        QLowEnergyService* service = m_services.value(it.value());
+        if (!service) continue;
+        writeCccd(service, service->characteristic(it.key()), !paused);
+    }
+}
+
+bool QtScaleBleTransport::writeCccd(QLowEnergyService* service,
+                                    const QLowEnergyCharacteristic& characteristic, bool enable) {
+    if (!characteristic.isValid()) return false;
+
+    QLowEnergyDescriptor cccd = characteristic.descriptor(
+        QBluetoothUuid::DescriptorType::ClientCharacteristicConfiguration);
+    if (!cccd.isValid()) return false;
+
+    service->writeDescriptor(cccd, QByteArray::fromHex(enable ? "0100" : "0000"));
+    return true;
 }
 
 void QtScaleBleTransport::writeCharacteristic(const QBluetoothUuid& serviceUuid,
@@ -236,6 +272,7 @@ bool QtScaleBleTransport::isConnected() const {
 
 void QtScaleBleTransport::onControllerConnected() {
     QT_TRANSPORT_LOG("Controller connected!");
+    ConnectionManager::requestLowLatency(m_controller);
     m_connected = true;
     emit connected();
 }
@@ -329,8 +366,11 @@ void QtScaleBleTransport::onServiceStateChanged(QLowEnergyService::ServiceState
                         .arg(cccd.isValid()));
 
                     if (cccd.isValid()) {
-                        QT_TRANSPORT_LOG(QString("Auto-enabling notify for %1").arg(c.uuid().toString()));
-                        service->writeDescriptor(cccd, QByteArray::fromHex("0100"));
+                        m_notifying.insert(c.uuid(), serviceUuid);
+                        if (!m_paused) {
+                            QT_TRANSPORT_LOG(QString("Auto-enabling notify for %1").arg(c.uuid().toString()));
+                            service->writeDescriptor(cccd, QByteArray::fromHex("0100"));
+                        }
                     }
                 }
             }
@@ -342,6 +382,8 @@ void QtScaleBleTransport::onServiceStateChanged(QLowEnergyService::ServiceState
 
 void QtScaleBleTransport::onCharacteristicChanged(const QLowEnergyCharacteristic& c,
                                                    const QByteArray& value) {
+    // Stragglers queued before the CCCD write took effect
+    if (m_paused) return;
     // Don't log every notification - too spammy (weight updates come constantly)
     emit characteristicChanged(c.uuid(), value);
 }
@@ -361,7 +403,6 @@ void QtScaleBleTransport::onCharacteristicWritten(const QLowEnergyCharacteristic
 }
 
 void QtScaleBleTransport::onDescriptorWritten(const QLowEnergyDescriptor& d, const QByteArray& value) {
-    Q_UNUSED(value);
     // Check if this is a CCCD descriptor (notification enable)
     if (d.type() == QBluetoothUuid::DescriptorType::ClientCharacteristicConfiguration) {
         if (!m_pendingNotificationCharacteristic.isNull()) {
@@ -369,7 +410,8 @@ void QtScaleBleTransport::onDescriptorWritten(const QLowEnergyDescriptor& d, con
             emit notificationsEnabled(m_pendingNotificationCharacteristic);
             m_pendingNotificationCharacteristic = QBluetoothUuid();  // Clear
         } else {
-            QT_TRANSPORT_LOG("Descriptor written but no pending characteristic tracked");
+            // Auto-enable at discovery, or a pause/resume toggle
+            QT_TRANSPORT_LOG(QString("CCCD written: %1").arg(QString(value.toHex())));
         }
     }
 }
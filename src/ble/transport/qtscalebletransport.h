@@ -32,6 +32,7 @@ public:
                             WriteType writeType = WriteType::WithResponse) override;
     void readCharacteristic(const QBluetoothUuid& serviceUuid,
                            const QBluetoothUuid& characteristicUuid) override;
+    void setNotificationsPaused(bool paused) override;
     bool isConnected() const override;
 
 private slots:
@@ -51,10 +52,13 @@ private:
     void log(const QString& message);
     QLowEnergyService* getOrCreateService(const QBluetoothUuid& serviceUuid);
     void connectServiceSignals(QLowEnergyService* service);
+    bool writeCccd(QLowEnergyService* service, const QLowEnergyCharacteristic& characteristic, bool enable);
 
     QLowEnergyController* m_controller = nullptr;
     QMap<QBluetoothUuid, QLowEnergyService*> m_services;
     QBluetoothUuid m_pendingNotificationCharacteristic;  // Track last characteristic we're enabling notifications for
+    QMap<QBluetoothUuid, QBluetoothUuid> m_notifying;  // Characteristic -> service, for pause/resume
+    bool m_paused = false;
     QString m_deviceAddress;
     QString m_deviceName;
     QString m_deviceId;  // UUID on iOS, address on other platforms - for duplicate detection
@@ -0,0 +1,177 @@
+#include "replayscalebletransport.h"
+#include <QDebug>
+
+ReplayScaleBleTransport::ReplayScaleBleTransport(const ScaleCapture& capture, double speed, QObject* parent)
+    : ScaleBleTransport(parent)
+    , m_capture(capture)
+    , m_speed(speed)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &ReplayScaleBleTransport::deliverDue);
+}
+
+ReplayScaleBleTransport::~ReplayScaleBleTransport() {
+    m_timer.stop();
+}
+
+void ReplayScaleBleTransport::log(const QString& message) {
+    QString msg = QString("[BLE ReplayTransport] ") + message;
+    qDebug().noquote() << msg;
+    emit logMessage(msg);
+}
+
+void ReplayScaleBleTransport::connectToDevice(const QString& address, const QString& name) {
+    log(QString("Replaying %1 notifications recorded from %2 (%3) at %4x")
+            .arg(m_capture.notifications.size())
+            .arg(m_capture.deviceName, m_capture.scaleType)
+            .arg(m_speed > 0 ? QString::number(m_speed) : QString("max")));
+    Q_UNUSED(address);
+    Q_UNUSED(name);
+
+    QTimer::singleShot(0, this, [this]() {
+        m_connected = true;
+        emit connected();
+    });
+}
+
+void ReplayScaleBleTransport::disconnectFromDevice() {
+    m_timer.stop();
+    if (m_replaying) {
+        finishReplay();
+    }
+    if (m_connected) {
+        m_connected = false;
+        emit disconnected();
+    }
+}
+
+void ReplayScaleBleTransport::discoverServices() {
+    QTimer::singleShot(0, this, [this]() {
+        for (const QBluetoothUuid& service : m_capture.services) {
+            emit serviceDiscovered(service);
+        }
+        emit servicesDiscoveryFinished();
+    });
+}
+
+void ReplayScaleBleTransport::discoverCharacteristics(const QBluetoothUuid& serviceUuid) {
+    QTimer::singleShot(0, this, [this, serviceUuid]() {
+        for (const ScaleCapture::Characteristic& c : m_capture.characteristics) {
+            if (c.service == serviceUuid) {
+                emit characteristicDiscovered(c.service, c.uuid, c.properties);
+            }
+        }
+        emit characteristicsDiscoveryFinished(serviceUuid);
+    });
+}
+
+void ReplayScaleBleTransport::enableNotifications(const QBluetoothUuid& serviceUuid,
+                                                  const QBluetoothUuid& characteristicUuid) {
+    Q_UNUSED(serviceUuid);
+    m_enabled.insert(characteristicUuid);
+    QTimer::singleShot(0, this, [this, characteristicUuid]() {
+        emit notificationsEnabled(characteristicUuid);
+    });
+
+    if (!m_replaying && m_next < m_capture.notifications.size()) {
+        m_replaying = true;
+        m_clock.start();
+        scheduleNext();
+    }
+}
+
+void ReplayScaleBleTransport::writeCharacteristic(const QBluetoothUuid& serviceUuid,
+                                                  const QBluetoothUuid& characteristicUuid,
+                                                  const QByteArray& data,
+                                                  WriteType writeType) {
+    Q_UNUSED(serviceUuid);
+    Q_UNUSED(data);
+    if (writeType == WriteType::WithResponse) {
+        QTimer::singleShot(0, this, [this, characteristicUuid]() {
+            emit characteristicWritten(characteristicUuid);
+        });
+    }
+}
+
+void ReplayScaleBleTransport::readCharacteristic(const QBluetoothUuid& serviceUuid,
+                                                 const QBluetoothUuid& characteristicUuid) {
+    Q_UNUSED(serviceUuid);
+    log(QString("Read of %1 ignored - captures hold notifications only").arg(characteristicUuid.toString()));
+}
+
+void ReplayScaleBleTransport::setNotificationsPaused(bool paused) {
+    if (m_paused == paused) return;
+    m_paused = paused;
+    log(paused ? "Notifications paused" : "Notifications resumed");
+}
+
+bool ReplayScaleBleTransport::isConnected() const {
+    return m_connected;
+}
+
+void ReplayScaleBleTransport::deliverDue() {
+    const QList<ScaleCapture::Notification>& notifications = m_capture.notifications;
+    const qint64 startMs = notifications.first().timeMs;
+    const qint64 elapsedNs = m_clock.nsecsElapsed();
+
+    int batch = 0;
+    while (m_next < notifications.size()) {
+        const ScaleCapture::Notification& n = notifications[m_next];
+        if (m_speed > 0) {
+            if ((n.timeMs - startMs) * 1000000.0 / m_speed > elapsedNs) break;
+        } else if (batch == UNTHROTTLED_BATCH) {
+            break;
+        }
+        m_next++;
+        batch++;
+
+        if (m_paused || !m_enabled.contains(n.characteristic)) {
+            m_skipped++;
+            continue;
+        }
+
+        QElapsedTimer dispatch;
+        dispatch.start();
+        emit characteristicChanged(n.characteristic, n.value);
+        qint64 ns = dispatch.nsecsElapsed();
+
+        m_delivered++;
+        m_dispatchTotalNs += ns;
+        m_dispatchMaxNs = qMax(m_dispatchMaxNs, ns);
+
+        // The driver may have disconnected us from inside the handler
+        if (!m_replaying) return;
+    }
+
+    if (m_next >= notifications.size()) {
+        finishReplay();
+    } else {
+        scheduleNext();
+    }
+}
+
+void ReplayScaleBleTransport::scheduleNext() {
+    if (m_speed <= 0) {
+        m_timer.start(0);
+        return;
+    }
+    const qint64 offsetMs = m_capture.notifications[m_next].timeMs - m_capture.notifications.first().timeMs;
+    const qint64 dueMs = qint64(offsetMs / m_speed);
+    m_timer.start(int(qMax<qint64>(0, dueMs - m_clock.elapsed())));
+}
+
+void ReplayScaleBleTransport::finishReplay() {
+    m_replaying = false;
+
+    const double wallMs = m_clock.nsecsElapsed() / 1e6;
+    const double dispatchMs = m_dispatchTotalNs / 1e6;
+    log(QString("Replay finished: %1 notifications (%2 skipped) in %3 ms, "
+                "%4/s dispatch throughput, mean %5 us, max %6 us per notification")
+            .arg(m_delivered)
+            .arg(m_skipped)
+            .arg(wallMs, 0, 'f', 1)
+            .arg(dispatchMs > 0 ? m_delivered / (dispatchMs / 1000.0) : 0.0, 0, 'f', 0)
+            .arg(m_delivered > 0 ? m_dispatchTotalNs / 1000.0 / m_delivered : 0.0, 0, 'f', 1)
+            .arg(m_dispatchMaxNs / 1000.0, 0, 'f', 1));
+    emit replayFinished();
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "scalebletransport.h"
+#include "scalecapture.h"
+#include <QSet>
+#include <QTimer>
+
+/**
+ * Transport that plays a recorded ScaleCapture back to a scale driver.
+ *
+ * Connection, service and characteristic discovery are answered from the
+ * capture; writes are acknowledged and dropped. Once the driver enables
+ * notifications, the recorded notifications for enabled characteristics are
+ * delivered with their original spacing divided by the speed factor
+ * (1.0 = real time, 0 = as fast as the event loop allows).
+ *
+ * Each notification is dispatched with a direct signal, so the time spent in
+ * the emit is the full path through the driver's parser, setWeight() and
+ * every synchronous listener. A summary is logged when the replay finishes.
+ */
+class ReplayScaleBleTransport : public ScaleBleTransport {
+    Q_OBJECT
+
+public:
+    explicit ReplayScaleBleTransport(const ScaleCapture& capture, double speed = 1.0, QObject* parent = nullptr);
+    ~ReplayScaleBleTransport() override;
+
+    using ScaleBleTransport::connectToDevice;
+    void connectToDevice(const QString& address, const QString& name) override;
+    void disconnectFromDevice() override;
+    void discoverServices() override;
+    void discoverCharacteristics(const QBluetoothUuid& serviceUuid) override;
+    void enableNotifications(const QBluetoothUuid& serviceUuid,
+                            const QBluetoothUuid& characteristicUuid) override;
+    void writeCharacteristic(const QBluetoothUuid& serviceUuid,
+                            const QBluetoothUuid& characteristicUuid,
+                            const QByteArray& data,
+                            WriteType writeType = WriteType::WithResponse) override;
+    void readCharacteristic(const QBluetoothUuid& serviceUuid,
+                           const QBluetoothUuid& characteristicUuid) override;
+    void setNotificationsPaused(bool paused) override;
+    bool isConnected() const override;
+
+signals:
+    void replayFinished();
+
+private:
+    void deliverDue();
+    void scheduleNext();
+    void finishReplay();
+    void log(const QString& message);
+
+    // Notifications delivered per event loop pass when running unthrottled,
+    // so driver timers (init commands, heartbeats) still get to run
+    static constexpr int UNTHROTTLED_BATCH = 64;
+
+    ScaleCapture m_capture;
+    double m_speed;
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    QSet<QBluetoothUuid> m_enabled;
+    int m_next = 0;
+    bool m_connected = false;
+    bool m_replaying = false;
+    bool m_paused = false;  // Paused notifications still advance the clock, like a live scale
+
+    // Statistics
+    int m_delivered = 0;
+    int m_skipped = 0;
+    qint64 m_dispatchTotalNs = 0;
+    qint64 m_dispatchMaxNs = 0;
+};
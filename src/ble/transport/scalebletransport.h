@@ -14,6 +14,7 @@
  * - QtScaleBleTransport: Uses Qt's QLowEnergyController (desktop, works well)
  * - AndroidScaleBleTransport: Uses native Android BLE via JNI (fixes CCCD issues)
  * - IosScaleBleTransport: Uses CoreBluetooth (future)
+ * - ReplayScaleBleTransport: Plays back a recorded ScaleCapture (no hardware)
  *
  * Scale classes use this interface for all BLE operations.
  * Protocol parsing remains in each scale class.
@@ -95,6 +96,14 @@ public:
     virtual void readCharacteristic(const QBluetoothUuid& serviceUuid,
                                     const QBluetoothUuid& characteristicUuid) = 0;
 
+    /**
+     * Stop or restart the notifications enabled so far without tearing down
+     * the connection, so an idle scale stops streaming weight nobody reads.
+     * Notifications enabled while paused start on resume.
+     * Default: no-op (notifications keep flowing).
+     */
+    virtual void setNotificationsPaused(bool paused) { Q_UNUSED(paused); }
+
     /**
      * Check if currently connected.
      */
@@ -0,0 +1,131 @@
+#include "scalecapture.h"
+#include <QDebug>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace {
+    const QString CAPTURE_FORMAT = QStringLiteral("decentbridge-scale");
+    constexpr int CAPTURE_VERSION = 1;
+
+    QString uuidText(const QBluetoothUuid& uuid) {
+        return uuid.toString(QUuid::WithoutBraces);
+    }
+
+    QBluetoothUuid uuidFromText(const QJsonValue& value) {
+        return QBluetoothUuid(QUuid(value.toString()));
+    }
+}
+
+bool ScaleCapture::load(const QString& path, ScaleCapture& capture, QString* errorMessage) {
+    auto fail = [errorMessage](const QString& message) {
+        if (errorMessage) *errorMessage = message;
+        return false;
+    };
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return fail(QString("Cannot open %1").arg(path));
+    }
+
+    capture = ScaleCapture();
+    int lineNumber = 0;
+    while (!file.atEnd()) {
+        QByteArray line = file.readLine().trimmed();
+        lineNumber++;
+        if (line.isEmpty()) continue;
+
+        QJsonParseError parseError;
+        QJsonObject event = QJsonDocument::fromJson(line, &parseError).object();
+        if (parseError.error != QJsonParseError::NoError) {
+            return fail(QString("Line %1: %2").arg(lineNumber).arg(parseError.errorString()));
+        }
+
+        if (lineNumber == 1) {
+            if (event["capture"].toString() != CAPTURE_FORMAT
+                || event["version"].toInt() != CAPTURE_VERSION) {
+                return fail("Not a scale capture file");
+            }
+            capture.scaleType = event["type"].toString();
+            capture.deviceName = event["name"].toString();
+            continue;
+        }
+
+        qint64 timeMs = event["t"].toInteger();
+        if (event.contains("notify")) {
+            capture.notifications.append({timeMs,
+                                          uuidFromText(event["notify"]),
+                                          QByteArray::fromHex(event["data"].toString().toLatin1())});
+        } else if (event.contains("characteristic")) {
+            capture.characteristics.append({uuidFromText(event["service"]),
+                                            uuidFromText(event["characteristic"]),
+                                            event["properties"].toInt()});
+        } else if (event.contains("service")) {
+            capture.services.append(uuidFromText(event["service"]));
+        }
+    }
+
+    if (lineNumber == 0) {
+        return fail("Empty capture file");
+    }
+    return true;
+}
+
+CaptureWriter::CaptureWriter(const QString& path, const QString& format,
+                             const QString& deviceType, const QString& deviceName)
+    : m_file(path)
+    , m_header{{"capture", format},
+               {"version", CAPTURE_VERSION},
+               {"type", deviceType},
+               {"name", deviceName}}
+{
+}
+
+bool CaptureWriter::writeLine(const QJsonObject& event) {
+    if (!m_file.isOpen()) {
+        if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qWarning() << "[Capture] Cannot create capture file" << m_file.fileName();
+            return false;
+        }
+        m_file.write(QJsonDocument(m_header).toJson(QJsonDocument::Compact) + '\n');
+        m_clock.start();
+    }
+
+    QJsonObject line = event;
+    line.insert("t", m_clock.elapsed());
+    m_file.write(QJsonDocument(line).toJson(QJsonDocument::Compact) + '\n');
+    m_file.flush();
+    return true;
+}
+
+bool CaptureWriter::writeNotification(const QBluetoothUuid& characteristic, const QByteArray& value) {
+    return writeLine({{"notify", uuidText(characteristic)},
+                      {"data", QString::fromLatin1(value.toHex())}});
+}
+
+ScaleCaptureRecorder::ScaleCaptureRecorder(ScaleBleTransport* transport, const QString& path,
+                                           const QString& scaleType, const QString& deviceName)
+    : QObject(transport)
+    , m_writer(path, CAPTURE_FORMAT, scaleType, deviceName)
+{
+    connect(transport, &ScaleBleTransport::serviceDiscovered, this, [this](const QBluetoothUuid& service) {
+        writeLine({{"service", uuidText(service)}});
+    });
+    connect(transport, &ScaleBleTransport::characteristicDiscovered,
+            this, [this](const QBluetoothUuid& service, const QBluetoothUuid& characteristic, int properties) {
+        writeLine({{"service", uuidText(service)},
+                   {"characteristic", uuidText(characteristic)},
+                   {"properties", properties}});
+    });
+    connect(transport, &ScaleBleTransport::characteristicChanged,
+            this, [this](const QBluetoothUuid& characteristic, const QByteArray& value) {
+        if (!m_writer.writeNotification(characteristic, value)) {
+            disconnect(parent(), nullptr, this, nullptr);
+        }
+    });
+}
+
+void ScaleCaptureRecorder::writeLine(const QJsonObject& event) {
+    if (!m_writer.writeLine(event)) {
+        disconnect(parent(), nullptr, this, nullptr);
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "scalebletransport.h"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonObject>
+#include <QList>
+
+/**
+ * Recorded scale BLE session, used to replay real scale traffic without hardware.
+ *
+ * Captures are JSON Lines files. The first line identifies the scale, every
+ * following line is one transport event with its time (ms) since recording
+ * started:
+ *
+ *   {"capture":"decentbridge-scale","version":1,"type":"Acaia","name":"PEARLS1234"}
+ *   {"t":12,"service":"49535343-fe7d-4ae5-8fa9-9fafd205e455"}
+ *   {"t":40,"service":"...","characteristic":"...","properties":18}
+ *   {"t":830,"notify":"49535343-1e4d-4bd9-ba61-23c647249616","data":"efdd0c..."}
+ *
+ * "type" is a ScaleFactory type name, so the replayed capture drives the
+ * same driver that recorded it.
+ */
+struct ScaleCapture {
+    struct Characteristic {
+        QBluetoothUuid service;
+        QBluetoothUuid uuid;
+        int properties = 0;
+    };
+
+    struct Notification {
+        qint64 timeMs = 0;
+        QBluetoothUuid characteristic;
+        QByteArray value;
+    };
+
+    QString scaleType;
+    QString deviceName;
+    QList<QBluetoothUuid> services;
+    QList<Characteristic> characteristics;
+    QList<Notification> notifications;
+
+    static bool load(const QString& path, ScaleCapture& capture, QString* errorMessage = nullptr);
+};
+
+/**
+ * Writes events in the capture layout above. The file and its header line
+ * ("capture" is the given format) are created on the first event.
+ */
+class CaptureWriter {
+public:
+    CaptureWriter(const QString& path, const QString& format,
+                  const QString& deviceType, const QString& deviceName);
+
+    // False if the file cannot be created
+    bool writeLine(const QJsonObject& event);
+    bool writeNotification(const QBluetoothUuid& characteristic, const QByteArray& value);
+
+private:
+    QFile m_file;
+    QElapsedTimer m_clock;
+    QJsonObject m_header;
+};
+
+/**
+ * Appends the traffic of a live transport to a capture file.
+ * Lives as a child of the transport; the file is created on the first event.
+ */
+class ScaleCaptureRecorder : public QObject {
+    Q_OBJECT
+
+public:
+    ScaleCaptureRecorder(ScaleBleTransport* transport, const QString& path,
+                         const QString& scaleType, const QString& deviceName);
+
+private:
+    void writeLine(const QJsonObject& event);
+
+    CaptureWriter m_writer;
+};
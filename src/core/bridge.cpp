@@ -1,31 +1,68 @@
 #include "bridge.h"
 #include "settings.h"
 #include "ble/blemanager.h"
+#include "ble/connectionmanager.h"
+#include "ble/devicecache.h"
 #include "ble/de1device.h"
 #include "ble/scaledevice.h"
 #include "ble/sensordevice.h"
 #include "ble/scales/scalefactory.h"
 #include "ble/sensors/sensorfactory.h"
+#include "ble/transport/scalecapture.h"
 #include "network/httpserver.h"
 #include "network/websocketserver.h"
 #include "network/discoveryservice.h"
 #include "core/skinmanager.h"
+#include "core/sensorfusion.h"
+#include "core/streamdemand.h"
+#include "core/telemetry.h"
 
 #include <QLoggingCategory>
+#include <QStandardPaths>
 #include <QTimer>
 
 Q_LOGGING_CATEGORY(lcBridge, "bridge.core")
 
+namespace {
+
+// Connection manager link ids
+const QString DE1_LINK = QStringLiteral("de1");
+const QString SCALE_LINK = QStringLiteral("scale");
+
+QString sensorLinkId(const QString &address)
+{
+    return QStringLiteral("sensor:") + address;
+}
+
+bool isSameDevice(const QBluetoothDeviceInfo &a, const QBluetoothDeviceInfo &b)
+{
+    // Addresses are null on Apple platforms, which identify devices by UUID
+    return a.address() == b.address() && a.deviceUuid() == b.deviceUuid();
+}
+
+constexpr int SCAN_RESTART_DELAY_MS = 5000;
+
+} // namespace
+
 Bridge::Bridge(Settings *settings, QObject *parent)
     : QObject(parent)
     , m_settings(settings)
     , m_bleManager(std::make_unique<BLEManager>())
+    , m_connections(std::make_unique<ConnectionManager>())
+    , m_deviceCache(std::make_unique<DeviceCache>(
+          QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/devices.json"))
     , m_de1(std::make_unique<DE1Device>())
+    , m_demand(std::make_unique<StreamDemand>())
+    , m_telemetry(std::make_unique<TelemetryBuffer>())
+    , m_fusion(std::make_unique<SensorFusion>())
     , m_httpServer(std::make_unique<HttpServer>(this))
     , m_wsServer(std::make_unique<WebSocketServer>(this))
     , m_discoveryService(std::make_unique<DiscoveryService>(settings))
     , m_skinManager(std::make_unique<SkinManager>())
 {
+    m_startupTimer.start();
+    m_deviceCache->load();
+    SensorFactory::loadDescriptors(SensorFactory::descriptorsPath());
     setupConnections();
 }
 
@@ -43,10 +80,17 @@ void Bridge::setupConnections()
             this, &Bridge::onScaleDiscovered);
     connect(m_bleManager.get(), &BLEManager::sensorDiscovered,
             this, &Bridge::onSensorDiscovered);
+    connect(m_bleManager.get(), &BLEManager::scanFinished,
+            this, &Bridge::onScanFinished);
 
     // DE1 -> Bridge
     connect(m_de1.get(), &DE1Device::connectedChanged,
             this, &Bridge::onDe1ConnectionChanged);
+    connect(m_de1.get(), &DE1Device::error, this, [this](const QString &message) {
+        if (!m_de1->isConnected()) {
+            m_connections->reportFailed(DE1_LINK, message);
+        }
+    });
 
     // DE1 -> WebSocket (real-time updates)
     connect(m_de1.get(), &DE1Device::shotSampleReceived,
@@ -55,6 +99,77 @@ void Bridge::setupConnections()
             m_wsServer.get(), &WebSocketServer::broadcastMachineState);
     connect(m_de1.get(), &DE1Device::waterLevelsChanged,
             m_wsServer.get(), &WebSocketServer::broadcastWaterLevels);
+    connect(m_de1.get(), &DE1Device::temperaturesChanged,
+            m_wsServer.get(), &WebSocketServer::broadcastTemperatures);
+
+    // BLE notifications follow their consumers: idle streams are switched off
+    connect(m_demand.get(), &StreamDemand::demandChanged,
+            this, [this](StreamDemand::Stream stream, bool wanted) {
+        switch (stream) {
+        case StreamDemand::Stream::ShotSamples:
+            m_de1->setNotificationsWanted(DE1::Characteristic::SHOT_SAMPLE, wanted);
+            break;
+        case StreamDemand::Stream::WaterLevels:
+            m_de1->setNotificationsWanted(DE1::Characteristic::WATER_LEVELS, wanted);
+            break;
+        case StreamDemand::Stream::Temperatures:
+            m_de1->setNotificationsWanted(DE1::Characteristic::TEMPERATURES, wanted);
+            break;
+        case StreamDemand::Stream::ScaleWeight:
+            if (m_scale && m_scale->isConnected()) {
+                m_scale->setNotificationsPaused(!wanted);
+            }
+            break;
+        }
+    });
+
+    // DE1 -> typed telemetry snapshot (read by the dashboard)
+    connect(m_de1.get(), &DE1Device::shotSampleReceived, this, &Bridge::publishTelemetry);
+    connect(m_de1.get(), &DE1Device::stateChanged, this, &Bridge::publishTelemetry);
+
+    // Devices, discovery and machine -> HTTP event stream (dashboard)
+    connect(this, &Bridge::de1Connected, m_httpServer.get(), &HttpServer::pushDevices);
+    connect(this, &Bridge::de1Disconnected, m_httpServer.get(), &HttpServer::pushDevices);
+    connect(this, &Bridge::scaleConnected, m_httpServer.get(), &HttpServer::pushDevices);
+    connect(this, &Bridge::scaleDisconnected, m_httpServer.get(), &HttpServer::pushDevices);
+    connect(m_bleManager.get(), &BLEManager::discoveredDevicesChanged,
+            m_httpServer.get(), &HttpServer::pushDiscovered);
+    connect(m_bleManager.get(), &BLEManager::scanningChanged,
+            m_httpServer.get(), &HttpServer::pushScanning);
+    connect(m_de1.get(), &DE1Device::stateChanged,
+            m_httpServer.get(), &HttpServer::pushMachineState);
+    connect(m_de1.get(), &DE1Device::shotSampleReceived,
+            m_httpServer.get(), &HttpServer::pushShotSample);
+
+    // Machine and scale -> HTTP long polls waiting on them
+    connect(m_de1.get(), &DE1Device::stateChanged, m_httpServer.get(), &HttpServer::wakeMachineState);
+    connect(m_de1.get(), &DE1Device::shotSampleReceived, m_httpServer.get(), &HttpServer::wakeShotSample);
+    connect(m_de1.get(), &DE1Device::waterLevelsChanged, m_httpServer.get(), &HttpServer::wakeWaterLevels);
+    connect(m_de1.get(), &DE1Device::shotSettingsChanged, m_httpServer.get(), &HttpServer::wakeShotSettings);
+    // A device going away answers its waiters now (503) instead of at their timeout
+    connect(this, &Bridge::de1Disconnected, m_httpServer.get(), &HttpServer::wakeMachineState);
+    connect(this, &Bridge::de1Disconnected, m_httpServer.get(), &HttpServer::wakeShotSample);
+    connect(this, &Bridge::de1Disconnected, m_httpServer.get(), &HttpServer::wakeWaterLevels);
+    connect(this, &Bridge::de1Disconnected, m_httpServer.get(), &HttpServer::wakeShotSettings);
+    connect(this, &Bridge::scaleDisconnected, m_httpServer.get(), &HttpServer::wakeScale);
+
+    // All readings -> fusion stage -> one time-aligned record per tick
+    connect(m_de1.get(), &DE1Device::shotSampleReceived, this, [this]() {
+        m_fusion->addValue("de1", "pressure", m_de1->pressure());
+        m_fusion->addValue("de1", "flow", m_de1->flow());
+        m_fusion->addValue("de1", "mixTemperature", m_de1->mixTemp());
+        m_fusion->addValue("de1", "groupTemperature", m_de1->headTemp());
+        m_fusion->addValue("de1", "steamTemperature", m_de1->steamTemp());
+    });
+    connect(this, &Bridge::de1Disconnected, this, [this]() { m_fusion->removeSource("de1"); });
+    connect(this, &Bridge::scaleDisconnected, this, [this]() { m_fusion->removeSource("scale"); });
+    connect(this, &Bridge::sensorDisconnected, m_fusion.get(), &SensorFusion::removeSource);
+    connect(m_fusion.get(), &SensorFusion::sampleFused,
+            m_wsServer.get(), &WebSocketServer::broadcastFusedSample);
+    m_fusion->setRate(m_settings->fusionRate());
+    connect(m_settings, &Settings::settingsChanged, this, [this]() {
+        m_fusion->setRate(m_settings->fusionRate());
+    });
 
     // Forward WebSocket upgrade requests from HTTP port to WebSocket server
     connect(m_httpServer.get(), &HttpServer::webSocketUpgradeRequested,
@@ -62,6 +177,7 @@ void Bridge::setupConnections()
 
     // When skin is ready, tell HTTP server where to serve static files from
     connect(m_skinManager.get(), &SkinManager::skinReady, this, [this]() {
+        m_httpServer->setSkinArchive(m_skinManager->skinArchive());
         m_httpServer->setSkinRoot(m_skinManager->skinRootPath());
     });
 }
@@ -87,20 +203,36 @@ bool Bridge::start()
         return false;
     }
 
+    // Known devices connect directly; scanning finds new ones in parallel
+    m_connections->start();
+    connectKnownDevices();
+    m_bleManager->startScan();
+
+    m_running = true;
+    qCInfo(lcBridge) << "Critical startup path ready in" << m_startupTimer.elapsed() << "ms";
+    emit started();
+
+    // Everything else runs once the event loop is serving requests
+    QTimer::singleShot(0, this, &Bridge::startBackgroundTasks);
+    return true;
+}
+
+void Bridge::startBackgroundTasks()
+{
+    if (!m_running) return;
+
     // Start discovery service (for network discovery)
     if (!m_discoveryService->start()) {
         qCWarning(lcBridge) << "Failed to start discovery service (non-fatal)";
     }
 
-    // Start BLE scanning
-    m_bleManager->startScan();
-
     // Start skin manager (async download, non-blocking)
     m_skinManager->initialize();
 
-    m_running = true;
-    emit started();
-    return true;
+    // Copy bundled profiles to disk; handlers serve them from resources meanwhile
+    m_httpServer->provisionDefaultProfiles();
+
+    qCInfo(lcBridge) << "Background startup tasks scheduled at" << m_startupTimer.elapsed() << "ms";
 }
 
 void Bridge::stop()
@@ -109,6 +241,7 @@ void Bridge::stop()
         return;
     }
 
+    m_connections->clear();
     m_bleManager->stopScan();
     m_de1->disconnect();
 
@@ -116,6 +249,7 @@ void Bridge::stop()
         m_scale->disconnect();
         delete m_scale;
         m_scale = nullptr;
+        m_devicesGeneration.bump();
     }
 
     // Disconnect all sensors
@@ -124,6 +258,7 @@ void Bridge::stop()
         delete sensor;
     }
     m_sensors.clear();
+    m_sensorsById.clear();
 
     m_httpServer->stop();
     m_wsServer->stop();
@@ -133,9 +268,41 @@ void Bridge::stop()
     emit stopped();
 }
 
+void Bridge::connectKnownDevices()
+{
+    for (const QString &id : m_deviceCache->ids()) {
+        const DeviceCache::Entry entry = m_deviceCache->entry(id);
+        const QBluetoothDeviceInfo &device = entry.device;
+
+        if (id == DE1_LINK) {
+            if (m_settings->autoConnect() || device.address().toString() == m_settings->de1Address()) {
+                qCInfo(lcBridge) << "Direct connect to known DE1:" << device.name();
+                addDe1Link(device);
+            }
+        } else if (id == SCALE_LINK) {
+            if (m_settings->autoConnectScale()) {
+                qCInfo(lcBridge) << "Direct connect to known scale:" << device.name();
+                connectToScale(device);
+            }
+        } else if (id.startsWith(sensorLinkId(QString()))) {
+            qCInfo(lcBridge) << "Direct connect to known sensor:" << device.name();
+            connectToSensor(device);
+        }
+    }
+}
+
 void Bridge::onDe1Discovered(const QBluetoothDeviceInfo &device)
 {
-    if (m_de1->isConnected() || m_de1->isConnecting()) {
+    if (m_connections->hasLink(DE1_LINK)) {
+        if (isSameDevice(m_connections->device(DE1_LINK), device)) {
+            m_connections->retryNow(DE1_LINK);
+            return;
+        }
+        // A known DE1 that is not reachable yields to one that is advertising
+        if (m_connections->isConnected(DE1_LINK)) {
+            return;
+        }
+    } else if (m_de1->isConnected() || m_de1->isConnecting()) {
         return;
     }
 
@@ -143,11 +310,20 @@ void Bridge::onDe1Discovered(const QBluetoothDeviceInfo &device)
     if (m_settings->autoConnect() ||
         device.address().toString() == m_settings->de1Address()) {
         qCInfo(lcBridge) << "Connecting to DE1:" << device.name();
-        m_bleManager->stopScan();
-        m_de1->connectToDevice(device);
+        addDe1Link(device);
     }
 }
 
+void Bridge::addDe1Link(const QBluetoothDeviceInfo &device)
+{
+    DeviceCache::Entry known = m_deviceCache->entry(DE1_LINK);
+    m_de1->setKnownServices(isSameDevice(known.device, device) ? known.services : QList<QBluetoothUuid>());
+
+    // Scanning continues so scales and sensors are found while the DE1 connects
+    m_connections->addLink(DE1_LINK, ConnectionManager::Role::DE1, device,
+                           [this](const QBluetoothDeviceInfo &d) { m_de1->connectToDevice(d); });
+}
+
 void Bridge::onScaleDiscovered(const QBluetoothDeviceInfo &device)
 {
     // Auto-connect disabled - scales must be connected manually via connectToScale()
@@ -158,6 +334,21 @@ void Bridge::onScaleDiscovered(const QBluetoothDeviceInfo &device)
     connectToScale(device);
 }
 
+void Bridge::onScanFinished()
+{
+    if (!m_running) return;
+
+    // Keep looking while a device we would connect to has not been seen yet;
+    // links that were found once are reconnected by the connection manager
+    bool wantDe1 = !m_connections->hasLink(DE1_LINK);
+    bool wantScale = m_settings->autoConnectScale() && !m_connections->hasLink(SCALE_LINK);
+    if (wantDe1 || wantScale) {
+        QTimer::singleShot(SCAN_RESTART_DELAY_MS, this, [this]() {
+            if (m_running) m_bleManager->startScan();
+        });
+    }
+}
+
 void Bridge::connectToScale(const QBluetoothDeviceInfo &device)
 {
     qCInfo(lcBridge) << "connectToScale called for:" << device.name() << device.address().toString();
@@ -168,114 +359,189 @@ void Bridge::connectToScale(const QBluetoothDeviceInfo &device)
         return;
     }
 
-    // If a connection is "in progress" but taking too long, allow override
-    // This handles cases where previous connection attempt got stuck
-    if (m_scaleConnecting) {
-        qCWarning(lcBridge) << "Previous connection attempt stuck, cleaning up";
-        if (m_scale) {
-            m_scale->disconnectFromScale();  // Explicitly disconnect BLE first
-            m_scale->deleteLater();
-            m_scale = nullptr;
-        }
-        m_scaleConnecting = false;
+    if (m_connections->hasLink(SCALE_LINK) && isSameDevice(m_connections->device(SCALE_LINK), device)) {
+        qCInfo(lcBridge) << "Scale connection already in progress:" << device.name();
+        m_connections->retryNow(SCALE_LINK);
+        return;
     }
 
+    // Replaces any pending attempt to a different scale
+    m_connections->addLink(SCALE_LINK, ConnectionManager::Role::Scale, device,
+                           [this](const QBluetoothDeviceInfo &d) { createScale(d); });
+}
+
+void Bridge::createScale(const QBluetoothDeviceInfo &device)
+{
     // Use ScaleFactory to create the appropriate scale type
     auto scale = ScaleFactory::createScale(device, this);
 
     if (!scale) {
         qCWarning(lcBridge) << "Unknown scale type, cannot create:" << device.name();
+        m_connections->removeLink(SCALE_LINK);
         return;
     }
 
+    attachScale(std::move(scale), device);
+}
+
+bool Bridge::replayScale(const QString &capturePath, double speed)
+{
+    ScaleCapture capture;
+    QString errorMessage;
+    if (!ScaleCapture::load(capturePath, capture, &errorMessage)) {
+        qCWarning(lcBridge) << "Cannot load scale capture" << capturePath << ":" << errorMessage;
+        return false;
+    }
+
+    auto scale = ScaleFactory::createReplayScale(capture, speed, this);
+    if (!scale) {
+        return false;
+    }
+
+    // Not a managed link: a dropped replay is not retried
+    m_connections->removeLink(SCALE_LINK);
+    QBluetoothDeviceInfo device(QBluetoothAddress(), capture.deviceName, 0);
+    attachScale(std::move(scale), device);
+    return true;
+}
+
+void Bridge::attachScale(std::unique_ptr<ScaleDevice> scale, const QBluetoothDeviceInfo &device)
+{
     qCInfo(lcBridge) << "Connecting to scale:" << device.name() << "type:" << scale->type();
-    m_scaleConnecting = true;
 
     // Clean up old scale if any
-    if (m_scale) {
-        m_scale->disconnectFromScale();  // Explicitly disconnect BLE first
-        m_scale->deleteLater();
-    }
+    releaseScale();
     m_scale = scale.release();
+    m_devicesGeneration.bump();
 
     // Connect scale signals
     connect(m_scale, &ScaleDevice::connectedChanged, this, [this]() {
         onScaleConnectionChanged(m_scale ? m_scale->isConnected() : false);
     });
     connect(m_scale, &ScaleDevice::weightChanged, this, [this](double weight) {
-        m_wsServer->broadcastScaleWeight(weight, m_scale ? m_scale->flowRate() : 0.0);
+        double flow = m_scale ? m_scale->flowRate() : 0.0;
+        m_wsServer->broadcastScaleWeight(weight, flow);
+        m_httpServer->pushScaleWeight(weight, flow);
+        m_httpServer->wakeScale();
+        m_fusion->addValue("scale", "weight", weight);
+        m_fusion->addValue("scale", "weightFlow", flow);
+        publishTelemetry();
     });
     // Handle connection errors
     connect(m_scale, &ScaleDevice::errorOccurred, this, [this](const QString &error) {
         qCWarning(lcBridge) << "Scale connection error:" << error;
-        m_scaleConnecting = false;
-    });
-
-    // Connection timeout - reset flag after 15 seconds if still connecting
-    QTimer::singleShot(15000, this, [this]() {
-        if (m_scaleConnecting && (!m_scale || !m_scale->isConnected())) {
-            qCWarning(lcBridge) << "Scale connection timeout, resetting";
-            m_scaleConnecting = false;
+        if (m_scale && !m_scale->isConnected()) {
+            m_connections->reportFailed(SCALE_LINK, error);
         }
     });
 
     m_scale->connectToDevice(device);
 }
 
+void Bridge::releaseScale()
+{
+    if (!m_scale) return;
+
+    // Stop listening first so the teardown is not reported as a link failure
+    QObject::disconnect(m_scale, nullptr, this, nullptr);
+    m_scale->disconnectFromScale();  // Explicitly disconnect BLE first
+    m_scale->deleteLater();
+    m_scale = nullptr;
+    m_devicesGeneration.bump();
+}
+
+quint64 Bridge::devicesGeneration() const
+{
+    // The stamp taken on release is newer than any the old scale handed out,
+    // so the largest of these never moves backwards
+    quint64 generation = m_devicesGeneration.value();
+    generation = qMax(generation, m_de1->infoGeneration());
+    if (m_scale) {
+        generation = qMax(generation, m_scale->generation());
+    }
+    return generation;
+}
+
+void Bridge::publishTelemetry()
+{
+    Telemetry telemetry;
+    telemetry.state = m_de1->state();
+    telemetry.subState = m_de1->subState();
+    telemetry.pressure = m_de1->pressure();
+    telemetry.flow = m_de1->flow();
+    telemetry.groupTemp = m_de1->headTemp();
+    telemetry.steamTemp = m_de1->steamTemp();
+    if (m_scale) {
+        telemetry.scaleWeight = m_scale->weight();
+        telemetry.scaleFlow = m_scale->flowRate();
+    }
+
+    if (m_telemetry->publish(telemetry)) {
+        emit telemetryPublished();
+    }
+}
+
 void Bridge::onDe1ConnectionChanged(bool connected)
 {
     if (connected) {
         qCInfo(lcBridge) << "DE1 connected";
+        if (m_connections->hasLink(DE1_LINK)) {
+            QList<QBluetoothUuid> services = m_de1->services();
+            m_de1->setKnownServices(services);
+            m_deviceCache->remember(DE1_LINK, m_connections->device(DE1_LINK), "DE1", services);
+        }
+        m_connections->reportConnected(DE1_LINK);
         emit de1Connected();
     } else {
         qCInfo(lcBridge) << "DE1 disconnected";
         emit de1Disconnected();
-
-        // Resume scanning
-        if (m_running && m_settings->autoConnect()) {
-            m_bleManager->startScan();
-        }
+        m_connections->reportFailed(DE1_LINK, "disconnected");
     }
 }
 
 void Bridge::onScaleConnectionChanged(bool connected)
 {
-    m_scaleConnecting = false; // Connection attempt finished (success or failure)
-
     if (connected) {
         qCInfo(lcBridge) << "Scale connected:" << m_scale->name();
+        if (m_connections->hasLink(SCALE_LINK)) {
+            m_deviceCache->remember(SCALE_LINK, m_connections->device(SCALE_LINK), m_scale->type());
+        }
+        m_connections->reportConnected(SCALE_LINK);
+        m_scale->setNotificationsPaused(!m_demand->isWanted(StreamDemand::Stream::ScaleWeight));
         emit scaleConnected();
     } else {
         qCInfo(lcBridge) << "Scale disconnected";
         emit scaleDisconnected();
-
-        // Resume scanning for scales
-        if (m_running && m_settings->autoConnectScale()) {
-            m_bleManager->startScan();
-        }
+        m_connections->reportFailed(SCALE_LINK, "disconnected");
     }
 }
 
 void Bridge::disconnectScale()
 {
-    m_scaleConnecting = false;
+    // An explicit disconnect also stops reconnecting on the next start
+    m_connections->removeLink(SCALE_LINK);
+    m_deviceCache->forget(SCALE_LINK);
     if (m_scale) {
         qCInfo(lcBridge) << "Disconnecting scale:" << m_scale->name();
-        m_scale->disconnect();
-        m_scale->deleteLater();
-        m_scale = nullptr;
+        releaseScale();
     }
 }
 
 // Sensor methods
 SensorDevice* Bridge::sensor(const QString &id) const
 {
-    for (auto sensor : m_sensors) {
-        if (sensor->id() == id) {
-            return sensor;
-        }
+    return m_sensorsById.value(id);
+}
+
+void Bridge::removeSensor(SensorDevice *sensor)
+{
+    QObject::disconnect(sensor, nullptr, this, nullptr);
+    m_sensors.removeAll(sensor);
+    // A replacement may already be registered under the same ID
+    if (m_sensorsById.value(sensor->id()) == sensor) {
+        m_sensorsById.remove(sensor->id());
     }
-    return nullptr;
+    sensor->deleteLater();
 }
 
 void Bridge::onSensorDiscovered(const QBluetoothDeviceInfo &device)
@@ -286,18 +552,43 @@ void Bridge::onSensorDiscovered(const QBluetoothDeviceInfo &device)
 
 void Bridge::connectToSensor(const QBluetoothDeviceInfo &device)
 {
-    // Check if already connected to this sensor
+    QString linkId = sensorLinkId(device.address().toString());
+    if (m_connections->hasLink(linkId)) {
+        qCInfo(lcBridge) << "Sensor already connected or connecting:" << device.name();
+        m_connections->retryNow(linkId);
+        return;
+    }
+
+    if (!SensorFactory::isSensor(device)) {
+        qCWarning(lcBridge) << "Unknown sensor type:" << device.name();
+        return;
+    }
+
+    m_connections->addLink(linkId, ConnectionManager::Role::Sensor, device,
+                           [this](const QBluetoothDeviceInfo &d) { createSensor(d); });
+}
+
+void Bridge::createSensor(const QBluetoothDeviceInfo &device)
+{
+    // Drop the object left over from a failed attempt
     QString address = device.address().toString();
-    for (auto sensor : m_sensors) {
-        if (sensor->address() == address) {
-            qCInfo(lcBridge) << "Sensor already connected:" << device.name();
-            return;
+    SensorDevice *stale = nullptr;
+    for (SensorDevice *existing : std::as_const(m_sensors)) {
+        if (existing->address() == address) {
+            stale = existing;
+            break;
         }
     }
+    if (stale) {
+        QObject::disconnect(stale, nullptr, this, nullptr);
+        stale->disconnect();
+        removeSensor(stale);
+    }
 
     auto sensor = SensorFactory::createSensor(device, this);
     if (!sensor) {
         qCWarning(lcBridge) << "Unknown sensor type:" << device.name();
+        m_connections->removeLink(sensorLinkId(address));
         return;
     }
 
@@ -306,23 +597,29 @@ void Bridge::connectToSensor(const QBluetoothDeviceInfo &device)
     connect(sensor, &SensorDevice::connected, this, &Bridge::onSensorConnected);
     connect(sensor, &SensorDevice::disconnected, this, &Bridge::onSensorDisconnected);
     connect(sensor, &SensorDevice::dataUpdated, this, &Bridge::onSensorDataUpdated);
+    connect(sensor, &SensorDevice::errorOccurred, this, [this, sensor, address](const QString &error) {
+        if (!sensor->isConnected()) {
+            m_connections->reportFailed(sensorLinkId(address), error);
+        }
+    });
 
     m_sensors.append(sensor);
-    sensor->connectToDevice(device);
+    sensor->connectToDevice(device);  // Assigns the ID
+    m_sensorsById.insert(sensor->id(), sensor);
 }
 
 void Bridge::disconnectSensor(const QString &id)
 {
-    for (int i = 0; i < m_sensors.size(); ++i) {
-        if (m_sensors[i]->id() == id) {
-            qCInfo(lcBridge) << "Disconnecting sensor:" << m_sensors[i]->name();
-            m_sensors[i]->disconnect();
-            m_sensors[i]->deleteLater();
-            m_sensors.removeAt(i);
-            emit sensorDisconnected(id);
-            return;
-        }
-    }
+    SensorDevice *sensor = m_sensorsById.value(id);
+    if (!sensor) return;
+
+    qCInfo(lcBridge) << "Disconnecting sensor:" << sensor->name();
+    m_connections->removeLink(sensorLinkId(sensor->address()));
+    m_deviceCache->forget(sensorLinkId(sensor->address()));
+    QObject::disconnect(sensor, nullptr, this, nullptr);
+    sensor->disconnect();
+    removeSensor(sensor);
+    emit sensorDisconnected(id);
 }
 
 void Bridge::onSensorConnected()
@@ -330,6 +627,11 @@ void Bridge::onSensorConnected()
     auto sensor = qobject_cast<SensorDevice*>(sender());
     if (sensor) {
         qCInfo(lcBridge) << "Sensor connected:" << sensor->name();
+        QString linkId = sensorLinkId(sensor->address());
+        if (m_connections->hasLink(linkId)) {
+            m_deviceCache->remember(linkId, m_connections->device(linkId), sensor->sensorType());
+        }
+        m_connections->reportConnected(linkId);
         emit sensorConnected(sensor);
     }
 }
@@ -341,11 +643,11 @@ void Bridge::onSensorDisconnected()
         QString id = sensor->id();
         qCInfo(lcBridge) << "Sensor disconnected:" << sensor->name();
 
-        // Remove from list
-        m_sensors.removeAll(sensor);
-        sensor->deleteLater();
+        // Remove from list; the connection manager creates a fresh one on retry
+        removeSensor(sensor);
 
         emit sensorDisconnected(id);
+        m_connections->reportFailed(sensorLinkId(sensor->address()), "disconnected");
     }
 }
 
@@ -355,5 +657,10 @@ void Bridge::onSensorDataUpdated(const QJsonObject &data)
     if (sensor) {
         emit sensorDataUpdated(sensor->id(), data);
         m_wsServer->broadcastSensorData(sensor->id(), data);
+
+        const QList<SensorDevice::DataChannel> channels = sensor->dataChannels();
+        for (int i = 0; i < channels.size(); ++i) {
+            m_fusion->addValue(sensor->id(), channels[i].key, sensor->value(i));
+        }
     }
 }
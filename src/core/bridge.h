@@ -3,10 +3,16 @@
 
 #include <QObject>
 #include <QBluetoothDeviceInfo>
+#include <QElapsedTimer>
+#include <QHash>
 #include <memory>
 
+#include "ble/datageneration.h"
+
 class Settings;
 class BLEManager;
+class ConnectionManager;
+class DeviceCache;
 class DE1Device;
 class ScaleDevice;
 class SensorDevice;
@@ -14,6 +20,9 @@ class HttpServer;
 class WebSocketServer;
 class DiscoveryService;
 class SkinManager;
+class StreamDemand;
+class TelemetryBuffer;
+class SensorFusion;
 
 /**
  * @brief Main bridge orchestrator
@@ -42,9 +51,29 @@ public:
     QList<SensorDevice*> sensors() const { return m_sensors; }
     SensorDevice* sensor(const QString &id) const;
 
+    // Who consumes which BLE notification stream
+    StreamDemand *demand() const { return m_demand.get(); }
+
+    // Latest machine and scale readings for a consumer on any thread; take()
+    // from it after telemetryPublished()
+    TelemetryBuffer *telemetry() const { return m_telemetry.get(); }
+
+    // DE1, scale and sensor readings resampled onto one clock
+    SensorFusion *fusion() const { return m_fusion.get(); }
+
+    // Change stamp for the device list (see DataGeneration): moves when a
+    // scale is attached or released and whenever the DE1 or the scale changes
+    quint64 devicesGeneration() const;
+
+    // Reconnect state of every BLE link
+    ConnectionManager *connections() const { return m_connections.get(); }
+
     // Scale control
     void disconnectScale();
     void connectToScale(const QBluetoothDeviceInfo &device);
+    // Drive the scale pipeline from a recorded capture instead of BLE
+    // (speed 1.0 = real time, 0 = as fast as possible)
+    bool replayScale(const QString &capturePath, double speed = 1.0);
 
     // Sensor control
     void connectToSensor(const QBluetoothDeviceInfo &device);
@@ -63,6 +92,9 @@ signals:
     void sensorConnected(SensorDevice *sensor);
     void sensorDisconnected(const QString &id);
     void sensorDataUpdated(const QString &id, const QJsonObject &data);
+    // New telemetry after the previous snapshot was taken; not repeated
+    // until the consumer takes again
+    void telemetryPublished();
 
 private slots:
     void onDe1Discovered(const QBluetoothDeviceInfo &device);
@@ -76,19 +108,36 @@ private slots:
 
 private:
     void setupConnections();
+    void startBackgroundTasks();
+    void attachScale(std::unique_ptr<ScaleDevice> scale, const QBluetoothDeviceInfo &device);
+    void connectKnownDevices();
+    void addDe1Link(const QBluetoothDeviceInfo &device);
+    void createScale(const QBluetoothDeviceInfo &device);
+    void createSensor(const QBluetoothDeviceInfo &device);
+    void releaseScale();
+    void removeSensor(SensorDevice *sensor);
+    void onScanFinished();
+    void publishTelemetry();
 
     Settings *m_settings;
     std::unique_ptr<BLEManager> m_bleManager;
+    std::unique_ptr<ConnectionManager> m_connections;
+    std::unique_ptr<DeviceCache> m_deviceCache;
     std::unique_ptr<DE1Device> m_de1;
     ScaleDevice *m_scale = nullptr; // Owned by factory
+    DataGeneration m_devicesGeneration;
     QList<SensorDevice*> m_sensors;
+    QHash<QString, SensorDevice*> m_sensorsById;
+    std::unique_ptr<StreamDemand> m_demand;  // Outlives the servers holding references
+    std::unique_ptr<TelemetryBuffer> m_telemetry;
+    std::unique_ptr<SensorFusion> m_fusion;
     std::unique_ptr<HttpServer> m_httpServer;
     std::unique_ptr<WebSocketServer> m_wsServer;
     std::unique_ptr<DiscoveryService> m_discoveryService;
     std::unique_ptr<SkinManager> m_skinManager;
 
+    QElapsedTimer m_startupTimer;
     bool m_running = false;
-    bool m_scaleConnecting = false; // Prevents multiple simultaneous connection attempts
 };
 
 #endif // BRIDGE_H
@@ -0,0 +1,306 @@
+#include "keyvaluestore.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QLoggingCategory>
+#include <QSaveFile>
+#include <QtEndian>
+
+#include <miniz.h>
+#include <utility>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+Q_LOGGING_CATEGORY(lcStore, "bridge.store")
+
+namespace {
+
+constexpr int RECORD_HEADER_SIZE = 8;
+
+void appendU32(QByteArray &out, quint32 v)
+{
+    char buf[4];
+    qToLittleEndian(v, buf);
+    out.append(buf, 4);
+}
+
+void appendEntry(QByteArray &payload, const QString &key, const QByteArray &value)
+{
+    QByteArray keyUtf8 = key.toUtf8();
+    appendU32(payload, quint32(keyUtf8.size()));
+    payload.append(keyUtf8);
+    appendU32(payload, quint32(value.size()));
+    payload.append(value);
+}
+
+void appendRecord(QByteArray &out, const QByteArray &payload)
+{
+    appendU32(out, quint32(payload.size()));
+    appendU32(out, quint32(mz_crc32(MZ_CRC32_INIT,
+                                     reinterpret_cast<const uchar *>(payload.constData()),
+                                     size_t(payload.size()))));
+    out.append(payload);
+}
+
+bool syncToDisk(QFile &file)
+{
+    if (!file.flush()) return false;
+#ifdef Q_OS_WIN
+    return _commit(file.handle()) == 0;
+#else
+    return ::fsync(file.handle()) == 0;
+#endif
+}
+
+} // namespace
+
+KeyValueStore::KeyValueStore(const QString &dir, QObject *parent)
+    : QObject(parent)
+    , m_dir(dir)
+{
+    m_commitTimer.setSingleShot(true);
+    m_commitTimer.setInterval(COMMIT_INTERVAL_MS);
+    connect(&m_commitTimer, &QTimer::timeout, this, &KeyValueStore::commitPending);
+    m_ioThread.setMaxThreadCount(1);
+}
+
+KeyValueStore::~KeyValueStore()
+{
+    flush();
+}
+
+bool KeyValueStore::isValidName(const QString &name)
+{
+    return !name.isEmpty() && !name.contains("..") && !name.contains('/') && !name.contains('\\');
+}
+
+QString KeyValueStore::logPath(const QString &ns) const
+{
+    return m_dir + "/" + ns + ".log";
+}
+
+QByteArray KeyValueStore::value(const QString &ns, const QString &key)
+{
+    return load(ns).values.value(key);
+}
+
+QHash<QString, QByteArray> KeyValueStore::values(const QString &ns, const QStringList &keys)
+{
+    const Namespace &space = load(ns);
+    if (keys.isEmpty()) return space.values;
+
+    QHash<QString, QByteArray> result;
+    for (const QString &key : keys) {
+        auto it = space.values.constFind(key);
+        if (it != space.values.constEnd()) result.insert(key, it.value());
+    }
+    return result;
+}
+
+void KeyValueStore::put(const QString &ns, const QString &key, const QByteArray &value)
+{
+    put(ns, QHash<QString, QByteArray>{{key, value}});
+}
+
+void KeyValueStore::put(const QString &ns, const QHash<QString, QByteArray> &entries)
+{
+    if (entries.isEmpty()) return;
+
+    Namespace &space = load(ns);
+    QByteArray payload;
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+        auto existing = space.values.constFind(it.key());
+        if (existing != space.values.constEnd()) {
+            space.liveSize -= existing.key().size() + existing.value().size();
+        }
+        space.values.insert(it.key(), it.value());
+        space.liveSize += it.key().size() + it.value().size();
+        appendEntry(payload, it.key(), it.value());
+    }
+    appendRecord(space.pending, payload);
+
+    if (space.pending.size() >= COMMIT_THRESHOLD) {
+        commit(ns, space);
+    } else if (!m_commitTimer.isActive()) {
+        m_commitTimer.start();
+    }
+}
+
+void KeyValueStore::flush()
+{
+    commitPending();
+    m_ioThread.waitForDone();
+}
+
+void KeyValueStore::commitPending()
+{
+    m_commitTimer.stop();
+    for (auto it = m_namespaces.begin(); it != m_namespaces.end(); ++it) {
+        if (!it->pending.isEmpty() || it->needsSnapshot) commit(it.key(), it.value());
+    }
+}
+
+KeyValueStore::Namespace &KeyValueStore::load(const QString &ns)
+{
+    auto it = m_namespaces.find(ns);
+    if (it != m_namespaces.end()) return it.value();
+
+    Namespace &space = m_namespaces[ns];
+    QString path = logPath(ns);
+    if (QFile::exists(path)) {
+        replay(space, path);
+    } else if (QFileInfo(m_dir + "/" + ns).isDir()) {
+        importLegacy(space, ns);
+    }
+    return space;
+}
+
+void KeyValueStore::replay(Namespace &space, const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadWrite)) {
+        qCWarning(lcStore) << "Failed to open store log:" << path;
+        return;
+    }
+
+    const QByteArray log = file.readAll();
+    const char *data = log.constData();
+    qint64 offset = 0;
+
+    while (offset + RECORD_HEADER_SIZE <= log.size()) {
+        quint32 length = qFromLittleEndian<quint32>(data + offset);
+        quint32 crc = qFromLittleEndian<quint32>(data + offset + 4);
+        qint64 payloadStart = offset + RECORD_HEADER_SIZE;
+        if (payloadStart + length > log.size()) break;
+
+        const uchar *payload = reinterpret_cast<const uchar *>(data + payloadStart);
+        if (quint32(mz_crc32(MZ_CRC32_INIT, payload, length)) != crc) break;
+
+        qint64 pos = payloadStart;
+        qint64 end = payloadStart + length;
+        while (pos + 4 <= end) {
+            quint32 keyLength = qFromLittleEndian<quint32>(data + pos);
+            pos += 4;
+            if (pos + keyLength + 4 > end) break;
+            QString key = QString::fromUtf8(data + pos, qsizetype(keyLength));
+            pos += keyLength;
+            quint32 valueLength = qFromLittleEndian<quint32>(data + pos);
+            pos += 4;
+            if (pos + valueLength > end) break;
+            space.values.insert(key, QByteArray(data + pos, qsizetype(valueLength)));
+            pos += valueLength;
+        }
+        offset = end;
+    }
+
+    // Drop a torn tail left by an interrupted commit
+    if (offset < log.size()) {
+        qCWarning(lcStore) << "Discarding" << (log.size() - offset) << "bytes of incomplete records in" << path;
+        file.resize(offset);
+    }
+
+    space.logSize = offset;
+    for (auto it = space.values.constBegin(); it != space.values.constEnd(); ++it) {
+        space.liveSize += it.key().size() + it.value().size();
+    }
+}
+
+void KeyValueStore::importLegacy(Namespace &space, const QString &ns)
+{
+    QDir legacyDir(m_dir + "/" + ns);
+    const QStringList files = legacyDir.entryList({"*.json"}, QDir::Files);
+
+    for (const QString &fileName : files) {
+        QFile file(legacyDir.filePath(fileName));
+        if (!file.open(QIODevice::ReadOnly)) continue;
+        QString key = fileName.chopped(5); // strip ".json"
+        QByteArray value = file.readAll();
+        space.liveSize += key.size() + value.size();
+        space.values.insert(key, value);
+    }
+
+    // The snapshot must be durable before the old files go away
+    qCInfo(lcStore) << "Importing" << files.size() << "keys into" << logPath(ns);
+    compact(ns, space, legacyDir.absolutePath());
+}
+
+void KeyValueStore::commit(const QString &ns, Namespace &space)
+{
+    // Rewrite instead of appending once the log is mostly superseded values,
+    // or when an earlier append may be missing from it
+    qint64 projected = space.logSize + space.pending.size();
+    if (space.needsSnapshot || (projected > COMPACT_MIN_SIZE && projected > 4 * space.liveSize)) {
+        compact(ns, space);
+        return;
+    }
+
+    // Memory already holds these values; only the disk is behind
+    const QString path = logPath(ns);
+    const QString dir = m_dir;
+    const QByteArray data = std::exchange(space.pending, QByteArray());
+    space.logSize += data.size();
+
+    m_ioThread.start([this, ns, path, dir, data]() {
+        QDir().mkpath(dir);
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Append)
+            || file.write(data) != data.size() || !syncToDisk(file)) {
+            qCWarning(lcStore) << "Failed to commit" << data.size() << "bytes to" << path;
+            QMetaObject::invokeMethod(this, [this, ns]() { commitFailed(ns); }, Qt::QueuedConnection);
+        }
+    });
+}
+
+void KeyValueStore::compact(const QString &ns, Namespace &space, const QString &removeAfter)
+{
+    QByteArray payload;
+    payload.reserve(qsizetype(space.liveSize + 8 * space.values.size()));
+    for (auto it = space.values.constBegin(); it != space.values.constEnd(); ++it) {
+        appendEntry(payload, it.key(), it.value());
+    }
+    QByteArray snapshot;
+    appendRecord(snapshot, payload);
+
+    const qint64 before = space.logSize + space.pending.size();
+    const QString path = logPath(ns);
+    const QString dir = m_dir;
+    space.logSize = snapshot.size();
+    space.pending.clear();
+    space.needsSnapshot = false;
+
+    m_ioThread.start([this, ns, path, dir, snapshot, before, removeAfter]() {
+        QElapsedTimer timer;
+        timer.start();
+
+        QDir().mkpath(dir);
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly) || file.write(snapshot) != snapshot.size() || !file.commit()) {
+            qCWarning(lcStore) << "Failed to compact store log:" << path;
+            QMetaObject::invokeMethod(this, [this, ns]() { commitFailed(ns); }, Qt::QueuedConnection);
+            return;
+        }
+        if (!removeAfter.isEmpty()) {
+            QDir(removeAfter).removeRecursively();
+        }
+        qCInfo(lcStore) << "Compacted" << ns << "from" << before << "to" << snapshot.size()
+                        << "bytes in" << timer.elapsed() << "ms";
+    });
+}
+
+// A failed write may have left any part of the log behind memory; the next
+// commit rewrites it from memory in full
+void KeyValueStore::commitFailed(const QString &ns)
+{
+    auto it = m_namespaces.find(ns);
+    if (it == m_namespaces.end()) return;
+    it->needsSnapshot = true;
+    if (!m_commitTimer.isActive()) {
+        m_commitTimer.start();
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef KEYVALUESTORE_H
+#define KEYVALUESTORE_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
+
+/**
+ * @brief Log-structured key-value store backing /api/v1/store
+ *
+ * Each namespace is one append-only log file (<dir>/<namespace>.log) that is
+ * replayed into memory on first access; reads never touch the disk. Writes
+ * update memory immediately and are appended in batches by a group commit
+ * (one write + fsync per COMMIT_INTERVAL_MS), which runs on a single
+ * background thread so slow storage never stalls the event loop; one
+ * thread keeps the writes to a log in order. Entries passed to a single
+ * put() share one checksummed record, so they reach the disk all or nothing.
+ * A log that has grown well past its live data is rewritten as a snapshot.
+ *
+ * Record layout (little-endian):
+ *   u32 payloadLength | u32 crc32(payload) | payload
+ *   payload = { u32 keyLength | key (UTF-8) | u32 valueLength | value }*
+ *
+ * Namespaces written by the old one-file-per-key layout (<dir>/<ns>/<key>.json)
+ * are imported on first access.
+ */
+class KeyValueStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit KeyValueStore(const QString &dir, QObject *parent = nullptr);
+    ~KeyValueStore() override;
+
+    static bool isValidName(const QString &name);
+
+    // Null QByteArray for a missing key
+    QByteArray value(const QString &ns, const QString &key);
+    // All keys of the namespace if keys is empty; missing keys are omitted
+    QHash<QString, QByteArray> values(const QString &ns, const QStringList &keys = {});
+
+    void put(const QString &ns, const QString &key, const QByteArray &value);
+    void put(const QString &ns, const QHash<QString, QByteArray> &entries);
+
+    // Commit all pending writes now and wait until they are on disk
+    void flush();
+
+private:
+    struct Namespace {
+        QHash<QString, QByteArray> values;
+        QByteArray pending;
+        qint64 logSize = 0;
+        qint64 liveSize = 0;
+        bool needsSnapshot = false;   // An append failed; rewrite the whole log
+    };
+
+    Namespace &load(const QString &ns);
+    void replay(Namespace &space, const QString &path);
+    void importLegacy(Namespace &space, const QString &ns);
+    void commitPending();
+    void commit(const QString &ns, Namespace &space);
+    void compact(const QString &ns, Namespace &space, const QString &removeAfter = QString());
+    void commitFailed(const QString &ns);
+    QString logPath(const QString &ns) const;
+
+    QString m_dir;
+    QHash<QString, Namespace> m_namespaces;
+    QTimer m_commitTimer;
+    QThreadPool m_ioThread;     // One thread, so commits land in order
+
+    static constexpr int COMMIT_INTERVAL_MS = 50;
+    static constexpr int COMMIT_THRESHOLD = 64 * 1024;
+    static constexpr qint64 COMPACT_MIN_SIZE = 256 * 1024;
+};
+
+#endif // KEYVALUESTORE_H
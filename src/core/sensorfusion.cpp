@@ -0,0 +1,138 @@
+#include "sensorfusion.h"
+
+#include <QLoggingCategory>
+#include <QtGlobal>
+
+Q_LOGGING_CATEGORY(lcFusion, "bridge.fusion")
+
+namespace {
+
+// Output lags real time by this much so the reading after each tick is
+// usually in; covers the DE1's ~5 Hz shot samples with some BLE jitter
+constexpr qint64 DELAY_MS = 250;
+// Past its last reading a field holds its value this long, then drops out
+constexpr qint64 HOLD_MS = 1000;
+
+} // namespace
+
+void SensorFusion::Series::append(qint64 t, double value)
+{
+    points[head] = {t, value};
+    head = (head + 1) % CAPACITY;
+    if (count < CAPACITY) {
+        ++count;
+    }
+}
+
+const SensorFusion::Series::Point &SensorFusion::Series::at(int i) const
+{
+    return points[(head - count + i + CAPACITY) % CAPACITY];
+}
+
+bool SensorFusion::Series::valueAt(qint64 t, double &out) const
+{
+    if (count == 0 || t < at(0).t) {
+        return false;
+    }
+
+    const Point &last = at(count - 1);
+    if (t >= last.t) {
+        if (t - last.t > HOLD_MS) {
+            return false;
+        }
+        out = last.value;
+        return true;
+    }
+
+    // Newest first: the tick time is almost always near the end
+    for (int i = count - 1; i > 0; --i) {
+        const Point &before = at(i - 1);
+        if (before.t <= t) {
+            const Point &after = at(i);
+            if (after.t == before.t) {
+                out = after.value;
+            } else {
+                double f = double(t - before.t) / double(after.t - before.t);
+                out = before.value + f * (after.value - before.value);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+SensorFusion::SensorFusion(QObject *parent)
+    : QObject(parent)
+{
+    m_clock.start();
+    m_clockStart = QDateTime::currentDateTimeUtc();
+    m_timer.setTimerType(Qt::PreciseTimer);
+    m_timer.setInterval(1000 / m_rate);
+    connect(&m_timer, &QTimer::timeout, this, &SensorFusion::tick);
+}
+
+void SensorFusion::setRate(int hz)
+{
+    hz = qBound(1, hz, 50);
+    if (hz == m_rate) return;
+
+    qCInfo(lcFusion) << "Fusion rate" << hz << "Hz";
+    m_rate = hz;
+    m_timer.setInterval(1000 / m_rate);
+}
+
+void SensorFusion::addValue(const QString &source, const QString &field, double value)
+{
+    m_lastInput = m_clock.elapsed();
+    m_sources[source][field].append(m_lastInput, value);
+
+    if (!m_timer.isActive()) {
+        m_timer.start();
+    }
+}
+
+void SensorFusion::removeSource(const QString &source)
+{
+    m_sources.remove(source);
+}
+
+void SensorFusion::tick()
+{
+    const qint64 now = m_clock.elapsed();
+    if (now - m_lastInput > DELAY_MS + HOLD_MS) {
+        // Every field has dropped out; wait for the next reading
+        m_timer.stop();
+        return;
+    }
+
+    // Snap to the rate's grid so records are evenly spaced despite timer jitter
+    const qint64 period = 1000 / m_rate;
+    const qint64 t = (now - DELAY_MS) / period * period;
+    if (t <= m_lastTick) {
+        return;
+    }
+    m_lastTick = t;
+
+    QJsonObject sources;
+    for (auto source = m_sources.cbegin(); source != m_sources.cend(); ++source) {
+        QJsonObject fields;
+        for (auto field = source->cbegin(); field != source->cend(); ++field) {
+            double value;
+            if (field->valueAt(t, value)) {
+                fields[field.key()] = value;
+            }
+        }
+        if (!fields.isEmpty()) {
+            sources[source.key()] = fields;
+        }
+    }
+    if (sources.isEmpty()) {
+        return;
+    }
+
+    QJsonObject sample;
+    sample["timestamp"] = m_clockStart.addMSecs(t).toString(Qt::ISODateWithMs);
+    sample["rate"] = m_rate;
+    sample["sources"] = sources;
+    emit sampleFused(sample);
+}
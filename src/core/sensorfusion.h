@@ -0,0 +1,75 @@
+#ifndef SENSORFUSION_H
+#define SENSORFUSION_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QMap>
+#include <QTimer>
+#include <array>
+
+/**
+ * @brief Resamples readings from all devices onto one clock
+ *
+ * DE1 shot samples, scale weights and external sensor channels arrive at
+ * their own rates and are stamped on arrival with a monotonic clock. Each
+ * field keeps a short ring buffer; on every tick the fields are linearly
+ * interpolated at a common time slightly in the past (so the sample after
+ * it has usually arrived) and published as one merged record:
+ *
+ *   { "timestamp": ..., "rate": 10,
+ *     "sources": { "de1": {"pressure": ...}, "scale": {"weight": ...}, ... } }
+ *
+ * The tick timer only runs while readings keep arriving. A field with no
+ * reading for HOLD_MS is left out of the record.
+ */
+class SensorFusion : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SensorFusion(QObject *parent = nullptr);
+
+    // Output rate in Hz (1-50)
+    int rate() const { return m_rate; }
+    void setRate(int hz);
+
+    // A reading taken now
+    void addValue(const QString &source, const QString &field, double value);
+    // Forget a source, e.g. when its device disconnects
+    void removeSource(const QString &source);
+
+signals:
+    void sampleFused(const QJsonObject &sample);
+
+private:
+    struct Series {
+        struct Point {
+            qint64 t = 0;       // ms on m_clock
+            double value = 0;
+        };
+        static constexpr int CAPACITY = 32;
+
+        std::array<Point, CAPACITY> points;
+        int head = 0;   // Next write position
+        int count = 0;
+
+        void append(qint64 t, double value);
+        const Point &at(int i) const;   // 0 = oldest
+        // False if t is before the first reading or too long after the last
+        bool valueAt(qint64 t, double &out) const;
+    };
+
+    void tick();
+
+    QElapsedTimer m_clock;
+    QDateTime m_clockStart;     // Wall time at m_clock zero, for timestamps
+    QTimer m_timer;
+    QMap<QString, QMap<QString, Series>> m_sources;
+    int m_rate = 10;
+    qint64 m_lastInput = 0;
+    qint64 m_lastTick = -1;
+};
+
+#endif // SENSORFUSION_H
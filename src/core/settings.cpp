@@ -4,12 +4,53 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QLoggingCategory>
+#include <QSaveFile>
 
 Q_LOGGING_CATEGORY(lcSettings, "bridge.settings")
 
+namespace {
+
+// QSaveFile writes next to the target and renames over it on commit
+bool writeAtomically(const QString &path, const QByteArray &data)
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(lcSettings) << "Failed to write config file:" << path << file.errorString();
+        return false;
+    }
+    file.write(data);
+    if (!file.commit()) {
+        qCWarning(lcSettings) << "Failed to replace config file:" << path << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
 Settings::Settings(QObject *parent)
     : QObject(parent)
+    , m_saveTimer(this)
+{
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(SAVE_DELAY_MS);
+    connect(&m_saveTimer, &QTimer::timeout, this, &Settings::save);
+    m_saveThread.setMaxThreadCount(1);
+}
+
+Settings::~Settings()
 {
+    flush();
+}
+
+void Settings::markChanged()
+{
+    m_version.fetch_add(1, std::memory_order_release);
+    emit settingsChanged();
+
+    if (!m_storagePath.isEmpty()) {
+        m_saveTimer.start();
+    }
 }
 
 void Settings::setBridgeName(const QString &name)
@@ -17,25 +58,51 @@ void Settings::setBridgeName(const QString &name)
     if (m_bridgeName != name) {
         m_bridgeName = name;
         emit bridgeNameChanged();
-        emit settingsChanged();
+        markChanged();
     }
 }
 
 void Settings::setHttpPort(int port)
 {
+    m_savedValues.remove("httpPort");
     if (m_httpPort != port) {
         m_httpPort = port;
         emit httpPortChanged();
-        emit settingsChanged();
+        markChanged();
     }
 }
 
 void Settings::setWebSocketPort(int port)
 {
+    m_savedValues.remove("webSocketPort");
+    if (m_webSocketPort != port) {
+        m_webSocketPort = port;
+        emit webSocketPortChanged();
+        markChanged();
+    }
+}
+
+void Settings::overrideHttpPort(int port)
+{
+    if (!m_savedValues.contains("httpPort")) {
+        m_savedValues["httpPort"] = m_httpPort;
+    }
+    if (m_httpPort != port) {
+        m_httpPort = port;
+        m_version.fetch_add(1, std::memory_order_release);
+        emit httpPortChanged();
+    }
+}
+
+void Settings::overrideWebSocketPort(int port)
+{
+    if (!m_savedValues.contains("webSocketPort")) {
+        m_savedValues["webSocketPort"] = m_webSocketPort;
+    }
     if (m_webSocketPort != port) {
         m_webSocketPort = port;
+        m_version.fetch_add(1, std::memory_order_release);
         emit webSocketPortChanged();
-        emit settingsChanged();
     }
 }
 
@@ -44,7 +111,7 @@ void Settings::setAutoConnect(bool enable)
     if (m_autoConnect != enable) {
         m_autoConnect = enable;
         emit autoConnectChanged();
-        emit settingsChanged();
+        markChanged();
     }
 }
 
@@ -53,7 +120,7 @@ void Settings::setDe1Address(const QString &address)
     if (m_de1Address != address) {
         m_de1Address = address;
         emit de1AddressChanged();
-        emit settingsChanged();
+        markChanged();
     }
 }
 
@@ -61,7 +128,7 @@ void Settings::setAutoConnectScale(bool enable)
 {
     if (m_autoConnectScale != enable) {
         m_autoConnectScale = enable;
-        emit settingsChanged();
+        markChanged();
     }
 }
 
@@ -69,7 +136,7 @@ void Settings::setTargetWeight(double weight)
 {
     if (!qFuzzyCompare(m_targetWeight, weight)) {
         m_targetWeight = weight;
-        emit settingsChanged();
+        markChanged();
     }
 }
 
@@ -77,7 +144,15 @@ void Settings::setWeightFlowMultiplier(double multiplier)
 {
     if (!qFuzzyCompare(m_weightFlowMultiplier, multiplier)) {
         m_weightFlowMultiplier = multiplier;
-        emit settingsChanged();
+        markChanged();
+    }
+}
+
+void Settings::setFusionRate(int hz)
+{
+    if (m_fusionRate != hz) {
+        m_fusionRate = hz;
+        markChanged();
     }
 }
 
@@ -114,13 +189,16 @@ bool Settings::loadFromFile(const QString &path)
         m_targetWeight = obj["targetWeight"].toDouble();
     if (obj.contains("weightFlowMultiplier"))
         m_weightFlowMultiplier = obj["weightFlowMultiplier"].toDouble();
+    if (obj.contains("fusionRate"))
+        m_fusionRate = obj["fusionRate"].toInt();
 
     qCInfo(lcSettings) << "Loaded settings from" << path;
+    m_version.fetch_add(1, std::memory_order_release);
     emit settingsChanged();
     return true;
 }
 
-bool Settings::saveToFile(const QString &path)
+QJsonObject Settings::toJson() const
 {
     QJsonObject obj;
     obj["bridgeName"] = m_bridgeName;
@@ -131,14 +209,53 @@ bool Settings::saveToFile(const QString &path)
     obj["de1Address"] = m_de1Address;
     obj["targetWeight"] = m_targetWeight;
     obj["weightFlowMultiplier"] = m_weightFlowMultiplier;
+    obj["fusionRate"] = m_fusionRate;
+    return obj;
+}
 
-    QFile file(path);
-    if (!file.open(QIODevice::WriteOnly)) {
-        qCWarning(lcSettings) << "Failed to write config file:" << path;
-        return false;
+// toJson() with overridden keys put back to the values they replaced
+QJsonObject Settings::persistedJson() const
+{
+    QJsonObject obj = toJson();
+    for (auto it = m_savedValues.constBegin(); it != m_savedValues.constEnd(); ++it) {
+        obj[it.key()] = it.value();
     }
+    return obj;
+}
 
-    file.write(QJsonDocument(obj).toJson(QJsonDocument::Indented));
+bool Settings::saveToFile(const QString &path)
+{
+    if (!writeAtomically(path, QJsonDocument(persistedJson()).toJson(QJsonDocument::Indented))) {
+        return false;
+    }
     qCInfo(lcSettings) << "Saved settings to" << path;
     return true;
 }
+
+void Settings::setStoragePath(const QString &path)
+{
+    m_storagePath = path;
+}
+
+void Settings::save()
+{
+    if (m_storagePath.isEmpty()) return;
+
+    // Serialize here so the worker only touches its own copy
+    const QString path = m_storagePath;
+    const QByteArray data = QJsonDocument(persistedJson()).toJson(QJsonDocument::Indented);
+    m_saveThread.start([path, data]() {
+        if (writeAtomically(path, data)) {
+            qCDebug(lcSettings) << "Saved settings to" << path;
+        }
+    });
+}
+
+void Settings::flush()
+{
+    if (m_saveTimer.isActive()) {
+        m_saveTimer.stop();
+        save();
+    }
+    m_saveThread.waitForDone();
+}
@@ -2,10 +2,28 @@
 #define SETTINGS_H
 
 #include <QObject>
+#include <QJsonObject>
 #include <QString>
+#include <QThreadPool>
+#include <QTimer>
+#include <atomic>
 
 /**
  * @brief Application settings for DecentBridge
+ *
+ * With a storage path set, changes are written back to it SAVE_DELAY_MS
+ * after the last one, so a burst of edits (a slider being dragged) costs
+ * one write. Writes go to a temporary file that replaces the config by
+ * rename, on a background thread, so a crash mid-write leaves the previous
+ * config intact and the event loop never waits on storage.
+ *
+ * The debounce timer and the serialization run on the thread the Settings
+ * object lives in, which must be the thread that changes it: on Android
+ * main() moves it to the bridge thread, since the main thread is suspended
+ * while the app is in the background.
+ *
+ * version() increases on every change; readers can cache anything derived
+ * from the settings and rebuild it only when the version moves.
  */
 class Settings : public QObject
 {
@@ -19,6 +37,7 @@ class Settings : public QObject
 
 public:
     explicit Settings(QObject *parent = nullptr);
+    ~Settings() override;
 
     // Bridge identity
     QString bridgeName() const { return m_bridgeName; }
@@ -31,6 +50,10 @@ public:
     int webSocketPort() const { return m_webSocketPort; }
     void setWebSocketPort(int port);
 
+    // Command-line overrides: used for this run, never written back
+    void overrideHttpPort(int port);
+    void overrideWebSocketPort(int port);
+
     // BLE settings
     bool autoConnect() const { return m_autoConnect; }
     void setAutoConnect(bool enable);
@@ -49,9 +72,20 @@ public:
     double weightFlowMultiplier() const { return m_weightFlowMultiplier; }
     void setWeightFlowMultiplier(double multiplier);
 
+    // Records per second on the fused sensor stream
+    int fusionRate() const { return m_fusionRate; }
+    void setFusionRate(int hz);
+
     // Persistence
     bool loadFromFile(const QString &path);
     bool saveToFile(const QString &path);
+    // Save changes made from now on to this file; empty disables saving
+    void setStoragePath(const QString &path);
+    // Write a pending change now and wait for it
+    void flush();
+
+    quint64 version() const { return m_version.load(std::memory_order_acquire); }
+    QJsonObject toJson() const;
 
 signals:
     void bridgeNameChanged();
@@ -62,6 +96,18 @@ signals:
     void settingsChanged();
 
 private:
+    void markChanged();
+    void save();
+    QJsonObject persistedJson() const;
+
+    static constexpr int SAVE_DELAY_MS = 500;
+
+    QString m_storagePath;
+    QTimer m_saveTimer;         // Child, so it follows moveToThread()
+    QThreadPool m_saveThread;   // One thread, so writes land in order
+    std::atomic<quint64> m_version{1};
+    QJsonObject m_savedValues;  // What to write back for overridden keys
+
     QString m_bridgeName = "DecentBridge";
     int m_httpPort = 8080;
     int m_webSocketPort = 8081;
@@ -70,6 +116,7 @@ private:
     QString m_de1Address;
     double m_targetWeight = 36.0;
     double m_weightFlowMultiplier = 1.0;
+    int m_fusionRate = 10;
 };
 
 #endif // SETTINGS_H
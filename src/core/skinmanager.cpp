@@ -1,17 +1,34 @@
 #include "skinmanager.h"
+#include "zipfilesystem.h"
 
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
+#include <QHash>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QLoggingCategory>
 #include <QNetworkReply>
 #include <QNetworkRequest>
+#include <QPointer>
+#include <QResource>
 #include <QStandardPaths>
+#include <QRegularExpression>
+#include <QThreadPool>
+#include <QTimer>
 
+#include <filesystem>
 #include <miniz.h>
 
+#if defined(Q_OS_LINUX) || defined(Q_OS_ANDROID)
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(Q_OS_DARWIN)
+#include <stdio.h>
+#endif
+
 Q_LOGGING_CATEGORY(lcSkin, "bridge.skin")
 
 const QString SkinManager::SKIN_ZIP_URL =
@@ -19,6 +36,7 @@ const QString SkinManager::SKIN_ZIP_URL =
 
 SkinManager::SkinManager(QObject *parent)
     : QObject(parent)
+    , m_sourceUrl(SKIN_ZIP_URL)
 {
 }
 
@@ -34,32 +52,36 @@ void SkinManager::initialize()
         qCInfo(lcSkin) << "Cached skin found at" << skinDir();
         emit skinReady();
     } else {
-        // No cached skin — extract the bundled version for immediate use
-        extractBundledSkin();
+        // No cached skin — serve the bundled version straight from the zip
+        openBundledSkin();
     }
 
     // Check for updates in background
     checkForUpdate();
 }
 
-void SkinManager::extractBundledSkin()
+void SkinManager::openBundledSkin()
 {
-    QFile bundled(":/assets/skin.zip");
-    if (!bundled.open(QIODevice::ReadOnly)) {
+    QElapsedTimer timer;
+    timer.start();
+
+    QResource resource(":/assets/skin.zip");
+    if (!resource.isValid()) {
         qCWarning(lcSkin) << "No bundled skin.zip resource found";
         return;
     }
 
-    QByteArray data = bundled.readAll();
-    qCInfo(lcSkin) << "Extracting bundled skin (" << data.size() << "bytes)";
-
-    if (extractZipFromMemory(data, skinDir())) {
-        m_skinAvailable = true;
-        qCInfo(lcSkin) << "Bundled skin extracted to" << skinDir();
-        emit skinReady();
-    } else {
-        qCWarning(lcSkin) << "Failed to extract bundled skin";
+    auto archive = std::make_shared<ZipFileSystem>();
+    if (!archive->open(resource.uncompressedData()) || !archive->contains("index.html")) {
+        qCWarning(lcSkin) << "Bundled skin.zip is not a usable skin archive";
+        return;
     }
+
+    m_bundledSkin = archive;
+    m_skinAvailable = true;
+    qCInfo(lcSkin) << "Serving bundled skin from archive (" << archive->fileCount()
+                   << "files, indexed in" << timer.elapsed() << "ms)";
+    emit skinReady();
 }
 
 QString SkinManager::skinRootPath() const
@@ -87,6 +109,31 @@ QString SkinManager::zipTempPath() const
     return skinBaseDir() + "/download.zip";
 }
 
+QString SkinManager::downloadEtagPath() const
+{
+    return zipTempPath() + ".etag";
+}
+
+// SHA-256 announced by the server via Repr-Digest (RFC 9530) or Digest (RFC 3230).
+// Best-effort only: GitHub sends neither for branch archives, and a branch
+// archive has no published hash to check against. What guards the install is
+// If-Range (a resume only continues the same ETag) and installZip(), which
+// validates every entry's CRC32 before anything on disk is replaced.
+QByteArray SkinManager::expectedSha256(const QNetworkReply *reply)
+{
+    static const QRegularExpression reprDigest(QStringLiteral("sha-256=:([A-Za-z0-9+/=]+):"),
+                                               QRegularExpression::CaseInsensitiveOption);
+    static const QRegularExpression digest(QStringLiteral("sha-256=([A-Za-z0-9+/=]+)"),
+                                           QRegularExpression::CaseInsensitiveOption);
+
+    auto match = reprDigest.match(QString::fromLatin1(reply->rawHeader("Repr-Digest")));
+    if (!match.hasMatch()) {
+        match = digest.match(QString::fromLatin1(reply->rawHeader("Digest")));
+    }
+    if (!match.hasMatch()) return {};
+    return QByteArray::fromBase64(match.captured(1).toLatin1());
+}
+
 void SkinManager::loadMetadata()
 {
     QFile file(metadataPath());
@@ -117,7 +164,7 @@ void SkinManager::checkForUpdate()
 {
     qCInfo(lcSkin) << "Checking for skin updates...";
 
-    QNetworkRequest request{QUrl(SKIN_ZIP_URL)};
+    QNetworkRequest request{m_sourceUrl};
     request.setAttribute(QNetworkRequest::RedirectPolicyAttribute,
                          QNetworkRequest::NoLessSafeRedirectPolicy);
 
@@ -157,56 +204,285 @@ void SkinManager::checkForUpdate()
 
 void SkinManager::downloadSkin()
 {
-    qCInfo(lcSkin) << "Downloading skin from" << SKIN_ZIP_URL;
+    QDir().mkpath(skinBaseDir());
 
-    QNetworkRequest request{QUrl(SKIN_ZIP_URL)};
+    // A partial download can be resumed only if it belongs to the same ETag
+    QFile etagFile(downloadEtagPath());
+    QString partialEtag;
+    if (etagFile.open(QIODevice::ReadOnly)) {
+        partialEtag = QString::fromLatin1(etagFile.readAll());
+        etagFile.close();
+    }
+
+    m_downloadFile = std::make_unique<QFile>(zipTempPath());
+    m_downloadHash.reset();
+
+    qint64 resumeFrom = 0;
+    if (!m_etag.isEmpty() && partialEtag == m_etag && m_downloadFile->exists()) {
+        resumeFrom = m_downloadFile->size();
+    } else {
+        m_downloadFile->remove();
+        if (etagFile.open(QIODevice::WriteOnly)) {
+            etagFile.write(m_etag.toLatin1());
+            etagFile.close();
+        }
+    }
+
+    if (!m_downloadFile->open(QIODevice::ReadWrite)) {
+        qCWarning(lcSkin) << "Failed to write zip file:" << zipTempPath();
+        emit skinUpdateFailed("Failed to write zip file");
+        return;
+    }
+
+    // Seed the hash with what is already on disk, then continue at the end
+    if (resumeFrom > 0) {
+        m_downloadHash.addData(m_downloadFile.get());
+        qCInfo(lcSkin) << "Resuming skin download at" << resumeFrom << "bytes";
+    }
+    m_downloadFile->seek(resumeFrom);
+
+    qCInfo(lcSkin) << "Downloading skin from" << m_sourceUrl.toString();
+
+    QNetworkRequest request{m_sourceUrl};
     request.setAttribute(QNetworkRequest::RedirectPolicyAttribute,
                          QNetworkRequest::NoLessSafeRedirectPolicy);
+    if (resumeFrom > 0) {
+        request.setRawHeader("Range", "bytes=" + QByteArray::number(resumeFrom) + "-");
+        request.setRawHeader("If-Range", m_etag.toLatin1());
+    }
 
     auto *reply = m_nam->get(request);
+    reply->setReadBufferSize(DOWNLOAD_CHUNK_SIZE);
+
+    // metaDataChanged can fire more than once per reply (e.g. on redirects or
+    // trailers); the file must be truncated only before the first body byte
+    connect(reply, &QNetworkReply::metaDataChanged, this,
+            [this, reply, resumeFrom, restarted = false]() mutable {
+        int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (resumeFrom > 0 && status == 200 && !restarted) {
+            restarted = true;
+            // Server ignored the range (or the skin changed): start over
+            qCInfo(lcSkin) << "Server sent the full skin, restarting download";
+            m_downloadFile->resize(0);
+            m_downloadFile->seek(0);
+            m_downloadHash.reset();
+        }
+    });
+
+    connect(reply, &QNetworkReply::readyRead, this, [this, reply]() {
+        int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (status != 200 && status != 206) return;
+
+        while (reply->bytesAvailable() > 0) {
+            QByteArray chunk = reply->read(DOWNLOAD_CHUNK_SIZE);
+            if (m_downloadFile->write(chunk) != chunk.size()) {
+                qCWarning(lcSkin) << "Failed to write zip file:" << zipTempPath();
+                reply->abort();
+                return;
+            }
+            m_downloadHash.addData(chunk);
+        }
+    });
+
     connect(reply, &QNetworkReply::finished, this, [this, reply]() {
         reply->deleteLater();
 
-        if (reply->error() != QNetworkReply::NoError) {
-            qCWarning(lcSkin) << "Download failed:" << reply->errorString();
-            emit skinUpdateFailed(reply->errorString());
-            return;
-        }
+        int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        qint64 received = m_downloadFile->size();
+        m_downloadFile->close();
 
-        QByteArray data = reply->readAll();
-        qCInfo(lcSkin) << "Downloaded" << data.size() << "bytes";
+        if (status == 416) {
+            // Our partial file is not a prefix of what the server has
+            QFile::remove(zipTempPath());
+            QFile::remove(downloadEtagPath());
+        }
 
-        // Save zip to temp file
-        QDir().mkpath(skinBaseDir());
-        QFile zipFile(zipTempPath());
-        if (!zipFile.open(QIODevice::WriteOnly)) {
-            qCWarning(lcSkin) << "Failed to write zip file:" << zipTempPath();
-            emit skinUpdateFailed("Failed to write zip file");
+        if (reply->error() != QNetworkReply::NoError || status == 416) {
+            qCWarning(lcSkin) << "Download failed:" << reply->errorString()
+                              << "(" << received << "bytes on disk)";
+            if (++m_downloadAttempts < MAX_DOWNLOAD_ATTEMPTS) {
+                int delayMs = 2000 * m_downloadAttempts;
+                qCInfo(lcSkin) << "Retrying skin download in" << delayMs << "ms";
+                QTimer::singleShot(delayMs, this, &SkinManager::downloadSkin);
+                return;
+            }
+            m_downloadAttempts = 0;
+            emit skinUpdateFailed(reply->errorString());
             return;
         }
-        zipFile.write(data);
-        zipFile.close();
-
-        // Extract
-        if (!extractZip(zipTempPath(), skinDir())) {
-            qCWarning(lcSkin) << "Failed to extract skin zip";
-            emit skinUpdateFailed("Failed to extract zip");
+        m_downloadAttempts = 0;
+
+        QByteArray sha256 = m_downloadHash.result();
+        QByteArray expected = expectedSha256(reply);
+        if (!expected.isEmpty() && expected != sha256) {
+            qCWarning(lcSkin) << "Downloaded skin failed SHA-256 verification";
+            QFile::remove(zipTempPath());
+            QFile::remove(downloadEtagPath());
+            emit skinUpdateFailed("Checksum mismatch");
             return;
         }
 
-        saveMetadata();
-        m_skinAvailable = true;
-        qCInfo(lcSkin) << "Skin installed at" << skinDir();
-        emit skinReady();
+        qCInfo(lcSkin) << "Downloaded" << received << "bytes, sha256" << sha256.toHex()
+                       << (expected.isEmpty() ? "(no digest from server, relying on zip CRCs)" : "(verified)");
+        QFile::remove(downloadEtagPath());
+
+        // Extract off the event loop; only changed files are rewritten and
+        // the live skin directory is swapped in one step at the end
+        const QString zipPath = zipTempPath();
+        const QString destDir = skinDir();
+        QPointer<SkinManager> self(this);
+
+        QThreadPool::globalInstance()->start([self, zipPath, destDir]() {
+            bool ok = installZip(zipPath, destDir);
+
+            if (!self) return;
+            QMetaObject::invokeMethod(self, [self, ok]() {
+                if (!self) return;
+                if (!ok) {
+                    qCWarning(lcSkin) << "Failed to extract skin zip";
+                    emit self->skinUpdateFailed("Failed to extract zip");
+                    return;
+                }
+
+                self->saveMetadata();
+                self->m_bundledSkin.reset();
+                self->m_skinAvailable = true;
+                qCInfo(lcSkin) << "Skin installed at" << self->skinDir();
+                emit self->skinReady();
+            }, Qt::QueuedConnection);
+        });
     });
 }
 
-// Shared extraction logic — works on an already-initialized mz_zip_archive
-static bool extractZipEntries(mz_zip_archive &zip, const QString &destDir)
+namespace {
+
+struct ManifestEntry {
+    quint32 crc32 = 0;
+    qint64 size = 0;
+};
+
+using Manifest = QHash<QString, ManifestEntry>;
+
+// Stored inside the skin directory so it is swapped together with the files it
+// describes; HttpServer refuses dot-prefixed paths, so it is never served
+const QString MANIFEST_NAME = QStringLiteral(".manifest.json");
+
+Manifest loadManifest(const QString &dir)
+{
+    Manifest manifest;
+    QFile file(dir + "/" + MANIFEST_NAME);
+    if (!file.open(QIODevice::ReadOnly)) return manifest;
+
+    QJsonObject files = QJsonDocument::fromJson(file.readAll()).object()["files"].toObject();
+    for (auto it = files.begin(); it != files.end(); ++it) {
+        QJsonObject obj = it.value().toObject();
+        ManifestEntry entry;
+        entry.crc32 = quint32(obj["crc32"].toDouble());
+        entry.size = qint64(obj["size"].toDouble());
+        manifest.insert(it.key(), entry);
+    }
+    return manifest;
+}
+
+bool saveManifest(const QString &dir, const Manifest &manifest)
+{
+    QJsonObject files;
+    for (auto it = manifest.constBegin(); it != manifest.constEnd(); ++it) {
+        QJsonObject obj;
+        obj["crc32"] = double(it->crc32);
+        obj["size"] = double(it->size);
+        files[it.key()] = obj;
+    }
+
+    QJsonObject root;
+    root["files"] = files;
+
+    QFile file(dir + "/" + MANIFEST_NAME);
+    if (!file.open(QIODevice::WriteOnly)) return false;
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    return true;
+}
+
+// Reuse an unchanged file without rewriting its contents; falls back to a copy
+// where hard links are not available (e.g. FAT-formatted storage)
+bool reuseFile(const QString &from, const QString &to)
+{
+    std::error_code ec;
+    std::filesystem::create_hard_link(std::filesystem::u8path(from.toStdString()),
+                                      std::filesystem::u8path(to.toStdString()), ec);
+    return !ec || QFile::copy(from, to);
+}
+
+// CRC32 of a file on disk, to tell whether it still holds what the manifest says
+bool fileCrc32(const QString &path, quint32 &crc)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    mz_ulong value = MZ_CRC32_INIT;
+    QByteArray buffer(64 * 1024, Qt::Uninitialized);
+    qint64 n;
+    while ((n = file.read(buffer.data(), buffer.size())) > 0) {
+        value = mz_crc32(value, reinterpret_cast<const unsigned char*>(buffer.constData()), size_t(n));
+    }
+    if (n < 0) return false;
+    crc = quint32(value);
+    return true;
+}
+
+// Swap two directories in a single rename, so the path never goes missing
+// in between. False where the platform or filesystem cannot do that.
+bool exchangeDirs(const QString &a, const QString &b)
+{
+    const QByteArray pathA = QFile::encodeName(a);
+    const QByteArray pathB = QFile::encodeName(b);
+#if (defined(Q_OS_LINUX) || defined(Q_OS_ANDROID)) && defined(SYS_renameat2)
+    // Called directly: older glibc and Bionic have no renameat2() wrapper
+    constexpr unsigned RENAME_EXCHANGE_FLAG = 1u << 1;   // RENAME_EXCHANGE
+    return ::syscall(SYS_renameat2, AT_FDCWD, pathA.constData(),
+                     AT_FDCWD, pathB.constData(), RENAME_EXCHANGE_FLAG) == 0;
+#elif defined(Q_OS_DARWIN)
+    return ::renamex_np(pathA.constData(), pathB.constData(), RENAME_SWAP) == 0;
+#else
+    Q_UNUSED(pathA);
+    Q_UNUSED(pathB);
+    return false;
+#endif
+}
+
+} // namespace
+
+bool SkinManager::installZip(const QString &zipPath, const QString &destDir)
 {
+    QElapsedTimer timer;
+    timer.start();
+
+    const QString stagingDir = destDir + ".staging";
+    const QString oldDir = destDir + ".old";
+    QDir(stagingDir).removeRecursively();
+    QDir(oldDir).removeRecursively();
+    QDir().mkpath(stagingDir);
+
+    QByteArray zipPathUtf8 = zipPath.toUtf8();
+
+    mz_zip_archive zip;
+    memset(&zip, 0, sizeof(zip));
+
+    if (!mz_zip_reader_init_file(&zip, zipPathUtf8.constData(), 0)) {
+        qCWarning(lcSkin) << "Failed to open zip:" << mz_zip_get_error_string(mz_zip_get_last_error(&zip));
+        return false;
+    }
+
+    // Check every entry's CRC32 before touching anything on disk
+    if (!mz_zip_validate_archive(&zip, 0)) {
+        qCWarning(lcSkin) << "Zip failed validation:" << mz_zip_get_error_string(mz_zip_get_last_error(&zip));
+        mz_zip_reader_end(&zip);
+        QFile::remove(zipPath);
+        return false;
+    }
+
     mz_uint numFiles = mz_zip_reader_get_num_files(&zip);
 
-    // First pass: find the top-level directory prefix to strip
     // GitHub zips always have a single top-level dir like "repo-branch/"
     QString topLevelDir;
     if (numFiles > 0) {
@@ -220,8 +496,14 @@ static bool extractZipEntries(mz_zip_archive &zip, const QString &destDir)
         }
     }
 
-    // Extract all files
-    for (mz_uint i = 0; i < numFiles; i++) {
+    const Manifest current = loadManifest(destDir);
+    Manifest updated;
+    int filesWritten = 0;
+    int filesReused = 0;
+    qint64 bytesWritten = 0;
+    bool ok = true;
+
+    for (mz_uint i = 0; i < numFiles && ok; i++) {
         mz_zip_archive_file_stat stat;
         if (!mz_zip_reader_file_stat(&zip, i, &stat)) continue;
 
@@ -233,65 +515,89 @@ static bool extractZipEntries(mz_zip_archive &zip, const QString &destDir)
         }
         if (name.isEmpty()) continue;
 
-        QString outPath = destDir + "/" + name;
+        QString outPath = stagingDir + "/" + name;
 
         if (stat.m_is_directory || name.endsWith('/')) {
             QDir().mkpath(outPath);
+            continue;
+        }
+        QDir().mkpath(QFileInfo(outPath).absolutePath());
+
+        ManifestEntry entry;
+        entry.crc32 = quint32(stat.m_crc32);
+        entry.size = qint64(stat.m_uncomp_size);
+        updated.insert(name, entry);
+
+        // Unchanged per the manifest and still intact on disk: reuse. The live
+        // file is checked itself, since dev uploads write into the same tree.
+        auto known = current.constFind(name);
+        QString livePath = destDir + "/" + name;
+        quint32 liveCrc = 0;
+        if (known != current.constEnd() && known->crc32 == entry.crc32 &&
+            known->size == entry.size && QFileInfo(livePath).size() == entry.size &&
+            fileCrc32(livePath, liveCrc) && liveCrc == entry.crc32 &&
+            reuseFile(livePath, outPath)) {
+            filesReused++;
+            continue;
+        }
+
+        size_t size = 0;
+        void *data = mz_zip_reader_extract_to_heap(&zip, i, &size, 0);
+        if (!data) {
+            qCWarning(lcSkin) << "Failed to extract" << name;
+            ok = false;
+            break;
+        }
+        QFile outFile(outPath);
+        if (outFile.open(QIODevice::WriteOnly) &&
+            outFile.write(static_cast<const char*>(data), static_cast<qint64>(size)) == qint64(size)) {
+            filesWritten++;
+            bytesWritten += qint64(size);
         } else {
-            QDir().mkpath(QFileInfo(outPath).absolutePath());
-
-            size_t size = 0;
-            void *data = mz_zip_reader_extract_to_heap(&zip, i, &size, 0);
-            if (data) {
-                QFile outFile(outPath);
-                if (outFile.open(QIODevice::WriteOnly)) {
-                    outFile.write(static_cast<const char*>(data), static_cast<qint64>(size));
-                    outFile.close();
-                }
-                mz_free(data);
-            }
+            qCWarning(lcSkin) << "Failed to write" << outPath;
+            ok = false;
         }
+        mz_free(data);
     }
 
     mz_zip_reader_end(&zip);
-    return QFile::exists(destDir + "/index.html");
-}
-
-bool SkinManager::extractZip(const QString &zipPath, const QString &destDir)
-{
-    QDir(destDir).removeRecursively();
-    QDir().mkpath(destDir);
 
-    QByteArray zipPathUtf8 = zipPath.toUtf8();
-
-    mz_zip_archive zip;
-    memset(&zip, 0, sizeof(zip));
-
-    if (!mz_zip_reader_init_file(&zip, zipPathUtf8.constData(), 0)) {
-        qCWarning(lcSkin) << "Failed to open zip:" << mz_zip_get_error_string(mz_zip_get_last_error(&zip));
+    if (!ok || !QFile::exists(stagingDir + "/index.html") || !saveManifest(stagingDir, updated)) {
+        QDir(stagingDir).removeRecursively();
         return false;
     }
 
-    bool ok = extractZipEntries(zip, destDir);
+    // Swap the fully populated staging dir in place of the live one. An
+    // exchange leaves the old skin at the staging path; requests in flight
+    // see either the old or the new skin, never a missing directory.
+    if (!QFileInfo::exists(destDir)) {
+        if (!QDir().rename(stagingDir, destDir)) {
+            qCWarning(lcSkin) << "Failed to activate" << stagingDir;
+            QDir(stagingDir).removeRecursively();
+            return false;
+        }
+    } else if (exchangeDirs(stagingDir, destDir)) {
+        QDir(stagingDir).removeRecursively();
+    } else {
+        // No atomic exchange here: two renames, briefly without a skin dir
+        if (!QDir().rename(destDir, oldDir)) {
+            qCWarning(lcSkin) << "Failed to move aside" << destDir;
+            QDir(stagingDir).removeRecursively();
+            return false;
+        }
+        if (!QDir().rename(stagingDir, destDir)) {
+            qCWarning(lcSkin) << "Failed to activate" << stagingDir;
+            QDir().rename(oldDir, destDir);
+            QDir(stagingDir).removeRecursively();
+            return false;
+        }
+        QDir(oldDir).removeRecursively();
+    }
 
     // Clean up temp zip
     QFile::remove(zipPath);
 
-    return ok;
-}
-
-bool SkinManager::extractZipFromMemory(const QByteArray &data, const QString &destDir)
-{
-    QDir(destDir).removeRecursively();
-    QDir().mkpath(destDir);
-
-    mz_zip_archive zip;
-    memset(&zip, 0, sizeof(zip));
-
-    if (!mz_zip_reader_init_mem(&zip, data.constData(), data.size(), 0)) {
-        qCWarning(lcSkin) << "Failed to read zip from memory:" << mz_zip_get_error_string(mz_zip_get_last_error(&zip));
-        return false;
-    }
-
-    return extractZipEntries(zip, destDir);
+    qCInfo(lcSkin) << "Skin updated in" << timer.elapsed() << "ms:" << filesWritten << "files written ("
+                   << bytesWritten << "bytes)," << filesReused << "unchanged";
+    return true;
 }
@@ -2,15 +2,26 @@
 #define SKINMANAGER_H
 
 #include <QObject>
+#include <QCryptographicHash>
+#include <QFile>
 #include <QNetworkAccessManager>
+#include <QUrl>
+
+#include <memory>
+
+class QNetworkReply;
+class ZipFileSystem;
 
 /**
  * @brief Downloads and caches WebUI skins from GitHub
  *
  * On initialize(), checks for a cached skin on disk. If found, emits skinReady()
- * immediately. Then sends a HEAD request to GitHub to check if the skin has been
- * updated (via ETag). If updated, downloads the new zip, extracts it, and emits
- * skinReady() again.
+ * immediately; otherwise the bundled skin.zip is indexed in place and served
+ * straight from the archive via skinArchive(). Then sends a HEAD request to GitHub to check if the skin has been
+ * updated (via ETag). If updated, streams the new zip to disk (resuming interrupted
+ * downloads with a Range request) and emits skinReady() again once it is installed. Installation compares each entry's CRC32 and size with the
+ * manifest of the current skin, writes only changed files into a staging directory
+ * (unchanged ones are hard-linked) and then swaps it in for the live directory.
  *
  * Skin files are stored in QStandardPaths::AppDataLocation/skins/streamline_project/
  */
@@ -23,19 +34,24 @@ public:
 
     void initialize();
 
+    // Where the skin zip is fetched from; defaults to the GitHub branch archive
+    void setSourceUrl(const QUrl &url) { m_sourceUrl = url; }
+
     bool hasSkin() const { return m_skinAvailable; }
     QString skinRootPath() const;
 
+    // Bundled skin archive, or null once a skin has been extracted to disk
+    std::shared_ptr<const ZipFileSystem> skinArchive() const { return m_bundledSkin; }
+
 signals:
     void skinReady();
     void skinUpdateFailed(const QString &error);
 
 private:
-    void extractBundledSkin();
+    void openBundledSkin();
     void checkForUpdate();
     void downloadSkin();
-    bool extractZip(const QString &zipPath, const QString &destDir);
-    bool extractZipFromMemory(const QByteArray &data, const QString &destDir);
+    static bool installZip(const QString &zipPath, const QString &destDir);
     void loadMetadata();
     void saveMetadata();
 
@@ -43,13 +59,24 @@ private:
     QString skinDir() const;
     QString metadataPath() const;
     QString zipTempPath() const;
+    QString downloadEtagPath() const;
+    static QByteArray expectedSha256(const QNetworkReply *reply);
 
     QNetworkAccessManager *m_nam = nullptr;
+    QUrl m_sourceUrl;
     QString m_etag;
     QString m_lastModified;
     bool m_skinAvailable = false;
+    std::shared_ptr<const ZipFileSystem> m_bundledSkin;
+
+    // In-flight download, written chunk by chunk as data arrives
+    std::unique_ptr<QFile> m_downloadFile;
+    QCryptographicHash m_downloadHash{QCryptographicHash::Sha256};
+    int m_downloadAttempts = 0;
 
     static const QString SKIN_ZIP_URL;
+    static constexpr qint64 DOWNLOAD_CHUNK_SIZE = 64 * 1024;
+    static constexpr int MAX_DOWNLOAD_ATTEMPTS = 4;
 };
 
 #endif // SKINMANAGER_H
@@ -0,0 +1,62 @@
+#include "streamdemand.h"
+
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(lcDemand, "bridge.demand")
+
+StreamDemand::StreamDemand(QObject *parent)
+    : QObject(parent)
+{
+    for (int i = 0; i < STREAM_COUNT; i++) {
+        Stream stream = static_cast<Stream>(i);
+        QTimer *timer = new QTimer(this);
+        timer->setSingleShot(true);
+        connect(timer, &QTimer::timeout, this, [this, stream]() { update(stream); });
+        m_entries[i].lease = timer;
+    }
+}
+
+void StreamDemand::acquire(Stream stream)
+{
+    m_entries[index(stream)].refs++;
+    update(stream);
+}
+
+void StreamDemand::release(Stream stream)
+{
+    Entry &entry = m_entries[index(stream)];
+    if (entry.refs == 0) {
+        qCWarning(lcDemand) << "Unbalanced release of" << streamName(stream);
+        return;
+    }
+    entry.refs--;
+    update(stream);
+}
+
+void StreamDemand::lease(Stream stream)
+{
+    m_entries[index(stream)].lease->start(LEASE_MS);
+    update(stream);
+}
+
+void StreamDemand::update(Stream stream)
+{
+    Entry &entry = m_entries[index(stream)];
+    bool wanted = entry.refs > 0 || entry.lease->isActive();
+    if (wanted == entry.wanted) return;
+
+    entry.wanted = wanted;
+    qCInfo(lcDemand) << streamName(stream) << (wanted ? "wanted" : "no longer wanted");
+    emit demandChanged(stream, wanted);
+}
+
+QString StreamDemand::streamName(Stream stream)
+{
+    switch (stream) {
+    case Stream::ShotSamples: return "shot samples";
+    case Stream::WaterLevels: return "water levels";
+    case Stream::Temperatures: return "temperatures";
+    case Stream::ScaleWeight: return "scale weight";
+    }
+    return QString();
+}
@@ -0,0 +1,54 @@
+#ifndef STREAMDEMAND_H
+#define STREAMDEMAND_H
+
+#include <QObject>
+#include <QTimer>
+#include <array>
+
+/**
+ * @brief Tracks who consumes each BLE notification stream
+ *
+ * Consumers that stay attached (WebSocket clients, the on-screen dashboard)
+ * hold a reference with acquire()/release(). Polling clients cannot say when
+ * they leave, so each request takes a lease that keeps the stream on for
+ * LEASE_MS after the last poll. A stream is wanted while it has a reference
+ * or a running lease; demandChanged() fires on every transition, and the
+ * bridge turns the matching GATT notifications on or off.
+ */
+class StreamDemand : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Stream { ShotSamples, WaterLevels, Temperatures, ScaleWeight };
+    static constexpr int STREAM_COUNT = 4;
+
+    explicit StreamDemand(QObject *parent = nullptr);
+
+    void acquire(Stream stream);
+    void release(Stream stream);
+    void lease(Stream stream);
+
+    bool isWanted(Stream stream) const { return m_entries[index(stream)].wanted; }
+
+    static QString streamName(Stream stream);
+
+signals:
+    void demandChanged(StreamDemand::Stream stream, bool wanted);
+
+private:
+    struct Entry {
+        int refs = 0;
+        bool wanted = false;
+        QTimer *lease = nullptr;
+    };
+
+    static int index(Stream stream) { return static_cast<int>(stream); }
+    void update(Stream stream);
+
+    std::array<Entry, STREAM_COUNT> m_entries;
+
+    static constexpr int LEASE_MS = 30000;
+};
+
+#endif // STREAMDEMAND_H
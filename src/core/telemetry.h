@@ -0,0 +1,69 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "ble/protocol/de1characteristics.h"
+
+#include <array>
+#include <atomic>
+
+/**
+ * @brief Latest machine and scale readings as plain values
+ */
+struct Telemetry {
+    // Machine
+    DE1::State state = DE1::State::Sleep;
+    DE1::SubState subState = DE1::SubState::Ready;
+    double pressure = 0;
+    double flow = 0;
+    double groupTemp = 0;
+    double steamTemp = 0;
+
+    // Scale
+    double scaleWeight = 0;
+    double scaleFlow = 0;
+};
+
+/**
+ * @brief Lock-free hand-off of the latest Telemetry between two threads
+ *
+ * One writer publishes, one reader takes. Each side owns a private buffer
+ * and swaps it with a shared middle slot through a single atomic exchange,
+ * so neither side ever waits and the reader always gets the newest
+ * complete snapshot; intermediate ones are dropped, not queued.
+ */
+class TelemetryBuffer
+{
+public:
+    // Writer side. True if the reader had taken the previous snapshot,
+    // i.e. this is the first unseen one and the reader may need waking.
+    bool publish(const Telemetry &telemetry)
+    {
+        m_buffers[m_back] = telemetry;
+        int previous = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel);
+        m_back = previous & INDEX_MASK;
+        return !(previous & FRESH);
+    }
+
+    // Reader side. False (and out untouched) if nothing new was published.
+    bool take(Telemetry &out)
+    {
+        if (!(m_middle.load(std::memory_order_relaxed) & FRESH)) {
+            return false;
+        }
+        int previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = previous & INDEX_MASK;
+        out = m_buffers[m_front];
+        return true;
+    }
+
+private:
+    static constexpr int INDEX_MASK = 0x3;
+    static constexpr int FRESH = 0x4;
+
+    std::array<Telemetry, 3> m_buffers;
+    std::atomic<int> m_middle{1};
+    int m_back = 0;     // Writer only
+    int m_front = 2;    // Reader only
+};
+
+#endif // TELEMETRY_H
@@ -0,0 +1,146 @@
+#include "zipfilesystem.h"
+
+#include <QLoggingCategory>
+
+#include <cstring>
+#include <miniz.h>
+
+Q_LOGGING_CATEGORY(lcZipFs, "bridge.zipfs")
+
+namespace {
+
+constexpr quint32 LOCAL_HEADER_SIGNATURE = 0x04034b50;
+constexpr int LOCAL_HEADER_SIZE = 30;
+
+quint16 readU16(const char *p)
+{
+    auto *b = reinterpret_cast<const uchar *>(p);
+    return quint16(b[0] | (b[1] << 8));
+}
+
+quint32 readU32(const char *p)
+{
+    auto *b = reinterpret_cast<const uchar *>(p);
+    return quint32(b[0]) | (quint32(b[1]) << 8) | (quint32(b[2]) << 16) | (quint32(b[3]) << 24);
+}
+
+void appendU32(QByteArray &out, quint32 v)
+{
+    out.append(char(v & 0xFF));
+    out.append(char((v >> 8) & 0xFF));
+    out.append(char((v >> 16) & 0xFF));
+    out.append(char((v >> 24) & 0xFF));
+}
+
+} // namespace
+
+bool ZipFileSystem::open(const QByteArray &archive)
+{
+    m_archive.clear();
+    m_entries.clear();
+
+    mz_zip_archive zip;
+    memset(&zip, 0, sizeof(zip));
+
+    if (!mz_zip_reader_init_mem(&zip, archive.constData(), size_t(archive.size()), 0)) {
+        qCWarning(lcZipFs) << "Failed to read zip central directory:"
+                           << mz_zip_get_error_string(mz_zip_get_last_error(&zip));
+        return false;
+    }
+
+    mz_uint numFiles = mz_zip_reader_get_num_files(&zip);
+
+    // GitHub zips always have a single top-level dir like "repo-branch/"
+    QString topLevelDir;
+    if (numFiles > 0) {
+        mz_zip_archive_file_stat stat;
+        if (mz_zip_reader_file_stat(&zip, 0, &stat)) {
+            QString name = QString::fromUtf8(stat.m_filename);
+            int slashIdx = name.indexOf('/');
+            if (slashIdx > 0) {
+                topLevelDir = name.left(slashIdx + 1);
+            }
+        }
+    }
+
+    m_entries.reserve(int(numFiles));
+    for (mz_uint i = 0; i < numFiles; i++) {
+        mz_zip_archive_file_stat stat;
+        if (!mz_zip_reader_file_stat(&zip, i, &stat)) continue;
+        if (stat.m_is_directory || stat.m_is_encrypted || !stat.m_is_supported) continue;
+        if (stat.m_method != 0 && stat.m_method != MZ_DEFLATED) continue;
+
+        QString name = QString::fromUtf8(stat.m_filename);
+        if (!topLevelDir.isEmpty() && name.startsWith(topLevelDir)) {
+            name = name.mid(topLevelDir.length());
+        }
+        if (name.isEmpty() || name.endsWith('/')) continue;
+
+        // The data offset lives in the local header, whose name/extra
+        // lengths may differ from the central directory copy
+        qint64 headerOffset = qint64(stat.m_local_header_ofs);
+        if (headerOffset + LOCAL_HEADER_SIZE > archive.size()) continue;
+        const char *header = archive.constData() + headerOffset;
+        if (readU32(header) != LOCAL_HEADER_SIGNATURE) continue;
+
+        Entry entry;
+        entry.dataOffset = headerOffset + LOCAL_HEADER_SIZE + readU16(header + 26) + readU16(header + 28);
+        entry.compressedSize = qint64(stat.m_comp_size);
+        entry.size = qint64(stat.m_uncomp_size);
+        entry.crc32 = quint32(stat.m_crc32);
+        entry.deflated = stat.m_method == MZ_DEFLATED;
+        if (entry.dataOffset + entry.compressedSize > archive.size()) continue;
+
+        m_entries.insert(name, entry);
+    }
+
+    mz_zip_reader_end(&zip);
+
+    m_archive = archive;
+    return true;
+}
+
+const ZipFileSystem::Entry *ZipFileSystem::entry(const QString &path) const
+{
+    auto it = m_entries.constFind(path);
+    return it == m_entries.constEnd() ? nullptr : &it.value();
+}
+
+QByteArray ZipFileSystem::read(const QString &path) const
+{
+    const Entry *e = entry(path);
+    if (!e) return {};
+
+    const char *data = m_archive.constData() + e->dataOffset;
+
+    if (!e->deflated) {
+        // Stored: share the archive bytes, no copy
+        return QByteArray::fromRawData(data, qsizetype(e->size));
+    }
+
+    QByteArray out(qsizetype(e->size), Qt::Uninitialized);
+    size_t written = tinfl_decompress_mem_to_mem(out.data(), size_t(out.size()),
+                                                 data, size_t(e->compressedSize), 0);
+    if (written == TINFL_DECOMPRESS_MEM_TO_MEM_FAILED || qint64(written) != e->size) {
+        qCWarning(lcZipFs) << "Failed to inflate" << path;
+        return {};
+    }
+    return out;
+}
+
+QByteArray ZipFileSystem::readGzip(const QString &path) const
+{
+    const Entry *e = entry(path);
+    if (!e || !e->deflated) return {};
+
+    // RFC 1952: 10-byte header, raw deflate body, CRC32 + ISIZE trailer
+    static const char header[10] = { '\x1f', '\x8b', '\x08', 0, 0, 0, 0, 0, 0, '\xff' };
+
+    QByteArray out;
+    out.reserve(qsizetype(sizeof(header) + e->compressedSize + 8));
+    out.append(header, sizeof(header));
+    out.append(m_archive.constData() + e->dataOffset, qsizetype(e->compressedSize));
+    appendU32(out, e->crc32);
+    appendU32(out, quint32(e->size & 0xFFFFFFFF));
+    return out;
+}
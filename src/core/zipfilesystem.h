@@ -0,0 +1,53 @@
+#ifndef ZIPFILESYSTEM_H
+#define ZIPFILESYSTEM_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+
+/**
+ * @brief Read-only view of a zip archive held in memory
+ *
+ * open() reads the central directory once and keeps an index of entry
+ * offsets, sizes and CRCs; entry data is sliced straight out of the archive
+ * buffer. Stored entries are returned without copying, deflated entries are
+ * inflated on demand or handed out as a gzip stream wrapping the original
+ * compressed bytes (the zip CRC32 and size are exactly the gzip trailer).
+ *
+ * A single top-level directory (as in GitHub archive zips) is stripped from
+ * entry paths, so "repo-main/index.html" is looked up as "index.html".
+ */
+class ZipFileSystem
+{
+public:
+    struct Entry {
+        qint64 dataOffset = 0;
+        qint64 compressedSize = 0;
+        qint64 size = 0;
+        quint32 crc32 = 0;
+        bool deflated = false;
+    };
+
+    // The archive is shared (implicitly), not copied; pass
+    // QResource::uncompressedData() to serve straight from the binary.
+    bool open(const QByteArray &archive);
+
+    bool isOpen() const { return !m_archive.isEmpty(); }
+    int fileCount() const { return m_entries.size(); }
+
+    bool contains(const QString &path) const { return m_entries.contains(path); }
+    const Entry *entry(const QString &path) const;
+
+    // Uncompressed file contents (empty on error or missing entry)
+    QByteArray read(const QString &path) const;
+
+    // gzip-framed contents without recompression; empty if the entry is not
+    // deflated (stored entries are better served as-is)
+    QByteArray readGzip(const QString &path) const;
+
+private:
+    QByteArray m_archive;
+    QHash<QString, Entry> m_entries;
+};
+
+#endif // ZIPFILESYSTEM_H
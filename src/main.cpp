@@ -14,7 +14,11 @@
 #include <QQmlContext>
 #include <QQuickWindow>
 #include <QCommandLineParser>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QLoggingCategory>
+#include <QTextStream>
 #include <QNetworkInterface>
 #include <QThread>
 #include <QUrl>
@@ -26,9 +30,15 @@
 
 #include "core/bridge.h"
 #include "core/settings.h"
+#include "core/streamdemand.h"
+#include "core/telemetry.h"
 #include "ble/de1device.h"
 #include "ble/scaledevice.h"
+#include "ble/sensordevice.h"
 #include "ble/blemanager.h"
+#include "ble/scales/scalefactory.h"
+#include "ble/sensors/sensordescriptor.h"
+#include "ble/sensors/sensorfactory.h"
 
 Q_LOGGING_CATEGORY(lcMain, "bridge.main")
 
@@ -69,6 +79,7 @@ protected:
         if (!bridge.start()) {
             qCCritical(lcMain) << "Failed to start bridge on worker thread";
             m_bridge = nullptr;
+            m_settings->moveToThread(QCoreApplication::instance()->thread());
             return;
         }
 
@@ -79,6 +90,11 @@ protected:
         exec(); // Run this thread's event loop (independent of main thread)
         qCInfo(lcMain) << "Worker thread event loop exited";
         m_bridge = nullptr;
+
+        // Write pending changes while the save timer's thread is still
+        // around, then hand the settings back for destruction
+        m_settings->flush();
+        m_settings->moveToThread(QCoreApplication::instance()->thread());
     }
 
 private:
@@ -93,6 +109,9 @@ private:
  * Caches all values locally for thread safety - on Android, Bridge runs on
  * a worker thread while QML runs on the main thread. Signal/slot connections
  * with Qt::AutoConnection handle cross-thread dispatch automatically.
+ * Live readings come from the bridge's TelemetryBuffer instead of per-sample
+ * signals: a publish only wakes the controller, which takes the newest
+ * snapshot when the window finishes a frame.
  */
 class BridgeController : public QObject
 {
@@ -142,6 +161,8 @@ public:
         connect(m_bridge, &Bridge::de1Disconnected, this, [this]() {
             m_de1Connected = false;
             m_de1Name.clear();
+            m_state = DE1::State::Sleep;
+            m_subState = DE1::SubState::Ready;
             m_machineState = QStringLiteral("Sleep");
             m_machineSubState = QStringLiteral("Ready");
             m_groupTemp = 0; m_steamTemp = 0; m_pressure = 0; m_flow = 0;
@@ -154,7 +175,6 @@ public:
         connect(m_bridge, &Bridge::scaleConnected, this, [this]() {
             m_scaleConnected = true;
             m_scaleName = m_bridge->scale() ? m_bridge->scale()->name() : QString();
-            connectToScale();
             m_discoveredScales.clear();
             m_discoveredDeviceMap.clear();
             emit scaleConnectedChanged();
@@ -173,33 +193,9 @@ public:
         // Settings
         connect(m_settings, &Settings::bridgeNameChanged, this, &BridgeController::bridgeNameChanged);
 
-        // Machine real-time data from DE1
-        if (m_bridge->de1()) {
-            connect(m_bridge->de1(), &DE1Device::shotSampleReceived,
-                    this, [this](const QJsonObject &sample) {
-                m_groupTemp = sample[QStringLiteral("groupTemperature")].toDouble();
-                m_steamTemp = sample[QStringLiteral("steamTemperature")].toDouble();
-                m_pressure = sample[QStringLiteral("pressure")].toDouble();
-                m_flow = sample[QStringLiteral("flow")].toDouble();
-                emit metricsChanged();
-
-                // Shot samples also carry state info
-                QJsonObject stateObj = sample[QStringLiteral("state")].toObject();
-                QString newState = stateObj[QStringLiteral("state")].toString();
-                QString newSubState = stateObj[QStringLiteral("substate")].toString();
-                if (m_machineState != newState || m_machineSubState != newSubState) {
-                    m_machineState = newState;
-                    m_machineSubState = newSubState;
-                    emit machineStateChanged();
-                }
-            });
-            connect(m_bridge->de1(), &DE1Device::stateChanged,
-                    this, [this](const QJsonObject &state) {
-                m_machineState = state[QStringLiteral("state")].toString();
-                m_machineSubState = state[QStringLiteral("substate")].toString();
-                emit machineStateChanged();
-            });
-        }
+        // Machine and scale readings arrive as a typed snapshot, applied once per frame
+        connect(m_bridge, &Bridge::telemetryPublished,
+                this, &BridgeController::onTelemetryPublished);
 
         // BLE scanning
         if (m_bridge->bleManager()) {
@@ -226,7 +222,26 @@ public:
         if (m_bridge->scale() && m_bridge->scale()->isConnected()) {
             m_scaleConnected = true;
             m_scaleName = m_bridge->scale()->name();
-            connectToScale();
+        }
+
+        // Live metrics are only streamed while the dashboard can be seen
+        connect(qGuiApp, &QGuiApplication::applicationStateChanged,
+                this, &BridgeController::onApplicationStateChanged);
+        onApplicationStateChanged(qGuiApp->applicationState());
+    }
+
+    ~BridgeController() override
+    {
+        setDashboardVisible(false);
+    }
+
+    // Telemetry is applied after each frame the window shows, so QML bindings
+    // re-evaluate at most once per frame however fast the devices report
+    void setWindow(QQuickWindow *window) {
+        m_window = window;
+        if (m_window) {
+            connect(m_window, &QQuickWindow::frameSwapped,
+                    this, &BridgeController::applyTelemetry);
         }
     }
 
@@ -295,11 +310,8 @@ public:
 
     Q_INVOKABLE void connectToScale(const QString &address) {
         QMetaObject::invokeMethod(m_bridge, [bridge = m_bridge, address]() {
-            for (const auto &dev : bridge->bleManager()->discoveredDevices()) {
-                if (dev.address().toString() == address) {
-                    bridge->connectToScale(dev);
-                    return;
-                }
+            if (auto *device = bridge->bleManager()->discoveredDevice(address)) {
+                bridge->connectToScale(device->info);
             }
         });
     }
@@ -331,29 +343,77 @@ signals:
     void scanningChanged();
     void discoveredScalesChanged();
 
+private slots:
+    void onTelemetryPublished() {
+        if (m_window && m_window->isExposed()) {
+            m_window->requestUpdate();
+        } else {
+            applyTelemetry();
+        }
+    }
+
+    void applyTelemetry() {
+        Telemetry t;
+        if (!m_bridge->telemetry()->take(t)) return;
+
+        if (t.groupTemp != m_groupTemp || t.steamTemp != m_steamTemp
+            || t.pressure != m_pressure || t.flow != m_flow) {
+            m_groupTemp = t.groupTemp;
+            m_steamTemp = t.steamTemp;
+            m_pressure = t.pressure;
+            m_flow = t.flow;
+            emit metricsChanged();
+        }
+
+        if (t.state != m_state || t.subState != m_subState) {
+            m_state = t.state;
+            m_subState = t.subState;
+            m_machineState = DE1::stateToString(t.state);
+            m_machineSubState = DE1::subStateToString(t.subState);
+            emit machineStateChanged();
+        }
+
+        if (m_scaleConnected && t.scaleWeight != m_scaleWeight) {
+            m_scaleWeight = t.scaleWeight;
+            emit scaleWeightChanged();
+        }
+        if (m_scaleConnected && t.scaleFlow != m_scaleFlow) {
+            m_scaleFlow = t.scaleFlow;
+            emit scaleFlowChanged();
+        }
+    }
+
+    void onApplicationStateChanged(Qt::ApplicationState state) {
+        setDashboardVisible(state == Qt::ApplicationActive || state == Qt::ApplicationInactive);
+    }
+
 private:
-    void connectToScale() {
-        if (auto *scale = m_bridge->scale()) {
-            connect(scale, &ScaleDevice::weightChanged, this, [this](double w) {
-                m_scaleWeight = w;
-                emit scaleWeightChanged();
-            });
-            connect(scale, &ScaleDevice::flowRateChanged, this, [this](double f) {
-                m_scaleFlow = f;
-                emit scaleFlowChanged();
-            });
+    void setDashboardVisible(bool visible) {
+        if (m_dashboardVisible == visible) return;
+        m_dashboardVisible = visible;
+
+        StreamDemand *demand = m_bridge->demand();
+        for (StreamDemand::Stream stream : {StreamDemand::Stream::ShotSamples, StreamDemand::Stream::ScaleWeight}) {
+            if (visible) {
+                demand->acquire(stream);
+            } else {
+                demand->release(stream);
+            }
         }
     }
 
     Bridge *m_bridge;
     Settings *m_settings;
+    QQuickWindow *m_window = nullptr;
     QString m_ipAddress;
 
-    // Cached values (thread-safe: only modified on main thread via queued signals)
+    // Cached values (thread-safe: only modified on main thread)
     bool m_de1Connected = false;
     bool m_scaleConnected = false;
     QString m_de1Name;
     QString m_scaleName;
+    DE1::State m_state = DE1::State::Sleep;
+    DE1::SubState m_subState = DE1::SubState::Ready;
     QString m_machineState = QStringLiteral("Sleep");
     QString m_machineSubState = QStringLiteral("Ready");
     double m_groupTemp = 0;
@@ -363,10 +423,75 @@ private:
     double m_scaleWeight = 0;
     double m_scaleFlow = 0;
     bool m_scanning = false;
+    bool m_dashboardVisible = false;
     QVariantList m_discoveredScales;
     QMap<QString, QBluetoothDeviceInfo> m_discoveredDeviceMap;
 };
 
+/**
+ * Runs a recorded sensor capture through its JSON description and prints
+ * one decoded record per notification, to check a description without
+ * hardware. Captures are recorded with --record-sensor and use the scale
+ * capture layout (JSON Lines):
+ *
+ *   {"capture":"decentbridge-sensor","version":1,"type":"ThermoProbe"}
+ *   {"t":120,"notify":"0000fff1-0000-1000-8000-00805f9b34fb","data":"0a01f2"}
+ */
+static int decodeSensorCapture(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCCritical(lcMain) << "Cannot open" << path;
+        return 1;
+    }
+
+    SensorFactory::loadDescriptors(SensorFactory::descriptorsPath());
+
+    QTextStream out(stdout);
+    std::shared_ptr<const SensorDescriptor> descriptor;
+    double values[SensorDescriptor::MAX_FIELDS];
+    int decoded = 0;
+    int skipped = 0;
+    int lineNumber = 0;
+
+    while (!file.atEnd()) {
+        QByteArray line = file.readLine().trimmed();
+        lineNumber++;
+        if (line.isEmpty()) continue;
+
+        QJsonObject event = QJsonDocument::fromJson(line).object();
+        if (lineNumber == 1) {
+            descriptor = SensorFactory::descriptor(event["type"].toString());
+            if (!descriptor) {
+                qCCritical(lcMain) << "No sensor description for type" << event["type"].toString()
+                                   << "in" << SensorFactory::descriptorsPath();
+                return 1;
+            }
+            continue;
+        }
+
+        if (QBluetoothUuid(event["notify"].toString()) != descriptor->characteristic) continue;
+        QByteArray data = QByteArray::fromHex(event["data"].toString().toLatin1());
+        if (!descriptor->decode(data, values)) {
+            skipped++;
+            continue;
+        }
+
+        QJsonObject record;
+        record["t"] = event["t"];
+        QJsonObject fields;
+        for (int i = 0; i < descriptor->fields.size(); ++i) {
+            fields[descriptor->fields[i].key] = values[i];
+        }
+        record["values"] = fields;
+        out << QJsonDocument(record).toJson(QJsonDocument::Compact) << '\n';
+        decoded++;
+    }
+
+    qCInfo(lcMain) << "Decoded" << decoded << "notifications," << skipped << "too short";
+    return 0;
+}
+
 int main(int argc, char *argv[])
 {
     QGuiApplication app(argc, argv);
@@ -409,6 +534,42 @@ int main(int argc, char *argv[])
     );
     parser.addOption(verboseOption);
 
+    QCommandLineOption recordScaleOption(
+        "record-scale",
+        "Record scale BLE traffic as capture files in this directory",
+        "dir"
+    );
+    parser.addOption(recordScaleOption);
+
+    QCommandLineOption recordSensorOption(
+        "record-sensor",
+        "Record sensor BLE notifications as capture files in this directory",
+        "dir"
+    );
+    parser.addOption(recordSensorOption);
+
+    QCommandLineOption replayScaleOption(
+        "replay-scale",
+        "Feed a recorded scale capture through its driver instead of BLE",
+        "file"
+    );
+    parser.addOption(replayScaleOption);
+
+    QCommandLineOption replaySpeedOption(
+        "replay-speed",
+        "Replay speed factor, 0 = as fast as possible (default: 1)",
+        "factor",
+        "1"
+    );
+    parser.addOption(replaySpeedOption);
+
+    QCommandLineOption decodeSensorOption(
+        "decode-sensor",
+        "Decode a recorded sensor capture with its description from sensors.json, print the values and exit",
+        "file"
+    );
+    parser.addOption(decodeSensorOption);
+
     parser.process(app);
 
     // Configure logging
@@ -418,14 +579,36 @@ int main(int argc, char *argv[])
         QLoggingCategory::setFilterRules("bridge.*.debug=false");
     }
 
+    if (parser.isSet(decodeSensorOption)) {
+        return decodeSensorCapture(parser.value(decodeSensorOption));
+    }
+
     // Load settings
     Settings settings;
     if (parser.isSet(configOption)) {
         settings.loadFromFile(parser.value(configOption));
     }
 
-    settings.setHttpPort(parser.value(portOption).toInt());
-    settings.setWebSocketPort(parser.value(wsPortOption).toInt());
+    // Ports given on the command line are for this run only and are never
+    // written back to the config file
+    if (parser.isSet(portOption)) {
+        settings.overrideHttpPort(parser.value(portOption).toInt());
+    }
+    if (parser.isSet(wsPortOption)) {
+        settings.overrideWebSocketPort(parser.value(wsPortOption).toInt());
+    }
+
+    // Changes from the API go back to the config file
+    if (parser.isSet(configOption)) {
+        settings.setStoragePath(parser.value(configOption));
+    }
+
+    if (parser.isSet(recordScaleOption)) {
+        ScaleFactory::setCaptureDirectory(parser.value(recordScaleOption));
+    }
+    if (parser.isSet(recordSensorOption)) {
+        SensorDevice::setCaptureDirectory(parser.value(recordSensorOption));
+    }
 
     qCInfo(lcMain) << "DecentBridge v" << app.applicationVersion();
     qCInfo(lcMain) << "HTTP server on port" << settings.httpPort();
@@ -439,6 +622,9 @@ int main(int argc, char *argv[])
     // killing all processing (HTTP, WebSocket, BLE). The worker thread has
     // its own event loop that Android doesn't touch.
     BridgeThread bridgeThread(&settings);
+    // Settings are changed from the bridge thread, so their save timer has
+    // to run there too; this thread may be suspended in the background
+    settings.moveToThread(&bridgeThread);
 
     // When Bridge is ready on the worker thread, open the web UI in the browser.
     // No QML engine needed on Android — the web skin is the UI and skipping QML
@@ -470,6 +656,11 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    if (parser.isSet(replayScaleOption)
+        && !bridge.replayScale(parser.value(replayScaleOption), parser.value(replaySpeedOption).toDouble())) {
+        return 1;
+    }
+
     BridgeController controller(&bridge, &settings);
 
     // Open the web UI in the default browser
@@ -486,6 +677,9 @@ int main(int argc, char *argv[])
             QCoreApplication::exit(-1);
     }, Qt::QueuedConnection);
     engine.load(url);
+    if (!engine.rootObjects().isEmpty()) {
+        controller.setWindow(qobject_cast<QQuickWindow *>(engine.rootObjects().first()));
+    }
 #endif
 
     return app.exec();
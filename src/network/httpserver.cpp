@@ -1,11 +1,15 @@
 #include "httpserver.h"
 #include "core/bridge.h"
+#include "core/keyvaluestore.h"
 #include "core/settings.h"
+#include "core/streamdemand.h"
+#include "core/zipfilesystem.h"
 #include "ble/blemanager.h"
 #include "ble/de1device.h"
 #include "ble/scaledevice.h"
 #include "ble/sensordevice.h"
 
+#include <QDateTime>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -14,19 +18,141 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QRegularExpression>
 #include <QSet>
 #include <QStandardPaths>
+#include <QTemporaryFile>
+#include <QThreadPool>
 #include <QUrl>
 
 Q_LOGGING_CATEGORY(lcHttp, "bridge.http")
 
+namespace {
+
+// Proxies close idle connections; a comment line every so often keeps the stream open
+constexpr int EVENT_KEEPALIVE_MS = 15000;
+// A stream further behind than this is dropped; the client reconnects and resyncs
+constexpr qint64 EVENT_BACKLOG_LIMIT = 64 * 1024;
+
+// Request line and headers
+constexpr int MAX_HEADER_SIZE = 16 * 1024;
+// Body size for routes without an entry in BODY_LIMITS
+constexpr qint64 DEFAULT_MAX_BODY = 64 * 1024;
+// Unread bytes a socket buffers before Qt pauses reading from the network
+constexpr qint64 SOCKET_READ_BUFFER = 64 * 1024;
+// All in-memory bodies of requests still arriving, across connections
+constexpr qint64 MAX_BUFFERED_BODIES = 8 * 1024 * 1024;
+// All temporary files of streamed uploads still arriving, across connections
+constexpr qint64 MAX_STREAMED_BODIES = 96 * 1024 * 1024;
+// Time to deliver a request; a streamed upload's deadline restarts as data arrives
+constexpr int REQUEST_TIMEOUT_MS = 30000;
+
+struct BodyLimit {
+    const char *method;
+    const char *pathPrefix;
+    qint64 maxBytes;
+    bool streamed;      // Written to a temporary file as it arrives
+};
+
+// First match wins
+const BodyLimit BODY_LIMITS[] = {
+    { "PUT", "/api/v1/dev/skin/", 32 * 1024 * 1024, true },
+    { "POST", "/api/v1/store/", 1024 * 1024, false },
+    { "POST", "/api/v1/profiles", 256 * 1024, false },
+    { "POST", "/api/v1/machine/profile", 256 * 1024, false },
+    { "PUT", "/api/v1/workflow", 256 * 1024, false },
+};
+
+BodyLimit bodyLimit(const QString &method, const QString &path)
+{
+    for (const BodyLimit &limit : BODY_LIMITS) {
+        if (method == QLatin1String(limit.method) && path.startsWith(QLatin1String(limit.pathPrefix))) {
+            return limit;
+        }
+    }
+    return { nullptr, nullptr, DEFAULT_MAX_BODY, false };
+}
+
+// Long poll wait when the client gives no timeout, and the most it may ask for (s)
+constexpr int LONG_POLL_DEFAULT_S = 30;
+constexpr int LONG_POLL_MAX_S = 120;
+
+// One chunk of a Transfer-Encoding: chunked body
+QByteArray chunk(const QByteArray &payload)
+{
+    return QByteArray::number(payload.size(), 16) + "\r\n" + payload + "\r\n";
+}
+
+QByteArray scaleJson(double weight, double flow)
+{
+    QJsonObject obj;
+    obj["weight"] = weight;
+    obj["weightFlow"] = flow;
+    return QJsonDocument(obj).toJson(QJsonDocument::Compact);
+}
+
+// If-None-Match lists ETags or is "*"; GET compares them weakly
+bool etagMatches(const QString &ifNoneMatch, const QByteArray &etag)
+{
+    if (ifNoneMatch.isEmpty()) return false;
+    if (ifNoneMatch.trimmed() == "*") return true;
+
+    const QByteArray opaque = etag.startsWith("W/") ? etag.mid(2) : etag;
+    for (QString candidate : ifNoneMatch.split(',')) {
+        candidate = candidate.trimmed();
+        if (candidate.startsWith("W/")) candidate = candidate.mid(2);
+        if (candidate.toLatin1() == opaque) return true;
+    }
+    return false;
+}
+
+// Dot-prefixed segments are bookkeeping (SkinManager's .manifest.json),
+// never part of the skin itself
+bool isHiddenPath(const QString &path)
+{
+    for (const QString &segment : path.split('/', Qt::SkipEmptyParts)) {
+        if (segment.startsWith('.')) return true;
+    }
+    return false;
+}
+
+// Accept-Encoding lists codings with optional q-values; q=0 refuses one,
+// and "*" stands for every coding not named explicitly
+bool acceptsGzip(const QString &acceptEncoding)
+{
+    double wildcard = 0.0;
+    for (const QString &item : acceptEncoding.split(',', Qt::SkipEmptyParts)) {
+        const QStringList params = item.split(';');
+        const QString coding = params.first().trimmed().toLower();
+        double q = 1.0;
+        for (int i = 1; i < params.size(); ++i) {
+            const QString param = params[i].trimmed();
+            if (param.startsWith("q=", Qt::CaseInsensitive)) {
+                bool ok = false;
+                q = param.mid(2).trimmed().toDouble(&ok);
+                if (!ok) q = 0.0;
+            }
+        }
+        if (coding == "gzip" || coding == "x-gzip") return q > 0.0;
+        if (coding == "*") wildcard = q;
+    }
+    return wildcard > 0.0;
+}
+
+} // namespace
+
 HttpServer::HttpServer(Bridge *bridge, QObject *parent)
     : QObject(parent)
     , m_bridge(bridge)
+    , m_store(std::make_unique<KeyValueStore>(storeDir()))
+    , m_requestTimeoutMs(REQUEST_TIMEOUT_MS)
 {
+    m_startupTimer.start();
+    m_etagPrefix = QByteArray::number(QDateTime::currentMSecsSinceEpoch(), 36);
+    m_keepAliveTimer.setInterval(EVENT_KEEPALIVE_MS);
+    connect(&m_keepAliveTimer, &QTimer::timeout, this, &HttpServer::sendKeepAlive);
     setupRoutes();
-    ensureDefaultProfiles();
 }
 
 HttpServer::~HttpServer()
@@ -76,6 +202,7 @@ void HttpServer::setupRoutes()
     m_getRoutes["/api/v1/machine/settings"] = [this](auto& req, auto& res) { handleGetMachineSettings(req, res); };
     m_getRoutes["/api/v1/machine/shotSettings"] = [this](auto& req, auto& res) { handleGetShotSettings(req, res); };
     m_getRoutes["/api/v1/machine/waterLevels"] = [this](auto& req, auto& res) { handleGetWaterLevels(req, res); };
+    m_getRoutes["/api/v1/scale"] = [this](auto& req, auto& res) { handleGetScale(req, res); };
     m_getRoutes["/api/v1/settings"] = [this](auto& req, auto& res) { handleGetSettings(req, res); };
     m_getRoutes["/api/v1/sensors"] = [this](auto& req, auto& res) { handleGetSensors(req, res); };
     m_getRoutes["/api/v1/workflow"] = [this](auto& req, auto& res) { handleGetWorkflow(req, res); };
@@ -112,12 +239,27 @@ bool HttpServer::start(int port)
         return false;
     }
 
-    qCInfo(lcHttp) << "HTTP server listening on port" << port;
+    qCInfo(lcHttp) << "HTTP server listening on port" << port
+                   << "(" << m_startupTimer.elapsed() << "ms after startup)";
     return true;
 }
 
 void HttpServer::stop()
 {
+    // Copy first: closing may report the disconnect synchronously
+    const QSet<QTcpSocket*> streams = m_eventStreams;
+    for (QTcpSocket *socket : streams) {
+        closeEventStream(socket);
+        socket->write("0\r\n\r\n");  // Last chunk
+        socket->disconnectFromHost();
+    }
+    // Answered with the current state, which also releases their streams
+    const QList<QTcpSocket*> polls = m_longPolls.keys();
+    for (QTcpSocket *socket : polls) {
+        completeLongPoll(socket);
+        socket->disconnectFromHost();
+    }
+
     if (m_server) {
         m_server->close();
         delete m_server;
@@ -129,8 +271,19 @@ void HttpServer::onNewConnection()
 {
     while (m_server->hasPendingConnections()) {
         QTcpSocket *socket = m_server->nextPendingConnection();
+        // Qt stops reading from the network while this much is unread, so a
+        // fast sender cannot grow the socket's own buffer without bound
+        socket->setReadBufferSize(SOCKET_READ_BUFFER);
         connect(socket, &QTcpSocket::readyRead, this, &HttpServer::onReadyRead);
         connect(socket, &QTcpSocket::disconnected, this, &HttpServer::onDisconnected);
+
+        // A client that stalls mid-request would otherwise hold its share of
+        // the body budgets for as long as it keeps the connection open
+        auto *deadline = new QTimer(socket);
+        deadline->setSingleShot(true);
+        connect(deadline, &QTimer::timeout, this, [this, socket]() { onRequestTimeout(socket); });
+        deadline->start(m_requestTimeoutMs);
+        m_deadlines.insert(socket, deadline);
     }
 }
 
@@ -139,9 +292,15 @@ void HttpServer::onReadyRead()
     QTcpSocket *socket = qobject_cast<QTcpSocket*>(sender());
     if (!socket) return;
 
+    // Event streams and parked long polls only send; anything the client writes is ignored
+    if (m_eventStreams.contains(socket) || m_longPolls.contains(socket)) {
+        socket->readAll();
+        return;
+    }
+
     // For new sockets, peek first to detect WebSocket upgrade requests.
     // peek() does NOT consume data, so QWebSocketServer can read it later.
-    if (!m_socketBuffers.contains(socket)) {
+    if (!m_pending.contains(socket)) {
         QByteArray peeked = socket->peek(socket->bytesAvailable());
         int headerEnd = peeked.indexOf("\r\n\r\n");
 
@@ -150,6 +309,8 @@ void HttpServer::onReadyRead()
             QByteArray headerBlock = peeked.left(headerEnd).toLower();
             if (headerBlock.contains("upgrade: websocket")) {
                 // Hand off to WebSocket server without consuming data
+                socket->setReadBufferSize(0);
+                clearDeadline(socket);
                 disconnect(socket, &QTcpSocket::readyRead, this, &HttpServer::onReadyRead);
                 disconnect(socket, &QTcpSocket::disconnected, this, &HttpServer::onDisconnected);
                 emit webSocketUpgradeRequested(socket);
@@ -163,39 +324,57 @@ void HttpServer::onReadyRead()
         // Headers complete or too large - proceed with normal HTTP
     }
 
-    m_socketBuffers[socket] += socket->readAll();
-    QByteArray &data = m_socketBuffers[socket];
+    PendingRequest &pending = m_pending[socket];
+    if (pending.rejected) {
+        socket->readAll();
+        return;
+    }
 
-    // Check if we have the complete headers (look for \r\n\r\n)
-    int headerEnd = data.indexOf("\r\n\r\n");
-    if (headerEnd == -1) return; // Headers not complete yet
+    QByteArray data = socket->readAll();
+    if (!pending.headersParsed) {
+        pending.buffer += data;
+        const int headerEnd = pending.buffer.indexOf("\r\n\r\n");
+        if (headerEnd == -1) {
+            if (pending.buffer.size() > MAX_HEADER_SIZE) {
+                rejectRequest(socket, 431, "Request Header Fields Too Large");
+            }
+            return; // Headers not complete yet
+        }
+        if (headerEnd > MAX_HEADER_SIZE) {
+            rejectRequest(socket, 431, "Request Header Fields Too Large");
+            return;
+        }
 
-    // Extract Content-Length from headers
-    int contentLength = 0;
-    QString headerStr = QString::fromUtf8(data.left(headerEnd));
-    for (const QString &line : headerStr.split("\r\n")) {
-        if (line.toLower().startsWith("content-length:")) {
-            contentLength = line.mid(15).trimmed().toInt();
-            break;
+        // Whatever follows the headers is the start of the body
+        data = pending.buffer.mid(headerEnd + 4);
+        pending.buffer.truncate(headerEnd);
+        if (!parseRequestHead(pending.buffer, pending.request)) {
+            rejectRequest(socket, 400, "Bad Request");
+            return;
         }
+        pending.buffer.clear();
+        pending.headersParsed = true;
+        if (!readRequestHead(socket, pending)) return;
     }
 
-    // Check if we have the complete body
-    int bodyStart = headerEnd + 4; // skip \r\n\r\n
-    if (data.size() - bodyStart < contentLength) return; // Body not complete yet
-
-    HttpRequest request;
-
-    if (!parseRequest(data, request)) {
-        HttpResponse response;
-        response.setError(400, "Bad Request");
-        socket->write(response.toBytes());
-        socket->disconnectFromHost();
-        m_socketBuffers.remove(socket);
-        return;
+    if (!appendBody(socket, pending, data)) return;
+    if (pending.received < pending.contentLength) {
+        // Uploads may take longer than the timeout, but must keep moving
+        if (pending.request.bodyFile && !data.isEmpty()) {
+            if (QTimer *deadline = m_deadlines.value(socket)) deadline->start(m_requestTimeoutMs);
+        }
+        return; // Body not complete yet
     }
 
-    m_socketBuffers.remove(socket);
+    HttpRequest request = std::move(pending.request);
+    if (request.bodyFile) {
+        request.bodyFile->flush();
+        request.bodyFile->seek(0);
+    } else {
+        request.body = std::move(pending.buffer);
+    }
+    dropPending(socket);
+    clearDeadline(socket);
     handleRequest(socket, request);
 }
 
@@ -203,14 +382,17 @@ void HttpServer::onDisconnected()
 {
     QTcpSocket *socket = qobject_cast<QTcpSocket*>(sender());
     if (socket) {
-        m_socketBuffers.remove(socket);
+        dropPending(socket);
+        clearDeadline(socket);
+        closeEventStream(socket);
+        completeLongPoll(socket);
         socket->deleteLater();
     }
 }
 
-bool HttpServer::parseRequest(const QByteArray &data, HttpRequest &request)
+bool HttpServer::parseRequestHead(const QByteArray &head, HttpRequest &request)
 {
-    QString str = QString::fromUtf8(data);
+    QString str = QString::fromUtf8(head);
     QStringList lines = str.split("\r\n");
 
     if (lines.isEmpty()) return false;
@@ -232,8 +414,7 @@ bool HttpServer::parseRequest(const QByteArray &data, HttpRequest &request)
     }
 
     // Parse headers
-    int i = 1;
-    for (; i < lines.size() && !lines[i].isEmpty(); ++i) {
+    for (int i = 1; i < lines.size() && !lines[i].isEmpty(); ++i) {
         int colonIdx = lines[i].indexOf(':');
         if (colonIdx > 0) {
             QString key = lines[i].left(colonIdx).trimmed().toLower();
@@ -242,34 +423,176 @@ bool HttpServer::parseRequest(const QByteArray &data, HttpRequest &request)
         }
     }
 
-    // Body is after empty line
-    if (i + 1 < lines.size()) {
-        request.body = lines.mid(i + 1).join("\r\n").toUtf8();
+    return true;
+}
+
+bool HttpServer::readRequestHead(QTcpSocket *socket, PendingRequest &pending)
+{
+    const HttpRequest &request = pending.request;
+
+    // Bodies are only framed by Content-Length
+    if (request.headers.contains("transfer-encoding")) {
+        rejectRequest(socket, 411, "Length Required");
+        return false;
+    }
+
+    bool ok = true;
+    const QString length = request.headers.value("content-length");
+    pending.contentLength = length.isEmpty() ? 0 : length.toLongLong(&ok);
+    if (!ok || pending.contentLength < 0) {
+        rejectRequest(socket, 400, "Bad Content-Length");
+        return false;
+    }
+
+    const BodyLimit limit = bodyLimit(request.method, request.path);
+    if (pending.contentLength > limit.maxBytes) {
+        qCWarning(lcHttp) << "Rejecting" << request.method << request.path << "with"
+                          << pending.contentLength << "byte body, limit" << limit.maxBytes;
+        rejectRequest(socket, 413, "Payload Too Large");
+        return false;
     }
 
+    if (pending.contentLength > 0) {
+        if (limit.streamed) {
+            if (m_streamedBytes + pending.contentLength > MAX_STREAMED_BODIES) {
+                rejectRequest(socket, 503, "Server Busy");
+                return false;
+            }
+            auto file = std::make_shared<QTemporaryFile>(QDir::tempPath() + "/decentbridge-upload-XXXXXX");
+            if (!file->open()) {
+                rejectRequest(socket, 500, "Cannot store upload");
+                return false;
+            }
+            pending.request.bodyFile = file;
+            m_streamedBytes += pending.contentLength;
+            pending.reservedFile = pending.contentLength;
+        } else {
+            if (m_bufferedBytes + pending.contentLength > MAX_BUFFERED_BODIES) {
+                rejectRequest(socket, 503, "Server Busy");
+                return false;
+            }
+            m_bufferedBytes += pending.contentLength;
+            pending.reserved = pending.contentLength;
+            pending.buffer.reserve(pending.contentLength);
+        }
+    }
+
+    // The client waits for this before sending a large body; a rejection
+    // above saved it from sending the body at all
+    if (request.headers.value("expect").compare("100-continue", Qt::CaseInsensitive) == 0) {
+        socket->write("HTTP/1.1 100 Continue\r\n\r\n");
+    }
     return true;
 }
 
+bool HttpServer::appendBody(QTcpSocket *socket, PendingRequest &pending, const QByteArray &data)
+{
+    // One request per connection; anything past the declared body is dropped
+    const qint64 take = qMin<qint64>(data.size(), pending.contentLength - pending.received);
+    if (take <= 0) return true;
+
+    if (pending.request.bodyFile) {
+        if (pending.request.bodyFile->write(data.constData(), take) != take) {
+            rejectRequest(socket, 500, "Cannot store upload");
+            return false;
+        }
+    } else {
+        pending.buffer.append(data.constData(), take);
+    }
+    pending.received += take;
+    return true;
+}
+
+void HttpServer::rejectRequest(QTcpSocket *socket, int code, const QString &message)
+{
+    HttpResponse response;
+    addCorsHeaders(response);
+    response.setError(code, message);
+
+    // Keep the entry so the rest of the body is discarded, not parsed as a new request
+    dropPending(socket);
+    m_pending[socket].rejected = true;
+    sendResponse(socket, response);
+}
+
+void HttpServer::dropPending(QTcpSocket *socket)
+{
+    auto it = m_pending.find(socket);
+    if (it == m_pending.end()) return;
+    m_bufferedBytes -= it->reserved;
+    m_streamedBytes -= it->reservedFile;
+    m_pending.erase(it);
+}
+
+void HttpServer::onRequestTimeout(QTcpSocket *socket)
+{
+    m_deadlines.remove(socket);
+    auto it = m_pending.constFind(socket);
+    if (it != m_pending.constEnd() && it->rejected) {
+        // Answered already, but the client keeps the connection open
+        dropPending(socket);
+        socket->abort();
+        return;
+    }
+    qCInfo(lcHttp) << "Request not received within" << m_requestTimeoutMs << "ms from"
+                   << socket->peerAddress().toString();
+    rejectRequest(socket, 408, "Request Timeout");
+}
+
+void HttpServer::clearDeadline(QTcpSocket *socket)
+{
+    if (QTimer *deadline = m_deadlines.take(socket)) {
+        delete deadline;
+    }
+}
+
 void HttpServer::handleRequest(QTcpSocket *socket, const HttpRequest &request)
 {
     emit requestReceived(request.method, request.path);
     qCDebug(lcHttp) << request.method << request.path;
 
-    HttpResponse response;
-    response.headers["Access-Control-Allow-Origin"] = "*";
-    response.headers["Access-Control-Allow-Methods"] = "GET, POST, PUT, DELETE, OPTIONS";
-    response.headers["Access-Control-Allow-Headers"] = "Content-Type";
-
     // Handle CORS preflight
     if (request.method == "OPTIONS") {
+        HttpResponse response;
+        addCorsHeaders(response);
         response.statusCode = 204;
         response.statusText = "No Content";
-        socket->write(response.toBytes());
-        socket->disconnectFromHost();
+        sendResponse(socket, response);
+        return;
+    }
+
+    // Event stream: the socket stays open instead of getting a single response
+    if (request.method == "GET" && request.path == "/api/v1/events") {
+        openEventStream(socket);
+        return;
+    }
+
+    // Long poll: the response waits until the resource changes
+    if (request.method == "GET" && parkLongPoll(socket, request)) {
         return;
     }
 
-    // Route the request
+    respond(socket, request);
+}
+
+void HttpServer::respond(QTcpSocket *socket, const HttpRequest &request)
+{
+    HttpResponse response;
+    addCorsHeaders(response);
+    routeRequest(request, response);
+    sendResponse(socket, response);
+}
+
+void HttpServer::addCorsHeaders(HttpResponse &response)
+{
+    response.headers["Access-Control-Allow-Origin"] = "*";
+    response.headers["Access-Control-Allow-Methods"] = "GET, POST, PUT, DELETE, OPTIONS";
+    response.headers["Access-Control-Allow-Headers"] = "Content-Type, If-None-Match";
+    response.headers["Access-Control-Expose-Headers"] = "ETag, X-Generation";
+}
+
+void HttpServer::routeRequest(const HttpRequest &request, HttpResponse &response)
+{
     RouteHandler handler = nullptr;
 
     if (request.method == "GET") {
@@ -277,17 +600,17 @@ void HttpServer::handleRequest(QTcpSocket *socket, const HttpRequest &request)
         if (request.path.startsWith("/api/v1/sensors/") && request.path != "/api/v1/sensors") {
             QString sensorId = request.path.section('/', -1);
             handleGetSensorById(request, response, sensorId);
-            socket->write(response.toBytes());
-            socket->disconnectFromHost();
             return;
         }
-        // Check for store pattern: /api/v1/store/:namespace/:key
+        // Check for store pattern: /api/v1/store/:namespace[/:key]
         if (request.path.startsWith("/api/v1/store/")) {
             QStringList parts = request.path.mid(14).split('/'); // strip "/api/v1/store/"
             if (parts.size() == 2 && !parts[0].isEmpty() && !parts[1].isEmpty()) {
                 handleGetStore(request, response, parts[0], parts[1]);
-                socket->write(response.toBytes());
-                socket->disconnectFromHost();
+                return;
+            }
+            if (parts.size() == 1 && !parts[0].isEmpty()) {
+                handleGetStoreBatch(request, response, parts[0]);
                 return;
             }
         }
@@ -295,19 +618,19 @@ void HttpServer::handleRequest(QTcpSocket *socket, const HttpRequest &request)
         if (request.path.startsWith("/api/v1/profiles/") && request.path != "/api/v1/profiles") {
             QString profileId = request.path.mid(17); // strip "/api/v1/profiles/"
             handleGetProfileById(request, response, profileId);
-            socket->write(response.toBytes());
-            socket->disconnectFromHost();
             return;
         }
         handler = m_getRoutes.value(request.path);
     } else if (request.method == "POST") {
-        // Check for store pattern: /api/v1/store/:namespace/:key
+        // Check for store pattern: /api/v1/store/:namespace[/:key]
         if (request.path.startsWith("/api/v1/store/")) {
             QStringList parts = request.path.mid(14).split('/');
             if (parts.size() == 2 && !parts[0].isEmpty() && !parts[1].isEmpty()) {
                 handlePostStore(request, response, parts[0], parts[1]);
-                socket->write(response.toBytes());
-                socket->disconnectFromHost();
+                return;
+            }
+            if (parts.size() == 1 && !parts[0].isEmpty()) {
+                handlePostStoreBatch(request, response, parts[0]);
                 return;
             }
         }
@@ -317,15 +640,11 @@ void HttpServer::handleRequest(QTcpSocket *socket, const HttpRequest &request)
         if (request.path.startsWith("/api/v1/dev/skin/")) {
             QString filePath = request.path.mid(17); // strip "/api/v1/dev/skin/"
             handlePutDevSkin(request, response, filePath);
-            socket->write(response.toBytes());
-            socket->disconnectFromHost();
             return;
         }
         // Check for state change pattern: /api/v1/machine/state/:newState
         if (request.path.startsWith("/api/v1/machine/state/")) {
             handleSetMachineState(request, response);
-            socket->write(response.toBytes());
-            socket->disconnectFromHost();
             return;
         }
         handler = m_putRoutes.value(request.path);
@@ -334,8 +653,6 @@ void HttpServer::handleRequest(QTcpSocket *socket, const HttpRequest &request)
         if (request.path.startsWith("/api/v1/profiles/") && request.path != "/api/v1/profiles") {
             QString profileId = request.path.mid(17);
             handleDeleteProfile(request, response, profileId);
-            socket->write(response.toBytes());
-            socket->disconnectFromHost();
             return;
         }
     }
@@ -349,9 +666,251 @@ void HttpServer::handleRequest(QTcpSocket *socket, const HttpRequest &request)
         qCWarning(lcHttp) << "No route for:" << request.method << request.path;
         response.setError(404, "Not Found");
     }
+}
 
+void HttpServer::sendResponse(QTcpSocket *socket, const HttpResponse &response)
+{
     socket->write(response.toBytes());
     socket->disconnectFromHost();
+
+    if (!m_firstResponseSent) {
+        m_firstResponseSent = true;
+        qCInfo(lcHttp) << "Time to first response:" << m_startupTimer.elapsed() << "ms after startup";
+    }
+}
+
+// Long polls
+bool HttpServer::parkLongPoll(QTcpSocket *socket, const HttpRequest &request)
+{
+    static const QHash<QString, Watch> WATCHED = {
+        { "/api/v1/machine/state", Watch::MachineState },
+        { "/api/v1/machine/waterLevels", Watch::WaterLevels },
+        { "/api/v1/machine/shotSettings", Watch::ShotSettings },
+        { "/api/v1/scale", Watch::Scale },
+    };
+
+    auto watched = WATCHED.constFind(request.path);
+    if (watched == WATCHED.constEnd()) return false;
+
+    QUrlQuery query(request.query);
+    const QString waitFor = query.queryItemValue("waitFor");
+    Watch watch = *watched;
+    if (waitFor == "sample" && watch == Watch::MachineState) {
+        watch = Watch::ShotSample;
+    } else if (waitFor != "change") {
+        return false;
+    }
+    // The handler answers 503 right away; waiting would only delay that
+    if (!watchAvailable(watch)) return false;
+
+    // A sample wait is always for the next sample
+    bool hasSince = false;
+    const quint64 since = query.queryItemValue("since").toULongLong(&hasSince);
+    if (watch != Watch::ShotSample && hasSince && since != watchGeneration(watch)) {
+        return false;   // Changed already
+    }
+
+    bool ok = false;
+    int timeout = query.queryItemValue("timeout").toInt(&ok);
+    timeout = ok ? qBound(1, timeout, LONG_POLL_MAX_S) : LONG_POLL_DEFAULT_S;
+
+    // Keep the notifications behind the resource on while someone waits for them
+    StreamDemand::Stream stream;
+    if (watchStream(watch, stream)) {
+        m_bridge->demand()->acquire(stream);
+    }
+
+    m_longPolls.insert(socket, { watch, request });
+    QTimer::singleShot(timeout * 1000, socket, [this, socket]() { completeLongPoll(socket); });
+    return true;
+}
+
+void HttpServer::completeLongPoll(QTcpSocket *socket)
+{
+    auto it = m_longPolls.find(socket);
+    if (it == m_longPolls.end()) return;
+    const LongPoll poll = it.value();
+    m_longPolls.erase(it);
+
+    StreamDemand::Stream stream;
+    if (watchStream(poll.watch, stream)) {
+        m_bridge->demand()->release(stream);
+    }
+
+    if (socket->state() == QAbstractSocket::ConnectedState) {
+        respond(socket, poll.request);
+    }
+}
+
+void HttpServer::wake(Watch watch)
+{
+    if (m_longPolls.isEmpty()) return;
+
+    QList<QTcpSocket*> ready;
+    for (auto it = m_longPolls.cbegin(); it != m_longPolls.cend(); ++it) {
+        if (it->watch == watch) {
+            ready.append(it.key());
+        }
+    }
+    for (QTcpSocket *socket : std::as_const(ready)) {
+        completeLongPoll(socket);
+    }
+}
+
+void HttpServer::wakeMachineState() { wake(Watch::MachineState); }
+void HttpServer::wakeShotSample() { wake(Watch::ShotSample); }
+void HttpServer::wakeWaterLevels() { wake(Watch::WaterLevels); }
+void HttpServer::wakeShotSettings() { wake(Watch::ShotSettings); }
+void HttpServer::wakeScale() { wake(Watch::Scale); }
+
+bool HttpServer::watchAvailable(Watch watch) const
+{
+    if (watch == Watch::Scale) {
+        return m_bridge->scale() && m_bridge->scale()->isConnected();
+    }
+    return m_bridge->de1() && m_bridge->de1()->isConnected();
+}
+
+quint64 HttpServer::watchGeneration(Watch watch) const
+{
+    switch (watch) {
+    case Watch::MachineState: return m_bridge->de1()->stateInfoGeneration();
+    case Watch::ShotSample: return m_bridge->de1()->stateGeneration();
+    case Watch::WaterLevels: return m_bridge->de1()->waterLevelGeneration();
+    case Watch::ShotSettings: return m_bridge->de1()->shotSettingsGeneration();
+    case Watch::Scale: return m_bridge->scale()->generation();
+    }
+    return 0;
+}
+
+bool HttpServer::watchStream(Watch watch, StreamDemand::Stream &stream)
+{
+    // State changes are always notified, and shot settings never are
+    // (only our own writes change them)
+    switch (watch) {
+    case Watch::ShotSample: stream = StreamDemand::Stream::ShotSamples; return true;
+    case Watch::WaterLevels: stream = StreamDemand::Stream::WaterLevels; return true;
+    case Watch::Scale: stream = StreamDemand::Stream::ScaleWeight; return true;
+    case Watch::MachineState:
+    case Watch::ShotSettings: return false;
+    }
+    return false;
+}
+
+void HttpServer::openEventStream(QTcpSocket *socket)
+{
+    socket->write("HTTP/1.1 200 OK\r\n"
+                  "Content-Type: text/event-stream\r\n"
+                  "Cache-Control: no-cache\r\n"
+                  "Access-Control-Allow-Origin: *\r\n"
+                  "Transfer-Encoding: chunked\r\n"
+                  "Connection: keep-alive\r\n"
+                  "\r\n");
+
+    if (m_eventStreams.isEmpty()) {
+        m_bridge->demand()->acquire(StreamDemand::Stream::ShotSamples);
+        m_bridge->demand()->acquire(StreamDemand::Stream::ScaleWeight);
+        m_keepAliveTimer.start();
+    }
+    m_eventStreams.insert(socket);
+    qCInfo(lcHttp) << "Event stream opened," << m_eventStreams.size() << "open";
+
+    // Current state first, so the client needs no separate requests
+    sendEvent(socket, "devices", cachedBody("devices", m_bridge->devicesGeneration(), [this]() { return devicesJson(); }));
+    sendEvent(socket, "discovered", m_bridge->bleManager()->discoveredDevicesJson());
+    QJsonObject scanning;
+    scanning["scanning"] = m_bridge->bleManager()->isScanning();
+    sendEvent(socket, "scanning", QJsonDocument(scanning).toJson(QJsonDocument::Compact));
+
+    if (m_bridge->de1() && m_bridge->de1()->isConnected()) {
+        QJsonObject state;
+        state["state"] = m_bridge->de1()->stateString();
+        state["substate"] = m_bridge->de1()->subStateString();
+        sendEvent(socket, "state", QJsonDocument(state).toJson(QJsonDocument::Compact));
+    }
+    if (m_bridge->scale() && m_bridge->scale()->isConnected()) {
+        sendEvent(socket, "scale", scaleJson(m_bridge->scale()->weight(), m_bridge->scale()->flowRate()));
+    }
+}
+
+void HttpServer::closeEventStream(QTcpSocket *socket)
+{
+    if (!m_eventStreams.remove(socket)) return;
+
+    qCInfo(lcHttp) << "Event stream closed," << m_eventStreams.size() << "open";
+    if (m_eventStreams.isEmpty()) {
+        m_keepAliveTimer.stop();
+        m_bridge->demand()->release(StreamDemand::Stream::ShotSamples);
+        m_bridge->demand()->release(StreamDemand::Stream::ScaleWeight);
+    }
+}
+
+void HttpServer::sendEvent(QTcpSocket *socket, const QByteArray &event, const QByteArray &data)
+{
+    socket->write(chunk("event: " + event + "\ndata: " + data + "\n\n"));
+}
+
+void HttpServer::broadcastEvent(const QByteArray &event, const QByteArray &data)
+{
+    const QByteArray payload = chunk("event: " + event + "\ndata: " + data + "\n\n");
+
+    // Copy first: aborting a socket reports the disconnect synchronously
+    const QSet<QTcpSocket*> streams = m_eventStreams;
+    for (QTcpSocket *socket : streams) {
+        if (socket->bytesToWrite() > EVENT_BACKLOG_LIMIT) {
+            qCWarning(lcHttp) << "Event stream not keeping up, dropping it";
+            closeEventStream(socket);
+            socket->abort();
+            continue;
+        }
+        socket->write(payload);
+    }
+}
+
+void HttpServer::sendKeepAlive()
+{
+    const QByteArray payload = chunk(": keep-alive\n\n");
+    for (QTcpSocket *socket : m_eventStreams) {
+        socket->write(payload);
+    }
+}
+
+void HttpServer::pushDevices()
+{
+    if (m_eventStreams.isEmpty()) return;
+    broadcastEvent("devices", cachedBody("devices", m_bridge->devicesGeneration(), [this]() { return devicesJson(); }));
+}
+
+void HttpServer::pushDiscovered()
+{
+    if (m_eventStreams.isEmpty()) return;
+    broadcastEvent("discovered", m_bridge->bleManager()->discoveredDevicesJson());
+}
+
+void HttpServer::pushScanning(bool scanning)
+{
+    if (m_eventStreams.isEmpty()) return;
+    QJsonObject obj;
+    obj["scanning"] = scanning;
+    broadcastEvent("scanning", QJsonDocument(obj).toJson(QJsonDocument::Compact));
+}
+
+void HttpServer::pushMachineState(const QJsonObject &state)
+{
+    if (m_eventStreams.isEmpty()) return;
+    broadcastEvent("state", QJsonDocument(state).toJson(QJsonDocument::Compact));
+}
+
+void HttpServer::pushShotSample(const QJsonObject &sample)
+{
+    if (m_eventStreams.isEmpty()) return;
+    broadcastEvent("machine", QJsonDocument(sample).toJson(QJsonDocument::Compact));
+}
+
+void HttpServer::pushScaleWeight(double weight, double flow)
+{
+    if (m_eventStreams.isEmpty()) return;
+    broadcastEvent("scale", scaleJson(weight, flow));
 }
 
 // Response helpers
@@ -370,6 +929,33 @@ void HttpServer::HttpResponse::setError(int code, const QString &message)
     setJson(QJsonDocument(obj).toJson(QJsonDocument::Compact));
 }
 
+const QByteArray &HttpServer::cachedBody(const QString &key, quint64 generation,
+                                         const std::function<QByteArray()> &build)
+{
+    CachedBody &entry = m_bodyCache[key];
+    if (entry.generation != generation || entry.body.isNull()) {
+        entry.body = build();
+        entry.generation = generation;
+    }
+    return entry.body;
+}
+
+void HttpServer::setCachedJson(const HttpRequest &req, HttpResponse &res, const QString &key,
+                               quint64 generation, const std::function<QByteArray()> &build)
+{
+    const QByteArray etag = "W/\"" + m_etagPrefix + '-' + QByteArray::number(generation, 36) + '"';
+    res.headers["ETag"] = QString::fromLatin1(etag);
+    res.headers["X-Generation"] = QString::number(generation);
+    res.headers["Cache-Control"] = "no-cache";
+
+    if (etagMatches(req.headers.value("if-none-match"), etag)) {
+        res.statusCode = 304;
+        res.statusText = "Not Modified";
+        return;
+    }
+    res.setJson(cachedBody(key, generation, build));
+}
+
 QByteArray HttpServer::HttpResponse::toBytes() const
 {
     QByteArray result;
@@ -385,7 +971,15 @@ QByteArray HttpServer::HttpResponse::toBytes() const
 }
 
 // Route handlers - Devices
-void HttpServer::handleGetDevices(const HttpRequest &, HttpResponse &res)
+void HttpServer::handleGetDevices(const HttpRequest &req, HttpResponse &res)
+{
+    // Pollers cannot unsubscribe; a lease keeps the weight stream on between polls
+    m_bridge->demand()->lease(StreamDemand::Stream::ScaleWeight);
+
+    setCachedJson(req, res, "devices", m_bridge->devicesGeneration(), [this]() { return devicesJson(); });
+}
+
+QByteArray HttpServer::devicesJson() const
 {
     QJsonArray devices;
 
@@ -410,7 +1004,7 @@ void HttpServer::handleGetDevices(const HttpRequest &, HttpResponse &res)
         devices.append(scale);
     }
 
-    res.setJson(QJsonDocument(devices).toJson(QJsonDocument::Compact));
+    return QJsonDocument(devices).toJson(QJsonDocument::Compact);
 }
 
 void HttpServer::handleScanDevices(const HttpRequest &req, HttpResponse &res)
@@ -423,7 +1017,7 @@ void HttpServer::handleScanDevices(const HttpRequest &req, HttpResponse &res)
     if (quick) {
         res.setJson("[]");
     } else {
-        // Returns immediately - poll /devices/discovered for results
+        // Returns immediately - results arrive on /events or /devices/discovered
         res.setJson("[]");
     }
 }
@@ -439,105 +1033,78 @@ void HttpServer::handleConnectDevice(const HttpRequest &req, HttpResponse &res)
     }
 
     // Find the device in discovered devices and connect
-    auto devices = m_bridge->bleManager()->discoveredDevices();
-
-    for (const auto &device : devices) {
-        QString addr = device.address().toString();
-        if (addr == deviceId) {
-            qCInfo(lcHttp) << "Connecting to:" << device.name();
-            // Determine device type and connect appropriately
-            if (m_bridge->bleManager()->isScale(device)) {
-                m_bridge->connectToScale(device);
-            } else if (m_bridge->bleManager()->isSensor(device)) {
-                m_bridge->connectToSensor(device);
-            }
-            res.setJson("{}");
-            return;
-        }
+    const BLEManager::DiscoveredDevice *device = m_bridge->bleManager()->discoveredDevice(deviceId);
+    if (!device) {
+        res.setError(404, "Device not found");
+        return;
     }
 
-    res.setError(404, "Device not found");
+    qCInfo(lcHttp) << "Connecting to:" << device->info.name();
+    // Determine device type and connect appropriately
+    if (device->kind == BLEManager::DeviceKind::Scale) {
+        m_bridge->connectToScale(device->info);
+    } else if (device->kind == BLEManager::DeviceKind::Sensor) {
+        m_bridge->connectToSensor(device->info);
+    }
+    res.setJson("{}");
 }
 
 void HttpServer::handleGetDiscoveredDevices(const HttpRequest &, HttpResponse &res)
 {
-    QJsonArray devices;
-
-    auto discovered = m_bridge->bleManager()->discoveredDevices();
-
-    int scaleCount = 0;
-    int sensorCount = 0;
-    for (const auto &device : discovered) {
-        QJsonObject obj;
-        obj["name"] = device.name();
-        obj["address"] = device.address().toString();
-
-        // Use BLEManager's detection logic for consistency
-        QString scaleType = m_bridge->bleManager()->scaleType(device);
-        QString sensorType = m_bridge->bleManager()->sensorType(device);
-
-        if (!scaleType.isEmpty()) {
-            obj["type"] = "scale";
-            obj["scaleType"] = scaleType;
-            scaleCount++;
-        } else if (!sensorType.isEmpty()) {
-            obj["type"] = "sensor";
-            obj["sensorType"] = sensorType;
-            sensorCount++;
-        } else if (m_bridge->bleManager()->isDE1(device)) {
-            obj["type"] = "machine";
-        } else {
-            obj["type"] = "unknown";
-        }
-
-        devices.append(obj);
-    }
-
-    qCDebug(lcHttp) << "Discovered:" << devices.size() << "devices," << scaleCount << "scales," << sensorCount << "sensors";
-    res.setJson(QJsonDocument(devices).toJson(QJsonDocument::Compact));
+    // Classified once per device and re-serialized only when the registry changes
+    res.setJson(m_bridge->bleManager()->discoveredDevicesJson());
 }
 
 // Route handlers - Machine
-void HttpServer::handleGetMachineInfo(const HttpRequest &, HttpResponse &res)
+void HttpServer::handleGetMachineInfo(const HttpRequest &req, HttpResponse &res)
 {
-    if (!m_bridge->de1() || !m_bridge->de1()->isConnected()) {
+    DE1Device *de1 = m_bridge->de1();
+    if (!de1 || !de1->isConnected()) {
         res.setError(503, "DE1 not connected");
         return;
     }
 
-    QJsonObject info;
-    info["version"] = m_bridge->de1()->firmwareVersion();
-    info["model"] = m_bridge->de1()->modelName();
-    info["serialNumber"] = m_bridge->de1()->serialNumber();
-    info["GHC"] = m_bridge->de1()->hasGHC();
-
-    res.setJson(QJsonDocument(info).toJson(QJsonDocument::Compact));
+    setCachedJson(req, res, "machine/info", de1->infoGeneration(), [de1]() {
+        QJsonObject info;
+        info["version"] = de1->firmwareVersion();
+        info["model"] = de1->modelName();
+        info["serialNumber"] = de1->serialNumber();
+        info["GHC"] = de1->hasGHC();
+        return QJsonDocument(info).toJson(QJsonDocument::Compact);
+    });
 }
 
-void HttpServer::handleGetMachineState(const HttpRequest &, HttpResponse &res)
+void HttpServer::handleGetMachineState(const HttpRequest &req, HttpResponse &res)
 {
-    if (!m_bridge->de1() || !m_bridge->de1()->isConnected()) {
+    m_bridge->demand()->lease(StreamDemand::Stream::ShotSamples);
+
+    DE1Device *de1 = m_bridge->de1();
+    if (!de1 || !de1->isConnected()) {
         res.setError(503, "DE1 not connected");
         return;
     }
 
-    QJsonObject state;
-    state["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
-
-    QJsonObject stateObj;
-    stateObj["state"] = m_bridge->de1()->stateString();
-    stateObj["substate"] = m_bridge->de1()->subStateString();
-    state["state"] = stateObj;
-
-    state["pressure"] = m_bridge->de1()->pressure();
-    state["flow"] = m_bridge->de1()->flow();
-    state["mixTemperature"] = m_bridge->de1()->mixTemp();
-    state["groupTemperature"] = m_bridge->de1()->headTemp();
-    state["targetPressure"] = m_bridge->de1()->targetPressure();
-    state["targetFlow"] = m_bridge->de1()->targetFlow();
-    state["steamTemperature"] = m_bridge->de1()->steamTemp();
-
-    res.setJson(QJsonDocument(state).toJson(QJsonDocument::Compact));
+    // The timestamp is when the readings were first served after changing
+    setCachedJson(req, res, "machine/state", de1->stateGeneration(), [de1]() {
+        QJsonObject state;
+        state["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+
+        QJsonObject stateObj;
+        stateObj["state"] = de1->stateString();
+        stateObj["substate"] = de1->subStateString();
+        state["state"] = stateObj;
+
+        state["pressure"] = de1->pressure();
+        state["flow"] = de1->flow();
+        state["mixTemperature"] = de1->mixTemp();
+        state["groupTemperature"] = de1->headTemp();
+        state["targetPressure"] = de1->targetPressure();
+        state["targetFlow"] = de1->targetFlow();
+        state["steamTemperature"] = de1->steamTemp();
+        return QJsonDocument(state).toJson(QJsonDocument::Compact);
+    });
+    // The ETag follows every sample; since= for waitFor=change follows the state
+    res.headers["X-Generation"] = QString::number(de1->stateInfoGeneration());
 }
 
 void HttpServer::handleSetMachineState(const HttpRequest &req, HttpResponse &res)
@@ -617,14 +1184,17 @@ void HttpServer::handlePostMachineSettings(const HttpRequest &req, HttpResponse
     res.setJson("{}");
 }
 
-void HttpServer::handleGetShotSettings(const HttpRequest &, HttpResponse &res)
+void HttpServer::handleGetShotSettings(const HttpRequest &req, HttpResponse &res)
 {
-    if (!m_bridge->de1() || !m_bridge->de1()->isConnected()) {
+    DE1Device *de1 = m_bridge->de1();
+    if (!de1 || !de1->isConnected()) {
         res.setError(503, "DE1 not connected");
         return;
     }
 
-    res.setJson(QJsonDocument(m_bridge->de1()->shotSettingsToJson()).toJson(QJsonDocument::Compact));
+    setCachedJson(req, res, "machine/shotSettings", de1->shotSettingsGeneration(), [de1]() {
+        return QJsonDocument(de1->shotSettingsToJson()).toJson(QJsonDocument::Compact);
+    });
 }
 
 void HttpServer::handlePostShotSettings(const HttpRequest &req, HttpResponse &res)
@@ -655,17 +1225,22 @@ void HttpServer::handlePostShotSettings(const HttpRequest &req, HttpResponse &re
 }
 
 // Route handlers - Water Levels
-void HttpServer::handleGetWaterLevels(const HttpRequest &, HttpResponse &res)
+void HttpServer::handleGetWaterLevels(const HttpRequest &req, HttpResponse &res)
 {
-    if (!m_bridge->de1() || !m_bridge->de1()->isConnected()) {
+    m_bridge->demand()->lease(StreamDemand::Stream::WaterLevels);
+
+    DE1Device *de1 = m_bridge->de1();
+    if (!de1 || !de1->isConnected()) {
         res.setError(503, "DE1 not connected");
         return;
     }
 
-    QJsonObject levels;
-    levels["currentLevel"] = m_bridge->de1()->waterLevel();
-    levels["refillLevel"] = 5; // Default refill threshold in mm
-    res.setJson(QJsonDocument(levels).toJson(QJsonDocument::Compact));
+    setCachedJson(req, res, "machine/waterLevels", de1->waterLevelGeneration(), [de1]() {
+        QJsonObject levels;
+        levels["currentLevel"] = de1->waterLevel();
+        levels["refillLevel"] = 5; // Default refill threshold in mm
+        return QJsonDocument(levels).toJson(QJsonDocument::Compact);
+    });
 }
 
 // Route handlers - Sensors
@@ -692,6 +1267,27 @@ void HttpServer::handleGetSensorById(const HttpRequest &, HttpResponse &res, con
 }
 
 // Route handlers - Scale
+void HttpServer::handleGetScale(const HttpRequest &req, HttpResponse &res)
+{
+    m_bridge->demand()->lease(StreamDemand::Stream::ScaleWeight);
+
+    ScaleDevice *scale = m_bridge->scale();
+    if (!scale || !scale->isConnected()) {
+        res.setError(503, "Scale not connected");
+        return;
+    }
+
+    setCachedJson(req, res, "scale", scale->generation(), [scale]() {
+        QJsonObject obj;
+        obj["name"] = scale->name();
+        obj["type"] = scale->type();
+        obj["weight"] = scale->weight();
+        obj["weightFlow"] = scale->flowRate();
+        obj["batteryLevel"] = scale->batteryLevel();
+        return QJsonDocument(obj).toJson(QJsonDocument::Compact);
+    });
+}
+
 void HttpServer::handleTareScale(const HttpRequest &, HttpResponse &res)
 {
     if (!m_bridge->scale() || !m_bridge->scale()->isConnected()) {
@@ -715,15 +1311,20 @@ void HttpServer::handleDisconnectScale(const HttpRequest &, HttpResponse &res)
 }
 
 // Route handlers - Settings
-void HttpServer::handleGetSettings(const HttpRequest &, HttpResponse &res)
+void HttpServer::handleGetSettings(const HttpRequest &req, HttpResponse &res)
 {
-    QJsonObject settings;
-    settings["bridgeName"] = m_bridge->settings()->bridgeName();
-    settings["httpPort"] = m_bridge->settings()->httpPort();
-    settings["webSocketPort"] = m_bridge->settings()->webSocketPort();
-    settings["autoConnect"] = m_bridge->settings()->autoConnect();
-    settings["autoConnectScale"] = m_bridge->settings()->autoConnectScale();
-    res.setJson(QJsonDocument(settings).toJson(QJsonDocument::Compact));
+    // Rebuilt only when a setting changed since the last request
+    Settings *s = m_bridge->settings();
+    setCachedJson(req, res, "settings", s->version(), [s]() {
+        QJsonObject settings;
+        settings["bridgeName"] = s->bridgeName();
+        settings["httpPort"] = s->httpPort();
+        settings["webSocketPort"] = s->webSocketPort();
+        settings["autoConnect"] = s->autoConnect();
+        settings["autoConnectScale"] = s->autoConnectScale();
+        settings["fusionRate"] = s->fusionRate();
+        return QJsonDocument(settings).toJson(QJsonDocument::Compact);
+    });
 }
 
 void HttpServer::handlePostSettings(const HttpRequest &req, HttpResponse &res)
@@ -740,6 +1341,9 @@ void HttpServer::handlePostSettings(const HttpRequest &req, HttpResponse &res)
     if (obj.contains("autoConnectScale")) {
         m_bridge->settings()->setAutoConnectScale(obj["autoConnectScale"].toBool());
     }
+    if (obj.contains("fusionRate")) {
+        m_bridge->settings()->setFusionRate(obj["fusionRate"].toInt());
+    }
 
     res.setJson("{}");
 }
@@ -993,116 +1597,137 @@ void HttpServer::handleDashboard(const HttpRequest &, HttpResponse &res)
 
         <div class="api-info">
             <a href="/api/docs" style="font-weight:bold;">API Documentation</a><br>
-            WebSocket: ws://[host]:8081/ws/v1/scale/snapshot
+            Live events: /api/v1/events (Server-Sent Events)
         </div>
     </div>
 
     )HTML" R"HTML(<script>
-        let scaleWs = null;
-        let machineWs = null;
+        let scanning = false;
+        let scaleConnected = false;
+        let discovered = [];
+
+        function showDevices(devices) {
+            const machine = devices.find(d => d.type === 'machine');
+            const scale = devices.find(d => d.type === 'scale');
+
+            document.getElementById('machine-status').className =
+                'status-dot ' + (machine ? 'connected' : 'disconnected');
+            document.getElementById('scale-status').className =
+                'status-dot ' + (scale ? 'connected' : 'disconnected');
+            document.getElementById('scale-name').textContent =
+                scale ? scale.name : '(not connected)';
+
+            if (scale && scale.weight !== undefined) {
+                document.getElementById('weight').textContent = scale.weight.toFixed(1);
+            }
+            if (!scale) {
+                document.getElementById('weight').textContent = '--';
+                document.getElementById('weight-flow').textContent = '--';
+            }
 
-        async function fetchData() {
-            try {
-                // Fetch connected devices
-                const devRes = await fetch('/api/v1/devices');
-                const devices = await devRes.json();
-
-                const machine = devices.find(d => d.type === 'machine');
-                const scale = devices.find(d => d.type === 'scale');
-
-                document.getElementById('machine-status').className =
-                    'status-dot ' + (machine ? 'connected' : 'disconnected');
-                document.getElementById('scale-status').className =
-                    'status-dot ' + (scale ? 'connected' : 'disconnected');
-                document.getElementById('scale-name').textContent =
-                    scale ? scale.name : '(not connected)';
-
-                // Update weight from API if scale connected
-                if (scale && scale.weight !== undefined) {
-                    document.getElementById('weight').textContent = scale.weight.toFixed(1);
-                }
+            scaleConnected = !!scale;
+            showDiscovered();
+        }
 
-                // If no scale connected, show discovered scales automatically
-                if (!scale && !scanning) {
-                    const discRes = await fetch('/api/v1/devices/discovered');
-                    const discovered = await discRes.json();
-                    const foundScales = discovered.filter(d => d.type === 'scale');
-                    const list = document.getElementById('scale-list');
-                    const status = document.getElementById('scan-status');
-
-                    if (foundScales.length > 0) {
-                        list.innerHTML = foundScales.map(s =>
-                            '<div class=\"scale-item\">' +
-                            '<span>' + s.name + ' <small style=\"color:#888\">(' + s.scaleType + ')</small></span>' +
-                            '<button class=\"btn-tare\" onclick=\"connectScale(\'' + s.address + '\')\">Connect</button>' +
-                            '</div>'
-                        ).join('');
-                        status.className = 'visible';
-                        status.innerHTML = foundScales.length + ' scale(s) found. Click Connect to pair.';
-                    }
-                }
+        function showDiscovered() {
+            const list = document.getElementById('scale-list');
+            const status = document.getElementById('scan-status');
 
-                document.getElementById('error').textContent = '';
-            } catch (e) {
-                document.getElementById('error').textContent = 'Connection error: ' + e.message;
+            // Once a scale is connected the list only matters during a manual scan
+            if (scaleConnected && !scanning) {
+                list.innerHTML = '';
+                status.className = '';
+                status.innerHTML = '';
+                return;
+            }
+
+            const foundScales = discovered.filter(d => d.type === 'scale');
+            list.innerHTML = foundScales.map(s =>
+                '<div class="scale-item">' +
+                '<span>' + s.name + ' <small style="color:#888">(' + s.scaleType + ')</small></span>' +
+                '<button class="btn-tare" onclick="connectScale(\'' + s.address + '\')">Connect</button>' +
+                '</div>'
+            ).join('');
+
+            if (scanning) {
+                status.className = 'visible';
+                status.innerHTML = 'Scanning for Bluetooth scales... ' + foundScales.length + ' found';
+            } else if (foundScales.length > 0) {
+                status.className = 'visible';
+                status.innerHTML = foundScales.length + ' scale(s) found. Click Connect to pair.';
             }
         }
 
-        function connectScaleWebSocket() {
-            const host = window.location.hostname;
-            scaleWs = new WebSocket('ws://' + host + ':8081/ws/v1/scale/snapshot');
+        function showScanning(active) {
+            const wasScanning = scanning;
+            scanning = active;
 
-            scaleWs.onmessage = (event) => {
-                try {
-                    const data = JSON.parse(event.data);
-                    document.getElementById('weight').textContent = (data.weight || 0).toFixed(1);
-                    document.getElementById('weight-flow').textContent = (data.weightFlow || 0).toFixed(1);
-                } catch (e) {}
-            };
+            const btn = document.getElementById('btn-scan');
+            btn.disabled = active;
+            btn.innerHTML = active ? '<span class="spinner"></span>Scanning...' : 'Scan for Scale';
+            showDiscovered();
+
+            if (wasScanning && !active && !scaleConnected &&
+                    !discovered.some(d => d.type === 'scale')) {
+                const status = document.getElementById('scan-status');
+                status.className = 'visible';
+                status.innerHTML = 'No scales found. Make sure your scale is on and in pairing mode.';
+            }
+        }
 
-            scaleWs.onclose = () => setTimeout(connectScaleWebSocket, 2000);
-            scaleWs.onerror = () => scaleWs.close();
+        function showState(state) {
+            if (!state.state) return;
+            document.getElementById('machine-state').textContent = state.state;
+            document.getElementById('machine-state').className = 'state-badge state-' + state.state;
         }
 
-        function connectMachineWebSocket() {
-            const host = window.location.hostname;
-            machineWs = new WebSocket('ws://' + host + ':8081/ws/v1/machine/snapshot');
-
-            machineWs.onmessage = (event) => {
-                try {
-                    const data = JSON.parse(event.data);
-                    // Update machine metrics from real-time shot samples
-                    if (data.groupTemperature !== undefined) {
-                        document.getElementById('group-temp').textContent = Math.round(data.groupTemperature) + '°';
-                    }
-                    if (data.steamTemperature !== undefined) {
-                        document.getElementById('steam-temp').textContent = Math.round(data.steamTemperature) + '°';
-                    }
-                    if (data.pressure !== undefined) {
-                        document.getElementById('pressure').textContent = data.pressure.toFixed(1);
-                    }
-                    if (data.flow !== undefined) {
-                        document.getElementById('flow').textContent = data.flow.toFixed(1);
-                    }
-                    // Update state if present
-                    if (data.state?.state) {
-                        const stateName = data.state.state;
-                        document.getElementById('machine-state').textContent = stateName;
-                        document.getElementById('machine-state').className = 'state-badge state-' + stateName;
-                    }
-                    // Mark machine as connected
-                    document.getElementById('machine-status').className = 'status-dot connected';
-                } catch (e) {}
-            };
+        function showMachine(data) {
+            if (data.groupTemperature !== undefined) {
+                document.getElementById('group-temp').textContent = Math.round(data.groupTemperature) + '°';
+            }
+            if (data.steamTemperature !== undefined) {
+                document.getElementById('steam-temp').textContent = Math.round(data.steamTemperature) + '°';
+            }
+            if (data.pressure !== undefined) {
+                document.getElementById('pressure').textContent = data.pressure.toFixed(1);
+            }
+            if (data.flow !== undefined) {
+                document.getElementById('flow').textContent = data.flow.toFixed(1);
+            }
+            if (data.state) {
+                showState(data.state);
+            }
+        }
+
+        function showScale(data) {
+            document.getElementById('weight').textContent = (data.weight || 0).toFixed(1);
+            document.getElementById('weight-flow').textContent = (data.weightFlow || 0).toFixed(1);
+        }
 
-            machineWs.onclose = () => setTimeout(connectMachineWebSocket, 2000);
-            machineWs.onerror = () => machineWs.close();
+        // One stream carries everything; EventSource reconnects by itself and
+        // the server resends the current state on every connect
+        function connectEvents() {
+            const events = new EventSource('/api/v1/events');
+            const on = (name, handler) => events.addEventListener(name, (e) => {
+                try { handler(JSON.parse(e.data)); } catch (err) {}
+            });
+
+            on('devices', showDevices);
+            on('discovered', (devices) => { discovered = devices; showDiscovered(); });
+            on('scanning', (data) => showScanning(data.scanning));
+            on('state', showState);
+            on('machine', showMachine);
+            on('scale', showScale);
+
+            events.onopen = () => { document.getElementById('error').textContent = ''; };
+            events.onerror = () => {
+                document.getElementById('error').textContent = 'Connection lost, reconnecting...';
+            };
         }
 
         async function setState(state) {
             try {
                 await fetch('/api/v1/machine/state/' + state, { method: 'PUT' });
-                setTimeout(fetchData, 500);
             } catch (e) {
                 document.getElementById('error').textContent = 'Failed to set state: ' + e.message;
             }
@@ -1119,97 +1744,32 @@ void HttpServer::handleDashboard(const HttpRequest &, HttpResponse &res)
         async function disconnectScale() {
             try {
                 await fetch('/api/v1/scale/disconnect', { method: 'PUT' });
-                document.getElementById('weight').textContent = '--';
-                document.getElementById('weight-flow').textContent = '--';
-                setTimeout(fetchData, 500);
             } catch (e) {
                 document.getElementById('error').textContent = 'Failed to disconnect: ' + e.message;
             }
         }
 
-        let scanning = false;
-        let stopScan = false;
-
         async function scanForScales() {
             if (scanning) return;
 
-            const btn = document.getElementById('btn-scan');
             const status = document.getElementById('scan-status');
-            const list = document.getElementById('scale-list');
-
-            scanning = true;
-            stopScan = false;
-            btn.disabled = true;
-            btn.innerHTML = '<span class="spinner"></span>Scanning...';
             status.className = 'visible';
             status.innerHTML = 'Scanning for Bluetooth scales...';
-            list.innerHTML = '';
+            document.getElementById('scale-list').innerHTML = '';
 
             try {
-                // Start scan
+                // Progress and results arrive as scanning/discovered events
                 await fetch('/api/v1/devices/scan');
-
-                // Poll for results over 10 seconds
-                let foundScales = [];
-                for (let i = 0; i < 10 && !stopScan; i++) {
-                    await new Promise(r => setTimeout(r, 1000));
-                    if (stopScan) break;
-
-                    status.innerHTML = 'Scanning... ' + (10 - i) + 's remaining';
-
-                    const res = await fetch('/api/v1/devices/discovered');
-                    const devices = await res.json();
-                    foundScales = devices.filter(d => d.type === 'scale');
-
-                    // Update list
-                    if (foundScales.length > 0) {
-                        list.innerHTML = foundScales.map(s =>
-                            '<div class="scale-item">' +
-                            '<span>' + s.name + ' <small style="color:#888">(' + s.scaleType + ')</small></span>' +
-                            '<button class="btn-tare" onclick="connectScale(\'' + s.address + '\')">Connect</button>' +
-                            '</div>'
-                        ).join('');
-                    }
-                }
-
-                if (!stopScan) {
-                    if (foundScales.length === 0) {
-                        status.innerHTML = 'No scales found. Make sure your scale is on and in pairing mode.';
-                    } else {
-                        status.innerHTML = 'Found ' + foundScales.length + ' scale(s). Click Connect to pair.';
-                    }
-                }
-
             } catch (e) {
-                if (!stopScan) {
-                    status.innerHTML = 'Scan failed: ' + e.message;
-                }
-            } finally {
-                scanning = false;
-                btn.disabled = false;
-                btn.innerHTML = 'Scan for Scale';
+                status.innerHTML = 'Scan failed: ' + e.message;
             }
         }
 
-        function resetScanUI() {
-            const btn = document.getElementById('btn-scan');
-            const status = document.getElementById('scan-status');
-            const list = document.getElementById('scale-list');
-            status.className = '';
-            status.innerHTML = '';
-            list.innerHTML = '';
-            btn.disabled = false;
-            btn.innerHTML = 'Scan for Scale';
-        }
-
         async function connectScale(address) {
-            // Stop scanning immediately
-            stopScan = true;
-            scanning = false;
-
             const status = document.getElementById('scan-status');
             const list = document.getElementById('scale-list');
             list.innerHTML = '';
+            status.className = 'visible';
             status.innerHTML = '<span class="spinner"></span>Connecting to scale...';
 
             try {
@@ -1217,13 +1777,8 @@ void HttpServer::handleDashboard(const HttpRequest &, HttpResponse &res)
                     method: 'PUT'
                 });
 
-                if (res.ok) {
-                    status.innerHTML = 'Connected!';
-                    setTimeout(() => {
-                        resetScanUI();
-                        fetchData();
-                    }, 1000);
-                } else {
+                // The devices event reports the connection once it is up
+                if (!res.ok) {
                     status.innerHTML = 'Failed to connect. Try again.';
                 }
             } catch (e) {
@@ -1231,11 +1786,7 @@ void HttpServer::handleDashboard(const HttpRequest &, HttpResponse &res)
             }
         }
 
-        // Initial fetch and start polling (slower since WebSocket handles real-time data)
-        fetchData();
-        setInterval(fetchData, 5000);
-        connectScaleWebSocket();
-        connectMachineWebSocket();
+        connectEvents();
     </script>
 </body>
 </html>
@@ -1296,7 +1847,7 @@ void HttpServer::handlePutDevSkin(const HttpRequest &req, HttpResponse &res, con
         return;
     }
 
-    if (filePath.isEmpty() || filePath.contains("..")) {
+    if (filePath.isEmpty() || filePath.contains("..") || isHiddenPath(filePath)) {
         res.setError(400, "Invalid path");
         return;
     }
@@ -1307,16 +1858,40 @@ void HttpServer::handlePutDevSkin(const HttpRequest &req, HttpResponse &res, con
     QFileInfo fi(fullPath);
     QDir().mkpath(fi.absolutePath());
 
-    QFile file(fullPath);
-    if (!file.open(QIODevice::WriteOnly)) {
-        res.setError(500, "Failed to write: " + filePath);
-        return;
+    // Non-empty uploads arrive streamed to a temporary file; move it into place
+    qint64 size = 0;
+    if (req.bodyFile) {
+        QTemporaryFile &upload = *req.bodyFile;
+        size = upload.size();
+        upload.close();
+        QFile::remove(fullPath);
+        // Once renamed the file is ours to keep; left on, auto-remove would
+        // delete it from the skin tree when the request goes away
+        upload.setAutoRemove(false);
+        bool stored = upload.rename(fullPath);
+        if (!stored) {
+            // Different filesystem: copy, then clean up the temporary file
+            stored = QFile::copy(upload.fileName(), fullPath);
+            QFile::remove(upload.fileName());
+        }
+        if (!stored) {
+            res.setError(500, "Failed to write: " + filePath);
+            return;
+        }
+        // Temporary files are created owner-only (0600)
+        QFile::setPermissions(fullPath, QFileDevice::ReadOwner | QFileDevice::WriteOwner
+                                            | QFileDevice::ReadGroup | QFileDevice::ReadOther);
+    } else {
+        QFile file(fullPath);
+        if (!file.open(QIODevice::WriteOnly)) {
+            res.setError(500, "Failed to write: " + filePath);
+            return;
+        }
+        size = file.write(req.body);
+        file.close();
     }
 
-    file.write(req.body);
-    file.close();
-
-    qCInfo(lcHttp) << "Dev skin update:" << filePath << "(" << req.body.size() << "bytes)";
+    qCInfo(lcHttp) << "Dev skin update:" << filePath << "(" << size << "bytes)";
     res.setJson("{}");
 }
 
@@ -1331,12 +1906,17 @@ void HttpServer::setSkinRoot(const QString &path)
     }
 }
 
+void HttpServer::setSkinArchive(std::shared_ptr<const ZipFileSystem> archive)
+{
+    m_skinArchive = std::move(archive);
+}
+
 bool HttpServer::serveStaticFile(const HttpRequest &req, HttpResponse &res)
 {
     QString path = req.path;
 
-    // Prevent directory traversal
-    if (path.contains("..")) return false;
+    // Prevent directory traversal; hidden files (the skin manifest) are not served
+    if (path.contains("..") || isHiddenPath(path)) return false;
 
     // Serve index.html for root or directory requests
     if (path == "/") {
@@ -1351,7 +1931,10 @@ bool HttpServer::serveStaticFile(const HttpRequest &req, HttpResponse &res)
         fi = QFileInfo(filePath);
     }
 
-    if (!fi.exists() || !fi.isFile()) return false;
+    // Files on disk (e.g. pushed via /api/v1/dev/skin) override the archive
+    if (!fi.exists() || !fi.isFile()) {
+        return m_skinArchive && serveArchiveFile(req, res, path.mid(1));
+    }
 
     // Security: ensure resolved path is within skin root
     QString canonical = fi.canonicalFilePath();
@@ -1366,6 +1949,34 @@ bool HttpServer::serveStaticFile(const HttpRequest &req, HttpResponse &res)
     return true;
 }
 
+bool HttpServer::serveArchiveFile(const HttpRequest &req, HttpResponse &res, const QString &path)
+{
+    QString entryPath = path;
+    if (entryPath.endsWith('/')) entryPath += "index.html";
+    if (!m_skinArchive->contains(entryPath)) {
+        entryPath += "/index.html";
+        if (!m_skinArchive->contains(entryPath)) return false;
+    }
+
+    res.headers["Content-Type"] = guessMimeType(entryPath);
+    res.headers["Cache-Control"] = "public, max-age=3600";
+    res.headers["Vary"] = "Accept-Encoding";
+
+    // Hand deflated entries to the client as-is, wrapped in a gzip frame
+    if (acceptsGzip(req.headers.value("accept-encoding"))) {
+        QByteArray gzip = m_skinArchive->readGzip(entryPath);
+        if (!gzip.isEmpty()) {
+            res.headers["Content-Encoding"] = "gzip";
+            res.body = gzip;
+            return true;
+        }
+    }
+
+    const ZipFileSystem::Entry *entry = m_skinArchive->entry(entryPath);
+    res.body = m_skinArchive->read(entryPath);
+    return !res.body.isEmpty() || entry->size == 0;
+}
+
 QString HttpServer::guessMimeType(const QString &filename) const
 {
     static const QMap<QString, QString> mimeTypes = {
@@ -1406,40 +2017,88 @@ QString HttpServer::storeDir() const
 // Route handlers - Key-value store
 void HttpServer::handleGetStore(const HttpRequest &, HttpResponse &res, const QString &ns, const QString &key)
 {
-    QString filePath = storeDir() + "/" + ns + "/" + key + ".json";
-    QFile file(filePath);
+    if (!KeyValueStore::isValidName(ns) || !KeyValueStore::isValidName(key)) {
+        res.setError(400, "Invalid namespace or key");
+        return;
+    }
 
-    if (!file.exists()) {
+    QByteArray value = m_store->value(ns, key);
+    if (value.isNull()) {
         // Return null for missing keys (skin expects this, not a 404)
         res.setJson("null");
         return;
     }
 
-    if (!file.open(QIODevice::ReadOnly)) {
-        res.setError(500, "Failed to read store");
+    res.headers["Content-Type"] = "application/json";
+    res.body = value;
+}
+
+void HttpServer::handlePostStore(const HttpRequest &req, HttpResponse &res, const QString &ns, const QString &key)
+{
+    if (!KeyValueStore::isValidName(ns) || !KeyValueStore::isValidName(key)) {
+        res.setError(400, "Invalid namespace or key");
         return;
     }
 
-    res.headers["Content-Type"] = "application/json";
-    res.body = file.readAll();
+    m_store->put(ns, key, req.body);
+    res.setJson("{}");
 }
 
-void HttpServer::handlePostStore(const HttpRequest &req, HttpResponse &res, const QString &ns, const QString &key)
+// GET /api/v1/store/:namespace?keys=a,b,c - several keys in one consistent read
+void HttpServer::handleGetStoreBatch(const HttpRequest &req, HttpResponse &res, const QString &ns)
 {
-    QString dir = storeDir() + "/" + ns;
-    QDir().mkpath(dir);
+    if (!KeyValueStore::isValidName(ns)) {
+        res.setError(400, "Invalid namespace");
+        return;
+    }
 
-    QString filePath = dir + "/" + key + ".json";
-    QFile file(filePath);
+    QUrlQuery query(req.query);
+    QStringList keys = query.queryItemValue("keys", QUrl::FullyDecoded).split(',', Qt::SkipEmptyParts);
+    QHash<QString, QByteArray> values = m_store->values(ns, keys);
+    if (keys.isEmpty()) keys = values.keys();
 
-    if (!file.open(QIODevice::WriteOnly)) {
-        res.setError(500, "Failed to write store");
+    QJsonObject obj;
+    for (const QString &key : keys) {
+        auto it = values.constFind(key);
+        if (it == values.constEnd()) {
+            obj[key] = QJsonValue::Null;
+            continue;
+        }
+        // Values are stored as raw JSON text; wrapping in an array lets scalars parse too
+        QJsonDocument doc = QJsonDocument::fromJson("[" + it.value() + "]");
+        obj[key] = doc.isArray() ? doc.array().at(0) : QJsonValue(QString::fromUtf8(it.value()));
+    }
+    res.setJson(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+}
+
+// POST /api/v1/store/:namespace with {"key": value, ...} - all keys are written atomically
+void HttpServer::handlePostStoreBatch(const HttpRequest &req, HttpResponse &res, const QString &ns)
+{
+    if (!KeyValueStore::isValidName(ns)) {
+        res.setError(400, "Invalid namespace");
         return;
     }
 
-    file.write(req.body);
-    file.close();
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(req.body, &error);
+    if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+        res.setError(400, "Expected a JSON object of key/value pairs");
+        return;
+    }
 
+    QJsonObject obj = doc.object();
+    QHash<QString, QByteArray> entries;
+    for (auto it = obj.constBegin(); it != obj.constEnd(); ++it) {
+        if (!KeyValueStore::isValidName(it.key())) {
+            res.setError(400, "Invalid key: " + it.key());
+            return;
+        }
+        // Serialize through a one-element array so scalars round-trip as JSON text
+        QByteArray json = QJsonDocument(QJsonArray{it.value()}).toJson(QJsonDocument::Compact);
+        entries.insert(it.key(), json.mid(1, json.size() - 2));
+    }
+
+    m_store->put(ns, entries);
     res.setJson("{}");
 }
 
@@ -1497,12 +2156,14 @@ QString HttpServer::profilesDir() const
     return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/profiles";
 }
 
-// Copy bundled default profiles to disk if not already present
-void HttpServer::ensureDefaultProfiles()
+// Copy bundled default profiles to disk if not already present.
+// Runs off the event loop; until a profile has been copied, the profile
+// handlers read it straight from the resource bundle.
+int HttpServer::ensureDefaultProfiles(const QString &dir)
 {
-    QString dir = profilesDir();
     QDir().mkpath(dir);
 
+    int copied = 0;
     QDir resourceDir(":/assets/profiles");
     for (const QString &filename : resourceDir.entryList({"*.json"})) {
         if (filename == "manifest.json") continue;
@@ -1512,15 +2173,43 @@ void HttpServer::ensureDefaultProfiles()
             QFile::copy(":/assets/profiles/" + filename, destPath);
             // Qt resource copies are read-only — make writable
             QFile::setPermissions(destPath, QFile::ReadOwner | QFile::WriteOwner);
+            copied++;
         }
     }
+    return copied;
+}
+
+void HttpServer::provisionDefaultProfiles()
+{
+    const QString dir = profilesDir();
+    QThreadPool::globalInstance()->start([dir]() {
+        QElapsedTimer timer;
+        timer.start();
+        int copied = ensureDefaultProfiles(dir);
+        qCInfo(lcHttp) << "Provisioned" << copied << "default profiles in" << timer.elapsed() << "ms";
+    });
+}
+
+// Wrap a profile in the ProfileRecord format expected by skin:
+// { id, profile: {...}, visibility, isDefault, createdAt, updatedAt }
+static QJsonObject profileRecord(const QString &id, const QJsonObject &profile,
+                                 bool isDefault, const QFileInfo &fi)
+{
+    QJsonObject record;
+    record["id"] = id;
+    record["profile"] = profile;
+    record["visibility"] = QStringLiteral("visible");
+    record["isDefault"] = isDefault;
+    QString timestamp = QDateTime::fromMSecsSinceEpoch(
+        fi.lastModified().toMSecsSinceEpoch()).toUTC().toString(Qt::ISODate);
+    record["createdAt"] = timestamp;
+    record["updatedAt"] = timestamp;
+    return record;
 }
 
 // Route handlers - Profiles
 void HttpServer::handleGetProfiles(const HttpRequest &, HttpResponse &res)
 {
-    ensureDefaultProfiles();
-
     // Build set of default profile filenames for the "isDefault" flag
     QSet<QString> defaults;
     QFile manifest(":/assets/profiles/manifest.json");
@@ -1530,9 +2219,18 @@ void HttpServer::handleGetProfiles(const HttpRequest &, HttpResponse &res)
             defaults.insert(v.toString());
     }
 
+    // On-disk profiles first, then bundled profiles not yet copied to disk
+    QFileInfoList files = QDir(profilesDir()).entryInfoList({"*.json"}, QDir::Files);
+    QSet<QString> onDisk;
+    for (const QFileInfo &fi : files)
+        onDisk.insert(fi.fileName());
+    for (const QFileInfo &fi : QDir(":/assets/profiles").entryInfoList({"*.json"}, QDir::Files)) {
+        if (!onDisk.contains(fi.fileName()))
+            files.append(fi);
+    }
+
     QJsonArray profiles;
-    QDir dir(profilesDir());
-    for (const QFileInfo &fi : dir.entryInfoList({"*.json"}, QDir::Files)) {
+    for (const QFileInfo &fi : files) {
         if (fi.fileName() == "manifest.json") continue;
 
         QFile file(fi.absoluteFilePath());
@@ -1541,21 +2239,8 @@ void HttpServer::handleGetProfiles(const HttpRequest &, HttpResponse &res)
         QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
         if (!doc.isObject()) continue;
 
-        QJsonObject profile = doc.object();
         QString id = fi.completeBaseName(); // filename without .json
-
-        // Wrap in ProfileRecord format expected by skin:
-        // { id, profile: {...}, visibility, isDefault, createdAt, updatedAt }
-        QJsonObject record;
-        record["id"] = id;
-        record["profile"] = profile;
-        record["visibility"] = QStringLiteral("visible");
-        record["isDefault"] = defaults.contains(fi.fileName());
-        QString timestamp = QDateTime::fromMSecsSinceEpoch(
-            fi.lastModified().toMSecsSinceEpoch()).toUTC().toString(Qt::ISODate);
-        record["createdAt"] = timestamp;
-        record["updatedAt"] = timestamp;
-        profiles.append(record);
+        profiles.append(profileRecord(id, doc.object(), defaults.contains(fi.fileName()), fi));
     }
 
     res.setJson(QJsonDocument(profiles).toJson(QJsonDocument::Compact));
@@ -1563,17 +2248,20 @@ void HttpServer::handleGetProfiles(const HttpRequest &, HttpResponse &res)
 
 void HttpServer::handleGetProfileById(const HttpRequest &, HttpResponse &res, const QString &id)
 {
-    ensureDefaultProfiles();
-
     // Sanitize id - no path separators
     if (id.contains('/') || id.contains('\\') || id.contains("..")) {
         res.setError(400, "Invalid profile id");
         return;
     }
 
+    QString resourcePath = ":/assets/profiles/" + id + ".json";
     QString filePath = profilesDir() + "/" + id + ".json";
-    QFile file(filePath);
+    if (!QFile::exists(filePath)) {
+        // Bundled profile that has not been copied to disk yet
+        filePath = resourcePath;
+    }
 
+    QFile file(filePath);
     if (!file.exists() || !file.open(QIODevice::ReadOnly)) {
         res.setError(404, "Profile not found");
         return;
@@ -1582,17 +2270,7 @@ void HttpServer::handleGetProfileById(const HttpRequest &, HttpResponse &res, co
     QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
     QFileInfo fi(filePath);
 
-    // Wrap in ProfileRecord format
-    QJsonObject record;
-    record["id"] = id;
-    record["profile"] = doc.object();
-    record["visibility"] = QStringLiteral("visible");
-    record["isDefault"] = QFile::exists(":/assets/profiles/" + id + ".json");
-    QString timestamp = QDateTime::fromMSecsSinceEpoch(
-        fi.lastModified().toMSecsSinceEpoch()).toUTC().toString(Qt::ISODate);
-    record["createdAt"] = timestamp;
-    record["updatedAt"] = timestamp;
-
+    QJsonObject record = profileRecord(id, doc.object(), QFile::exists(resourcePath), fi);
     res.setJson(QJsonDocument(record).toJson(QJsonDocument::Compact));
 }
 
@@ -4,16 +4,53 @@
 #include <QObject>
 #include <QTcpServer>
 #include <QTcpSocket>
+#include <QHash>
+#include <QJsonObject>
 #include <QMap>
+#include <QSet>
+#include <QTimer>
+#include <QElapsedTimer>
 #include <functional>
+#include <memory>
+
+#include "core/streamdemand.h"
 
 class Bridge;
+class KeyValueStore;
+class QTemporaryFile;
+class ZipFileSystem;
 
 /**
  * @brief Lightweight HTTP REST server
  *
  * Provides REST API for DE1 espresso machine control and scale interaction.
  * See /api/docs for interactive API documentation (Swagger UI).
+ *
+ * GET /api/v1/events is a Server-Sent Events stream: the response is sent
+ * chunked and kept open, and the push slots write device, discovery, state
+ * and telemetry changes to every open stream as they happen.
+ *
+ * Read-only device endpoints keep their serialized body together with the
+ * device's data generation and only rebuild it when that moves. They send
+ * a weak ETag derived from the generation and answer a matching
+ * If-None-Match with 304; X-Generation carries the generation itself.
+ *
+ * The machine state, water level, shot settings and scale endpoints take
+ * ?waitFor=change[&since=<generation>][&timeout=<seconds>]. If the
+ * generation still equals since (or since is absent) the socket is parked
+ * and answered when the matching wake slot fires, or with the unchanged
+ * representation after the timeout. The machine state only counts state
+ * and substate changes as a change; ?waitFor=sample waits for the next
+ * shot sample instead (and keeps shot samples streaming meanwhile).
+ *
+ * Request bodies are bounded per route and a request is rejected with 413
+ * as soon as its headers announce more than the route takes, before any
+ * of the body is read. File uploads are streamed to a temporary file
+ * instead of memory. The in-memory bodies of all connections together, and
+ * the temporary files of all uploads together, have fixed budgets; past
+ * them new requests get 503. A request must arrive in full within the
+ * request timeout (a streamed upload: without stalling that long), or it
+ * is answered with 408 and its share of the budgets is released.
  */
 class HttpServer : public QObject
 {
@@ -27,8 +64,33 @@ public:
     void stop();
 
     bool isRunning() const { return m_server && m_server->isListening(); }
+    quint16 serverPort() const { return m_server ? m_server->serverPort() : 0; }
+
+    // How long a connection may take to deliver its request
+    void setRequestTimeout(int ms) { m_requestTimeoutMs = ms; }
 
     void setSkinRoot(const QString &path);
+    // Archive to serve skin files from when they are not on disk under the skin root
+    void setSkinArchive(std::shared_ptr<const ZipFileSystem> archive);
+
+    // Copy bundled profiles to disk on a worker thread (off the startup path)
+    void provisionDefaultProfiles();
+
+public slots:
+    // Long polls; each answers the requests waiting on that resource
+    void wakeMachineState();
+    void wakeShotSample();
+    void wakeWaterLevels();
+    void wakeShotSettings();
+    void wakeScale();
+
+    // Server-Sent Events; each is a no-op while no stream is open
+    void pushDevices();
+    void pushDiscovered();
+    void pushScanning(bool scanning);
+    void pushMachineState(const QJsonObject &state);
+    void pushShotSample(const QJsonObject &sample);
+    void pushScaleWeight(double weight, double flow);
 
 signals:
     void requestReceived(const QString &method, const QString &path);
@@ -46,6 +108,20 @@ private:
         QString query;
         QMap<QString, QString> headers;
         QByteArray body;
+        // Streamed upload routes get the body here instead (body stays empty)
+        std::shared_ptr<QTemporaryFile> bodyFile;
+    };
+
+    // A request whose body is still arriving
+    struct PendingRequest {
+        QByteArray buffer;          // Headers until parsed, then the in-memory body
+        HttpRequest request;
+        bool headersParsed = false;
+        bool rejected = false;      // Answered already; input is discarded
+        qint64 contentLength = 0;
+        qint64 received = 0;
+        qint64 reserved = 0;        // Share of the in-memory body budget held
+        qint64 reservedFile = 0;    // Share of the temporary file budget held
     };
 
     struct HttpResponse {
@@ -61,9 +137,57 @@ private:
 
     using RouteHandler = std::function<void(const HttpRequest&, HttpResponse&)>;
 
+    // Resources a long poll can wait on
+    enum class Watch { MachineState, ShotSample, WaterLevels, ShotSettings, Scale };
+
+    struct LongPoll {
+        Watch watch;
+        HttpRequest request;
+    };
+
     void setupRoutes();
     void handleRequest(QTcpSocket *socket, const HttpRequest &request);
-    bool parseRequest(const QByteArray &data, HttpRequest &request);
+    void respond(QTcpSocket *socket, const HttpRequest &request);
+    void routeRequest(const HttpRequest &request, HttpResponse &response);
+    static void addCorsHeaders(HttpResponse &response);
+    void sendResponse(QTcpSocket *socket, const HttpResponse &response);
+    // Request line and headers; the body is read separately
+    bool parseRequestHead(const QByteArray &head, HttpRequest &request);
+    // Checks the parsed head against the route's limits and prepares for
+    // the body; false if the request was rejected
+    bool readRequestHead(QTcpSocket *socket, PendingRequest &pending);
+    // False if the request was rejected
+    bool appendBody(QTcpSocket *socket, PendingRequest &pending, const QByteArray &data);
+    void rejectRequest(QTcpSocket *socket, int code, const QString &message);
+    void dropPending(QTcpSocket *socket);
+    void onRequestTimeout(QTcpSocket *socket);
+    // The request has arrived, or the socket no longer carries one
+    void clearDeadline(QTcpSocket *socket);
+
+    // Long polls
+    bool parkLongPoll(QTcpSocket *socket, const HttpRequest &request);
+    void completeLongPoll(QTcpSocket *socket);
+    void wake(Watch watch);
+    bool watchAvailable(Watch watch) const;
+    quint64 watchGeneration(Watch watch) const;
+    // False if nothing needs to stay subscribed for the resource
+    static bool watchStream(Watch watch, StreamDemand::Stream &stream);
+
+    // Server-Sent Events
+    void openEventStream(QTcpSocket *socket);
+    void closeEventStream(QTcpSocket *socket);
+    void sendEvent(QTcpSocket *socket, const QByteArray &event, const QByteArray &data);
+    void broadcastEvent(const QByteArray &event, const QByteArray &data);
+    void sendKeepAlive();
+
+    QByteArray devicesJson() const;
+
+    // Body for key as of generation, built only if the cached one is older
+    const QByteArray &cachedBody(const QString &key, quint64 generation,
+                                 const std::function<QByteArray()> &build);
+    // cachedBody() as a JSON response with an ETag, or 304 if the client has it
+    void setCachedJson(const HttpRequest &req, HttpResponse &res, const QString &key,
+                       quint64 generation, const std::function<QByteArray()> &build);
 
     // Route handlers - Devices
     void handleGetDevices(const HttpRequest &req, HttpResponse &res);
@@ -82,6 +206,7 @@ private:
     void handlePostShotSettings(const HttpRequest &req, HttpResponse &res);
 
     // Route handlers - Scale
+    void handleGetScale(const HttpRequest &req, HttpResponse &res);
     void handleTareScale(const HttpRequest &req, HttpResponse &res);
     void handleDisconnectScale(const HttpRequest &req, HttpResponse &res);
 
@@ -99,6 +224,8 @@ private:
     // Route handlers - Key-value store, workflow, shots
     void handleGetStore(const HttpRequest &req, HttpResponse &res, const QString &ns, const QString &key);
     void handlePostStore(const HttpRequest &req, HttpResponse &res, const QString &ns, const QString &key);
+    void handleGetStoreBatch(const HttpRequest &req, HttpResponse &res, const QString &ns);
+    void handlePostStoreBatch(const HttpRequest &req, HttpResponse &res, const QString &ns);
     void handleGetWorkflow(const HttpRequest &req, HttpResponse &res);
     void handlePutWorkflow(const HttpRequest &req, HttpResponse &res);
     void handleGetShots(const HttpRequest &req, HttpResponse &res);
@@ -111,7 +238,7 @@ private:
 
     QString storeDir() const;
     QString profilesDir() const;
-    void ensureDefaultProfiles();
+    static int ensureDefaultProfiles(const QString &dir);
 
     // Dev tools
     void handlePutDevSkin(const HttpRequest &req, HttpResponse &res, const QString &filePath);
@@ -126,15 +253,35 @@ private:
 
     // Static file serving
     bool serveStaticFile(const HttpRequest &req, HttpResponse &res);
+    bool serveArchiveFile(const HttpRequest &req, HttpResponse &res, const QString &path);
     QString guessMimeType(const QString &filename) const;
 
     Bridge *m_bridge;
+    std::unique_ptr<KeyValueStore> m_store;
     QTcpServer *m_server = nullptr;
     QMap<QString, RouteHandler> m_getRoutes;
     QMap<QString, RouteHandler> m_postRoutes;
     QMap<QString, RouteHandler> m_putRoutes;
-    QMap<QTcpSocket*, QByteArray> m_socketBuffers;
+    QHash<QTcpSocket*, PendingRequest> m_pending;
+    qint64 m_bufferedBytes = 0;     // Reserved by in-memory bodies of all pending requests
+    qint64 m_streamedBytes = 0;     // Reserved by temporary files of all pending uploads
+    QHash<QTcpSocket*, QTimer*> m_deadlines;
+    int m_requestTimeoutMs;
+    QSet<QTcpSocket*> m_eventStreams;
+    QHash<QTcpSocket*, LongPoll> m_longPolls;
+    QTimer m_keepAliveTimer;
     QString m_skinRoot;
+    std::shared_ptr<const ZipFileSystem> m_skinArchive;
+
+    struct CachedBody {
+        quint64 generation = 0;
+        QByteArray body;
+    };
+    QHash<QString, CachedBody> m_bodyCache;
+    QByteArray m_etagPrefix;    // Per process, so a restart never revalidates an old body
+
+    QElapsedTimer m_startupTimer;
+    bool m_firstResponseSent = false;
 };
 
 #endif // HTTPSERVER_H
@@ -1,5 +1,6 @@
 #include "websocketserver.h"
 #include "core/bridge.h"
+#include "core/streamdemand.h"
 #include "ble/de1device.h"
 #include "ble/scaledevice.h"
 #include "ble/sensordevice.h"
@@ -52,12 +53,15 @@ void WebSocketServer::stop()
 {
     if (m_server) {
         // Close all client connections
-        for (auto &subscribers : m_subscribers) {
-            for (QWebSocket *socket : subscribers) {
+        // Detach first: close() may report the disconnect synchronously
+        const QMap<Channel, QSet<QWebSocket*>> subscribers = m_subscribers;
+        m_subscribers.clear();
+        for (auto it = subscribers.cbegin(); it != subscribers.cend(); ++it) {
+            for (QWebSocket *socket : it.value()) {
+                updateStreamDemand(it.key(), false);
                 socket->close();
             }
         }
-        m_subscribers.clear();
 
         m_server->close();
         delete m_server;
@@ -109,6 +113,7 @@ void WebSocketServer::onNewConnection()
             }
         } else {
             m_subscribers[channel].insert(socket);
+            updateStreamDemand(channel, true);
         }
 
         qCDebug(lcWebSocket) << "Client connected to" << path;
@@ -131,6 +136,12 @@ void WebSocketServer::onNewConnection()
                     socket->sendTextMessage(QJsonDocument(obj).toJson(QJsonDocument::Compact));
                 }
                 break;
+            case Channel::Temperatures:
+                if (m_bridge->de1() && m_bridge->de1()->hasTemperatures()) {
+                    QByteArray data = QJsonDocument(m_bridge->de1()->temperaturesToJson()).toJson(QJsonDocument::Compact);
+                    socket->sendTextMessage(QString::fromUtf8(data));
+                }
+                break;
             default:
                 break;
         }
@@ -164,8 +175,10 @@ void WebSocketServer::onDisconnected()
     if (!socket) return;
 
     // Remove from all subscriber lists
-    for (auto &subscribers : m_subscribers) {
-        subscribers.remove(socket);
+    for (auto it = m_subscribers.begin(); it != m_subscribers.end(); ++it) {
+        if (it.value().remove(socket)) {
+            updateStreamDemand(it.key(), false);
+        }
     }
 
     // Remove from sensor subscriber lists
@@ -185,8 +198,12 @@ WebSocketServer::Channel WebSocketServer::channelFromPath(const QString &path)
         return Channel::ShotSettings;
     } else if (path == "/ws/v1/machine/waterLevels") {
         return Channel::WaterLevels;
+    } else if (path == "/ws/v1/machine/temperatures") {
+        return Channel::Temperatures;
     } else if (path == "/ws/v1/scale/snapshot") {
         return Channel::ScaleSnapshot;
+    } else if (path == "/ws/v1/fusion/snapshot") {
+        return Channel::FusionSnapshot;
     } else if (path.startsWith("/ws/v1/sensors/") && path.endsWith("/snapshot")) {
         return Channel::SensorSnapshot;
     } else if (path == "/ws/v1/machine/raw") {
@@ -243,6 +260,44 @@ void WebSocketServer::broadcastShotSettings(const QJsonObject &settings)
     broadcast(Channel::ShotSettings, data);
 }
 
+void WebSocketServer::broadcastTemperatures(const QJsonObject &temperatures)
+{
+    QByteArray data = QJsonDocument(temperatures).toJson(QJsonDocument::Compact);
+    broadcast(Channel::Temperatures, data);
+}
+
+void WebSocketServer::updateStreamDemand(Channel channel, bool subscribed)
+{
+    // Machine state is always streamed; shot settings are not a notification
+    QList<StreamDemand::Stream> streams;
+    switch (channel) {
+    case Channel::MachineSnapshot: streams = {StreamDemand::Stream::ShotSamples}; break;
+    case Channel::WaterLevels: streams = {StreamDemand::Stream::WaterLevels}; break;
+    case Channel::Temperatures: streams = {StreamDemand::Stream::Temperatures}; break;
+    case Channel::ScaleSnapshot: streams = {StreamDemand::Stream::ScaleWeight}; break;
+    case Channel::FusionSnapshot:
+        streams = {StreamDemand::Stream::ShotSamples, StreamDemand::Stream::ScaleWeight};
+        break;
+    default: return;
+    }
+
+    for (StreamDemand::Stream stream : streams) {
+        if (subscribed) {
+            m_bridge->demand()->acquire(stream);
+        } else {
+            m_bridge->demand()->release(stream);
+        }
+    }
+}
+
+void WebSocketServer::broadcastFusedSample(const QJsonObject &sample)
+{
+    if (m_subscribers.value(Channel::FusionSnapshot).isEmpty()) return;
+
+    QByteArray data = QJsonDocument(sample).toJson(QJsonDocument::Compact);
+    broadcast(Channel::FusionSnapshot, data);
+}
+
 void WebSocketServer::broadcastSensorData(const QString &sensorId, const QJsonObject &data)
 {
     QByteArray json = QJsonDocument(data).toJson(QJsonDocument::Compact);
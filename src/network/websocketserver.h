@@ -17,10 +17,13 @@ class QTcpSocket;
  *   /ws/v1/machine/snapshot   - Real-time machine telemetry (~5Hz during shots)
  *   /ws/v1/machine/shotSettings - Shot settings updates
  *   /ws/v1/machine/waterLevels  - Water level notifications
+ *   /ws/v1/machine/temperatures - Heater temperatures (sent on changes >= 0.25 C)
  *   /ws/v1/scale/snapshot     - Real-time scale weight data
+ *   /ws/v1/fusion/snapshot    - Machine, scale and sensor readings on one clock (see SensorFusion)
  *
  * Clients connect to a specific endpoint and receive JSON messages
- * whenever that data changes.
+ * whenever that data changes. Subscribers keep the BLE notifications behind
+ * their channel switched on (see StreamDemand).
  */
 class WebSocketServer : public QObject
 {
@@ -45,7 +48,9 @@ public slots:
     void broadcastWaterLevels(const QJsonObject &levels);
     void broadcastScaleWeight(double weight, double flow);
     void broadcastShotSettings(const QJsonObject &settings);
+    void broadcastTemperatures(const QJsonObject &temperatures);
     void broadcastSensorData(const QString &sensorId, const QJsonObject &data);
+    void broadcastFusedSample(const QJsonObject &sample);
 
 private slots:
     void onNewConnection();
@@ -58,7 +63,9 @@ private:
         MachineSnapshot,
         ShotSettings,
         WaterLevels,
+        Temperatures,
         ScaleSnapshot,
+        FusionSnapshot,
         SensorSnapshot,
         Raw
     };
@@ -66,6 +73,8 @@ private:
     Channel channelFromPath(const QString &path);
     void broadcast(Channel channel, const QByteArray &data);
     void broadcastToSensor(const QString &sensorId, const QByteArray &data);
+    // Each subscriber holds a StreamDemand reference on its channel's BLE stream
+    void updateStreamDemand(Channel channel, bool subscribed);
 
     // Sensor subscribers: sensor ID -> set of sockets
     QMap<QString, QSet<QWebSocket*>> m_sensorSubscribers;
@@ -0,0 +1,285 @@
+#include "ble/protocol/binarycodec.h"
+#include "ble/protocol/de1packets.h"
+
+#include <QRandomGenerator>
+#include <QTest>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Legacy {
+
+// BinaryCodec before it became header-only (std::round, QByteArray results)
+uint8_t encodeU8P4(double value) { return static_cast<uint8_t>(std::round(std::clamp(value, 0.0, 16.0) * 16.0)); }
+uint8_t encodeU8P1(double value) { return static_cast<uint8_t>(std::round(std::clamp(value, 0.0, 128.0) * 2.0)); }
+uint8_t encodeU8P0(double value) { return static_cast<uint8_t>(std::round(std::clamp(value, 0.0, 256.0))); }
+uint16_t encodeU16P8(double value) { return static_cast<uint16_t>(std::round(std::clamp(value, 0.0, 256.0) * 256.0)); }
+int32_t encodeS32P16(double value) { return static_cast<int32_t>(std::round(std::clamp(value, -65536.0, 65536.0) * 65536.0)); }
+uint8_t encodeF8_1_7(double value)
+{
+    if (value < 12.75) return static_cast<uint8_t>(std::round(value * 10.0));
+    return static_cast<uint8_t>(std::round(std::clamp(value, 0.0, 127.0))) | 0x80;
+}
+uint16_t encodeU10P0(double value) { return static_cast<uint16_t>(std::round(std::clamp(value, 0.0, 1023.0))) | 0x0400; }
+
+QByteArray encodeShortBE(uint16_t value)
+{
+    QByteArray result(2, 0);
+    result[0] = static_cast<char>((value >> 8) & 0xFF);
+    result[1] = static_cast<char>(value & 0xFF);
+    return result;
+}
+
+QByteArray encodeU24P0(uint32_t value)
+{
+    QByteArray result(3, 0);
+    result[0] = static_cast<char>((value >> 16) & 0xFF);
+    result[1] = static_cast<char>((value >> 8) & 0xFF);
+    result[2] = static_cast<char>(value & 0xFF);
+    return result;
+}
+
+QByteArray encodeU32P0(uint32_t value)
+{
+    QByteArray result(4, 0);
+    result[0] = static_cast<char>((value >> 24) & 0xFF);
+    result[1] = static_cast<char>((value >> 16) & 0xFF);
+    result[2] = static_cast<char>((value >> 8) & 0xFF);
+    result[3] = static_cast<char>(value & 0xFF);
+    return result;
+}
+
+uint16_t decodeShortBE(const QByteArray &data, int offset)
+{
+    if (data.size() < offset + 2) return 0;
+    return (static_cast<uint16_t>(static_cast<uint8_t>(data[offset])) << 8) |
+           static_cast<uint16_t>(static_cast<uint8_t>(data[offset + 1]));
+}
+
+// DE1Device::parseShotSample before the layouts
+bool parseShotSample(const QByteArray &data, DE1::ShotSample &shot)
+{
+    if (data.size() < 16) return false;
+    shot.timer = decodeShortBE(data, 0);
+    shot.groupPressure = static_cast<uint8_t>(data[2]) / 16.0;
+    shot.groupFlow = static_cast<uint8_t>(data[3]) / 16.0;
+    shot.mixTemp = decodeShortBE(data, 4) / 256.0;
+    shot.headTemp = decodeShortBE(data, 6) / 256.0;
+    shot.setMixTemp = decodeShortBE(data, 8) / 256.0;
+    shot.setHeadTemp = decodeShortBE(data, 10) / 256.0;
+    shot.setGroupPressure = static_cast<uint8_t>(data[12]) / 16.0;
+    shot.setGroupFlow = static_cast<uint8_t>(data[13]) / 16.0;
+    shot.frameNumber = static_cast<uint8_t>(data[14]);
+    shot.steamTemp = static_cast<double>(static_cast<uint8_t>(data[15]));
+    return true;
+}
+
+} // namespace Legacy
+
+class TestBinaryCodec : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void fixedPointVectors();
+    void matchesLegacyEncoders();
+    void bigEndianVectors();
+    void shotSampleVector();
+    void shotSettingsVector();
+    void waterLevelsVector();
+    void layoutsRoundTrip();
+    void shortPacketIsRejected();
+
+    // One ShotSample (~5 Hz while brewing) through the layout and the old parser
+    void benchmarkLayoutDecode();
+    void benchmarkLegacyDecode();
+
+private:
+    static QByteArray shotSampleBytes() { return QByteArray::fromHex("01f490285c805d405c005d0090000396"); }
+};
+
+void TestBinaryCodec::fixedPointVectors()
+{
+    // Halves round away from zero, as std::round did
+    QCOMPARE(BinaryCodec::encodeU8P4(9.0), uint8_t(0x90));
+    QCOMPARE(BinaryCodec::encodeU8P4(8.53125), uint8_t(137));
+    QCOMPARE(BinaryCodec::encodeU8P4(0.03125), uint8_t(1));
+    QCOMPARE(BinaryCodec::encodeU8P4(-2.0), uint8_t(0));
+    QCOMPARE(BinaryCodec::encodeU8P4(15.9375), uint8_t(255));
+    QCOMPARE(BinaryCodec::decodeU8P4(0x90), 9.0);
+
+    QCOMPARE(BinaryCodec::encodeU8P1(93.25), uint8_t(187));
+    QCOMPARE(BinaryCodec::encodeU8P1(127.5), uint8_t(255));
+    QCOMPARE(BinaryCodec::decodeU8P1(187), 93.5);
+
+    QCOMPARE(BinaryCodec::encodeU8P0(36.5), uint8_t(37));
+    QCOMPARE(BinaryCodec::encodeU8P0(254.4), uint8_t(254));
+
+    QCOMPARE(BinaryCodec::encodeU16P8(93.5), uint16_t(0x5D80));
+    QCOMPARE(BinaryCodec::encodeU16P8(92.001953125), uint16_t(0x5C01));
+    QCOMPARE(BinaryCodec::decodeU16P8(0x5D40), 93.25);
+
+    QCOMPARE(BinaryCodec::encodeS32P16(-1.5), int32_t(-98304));
+    QCOMPARE(BinaryCodec::encodeS32P16(2.0 + 0.5 / 65536.0), int32_t(131073));
+    QCOMPARE(BinaryCodec::encodeS32P16(-0.5 / 65536.0), int32_t(-1));
+    QCOMPARE(BinaryCodec::decodeS32P16(-98304), -1.5);
+
+    QCOMPARE(BinaryCodec::encodeF8_1_7(4.25), uint8_t(43));
+    QCOMPARE(BinaryCodec::encodeF8_1_7(12.7), uint8_t(127));
+    QCOMPARE(BinaryCodec::encodeF8_1_7(12.75), uint8_t(0x8D));
+    QCOMPARE(BinaryCodec::encodeF8_1_7(30.0), uint8_t(0x9E));
+    QCOMPARE(BinaryCodec::encodeF8_1_7(200.0), uint8_t(0xFF));
+    QCOMPARE(BinaryCodec::decodeF8_1_7(43), 4.3);
+    QCOMPARE(BinaryCodec::decodeF8_1_7(0x9E), 30.0);
+
+    QCOMPARE(BinaryCodec::encodeU10P0(500.0), uint16_t(0x05F4));
+    QCOMPARE(BinaryCodec::encodeU10P0(1500.0), uint16_t(0x07FF));
+    QCOMPARE(BinaryCodec::decodeU10P0(0x05F4), 500.0);
+
+    QCOMPARE(BinaryCodec::decode3CharToU24P16(1, 0x80, 0x40), 1.0 + 0.5 + 1.0 / 1024.0);
+}
+
+void TestBinaryCodec::matchesLegacyEncoders()
+{
+    // In-range values only: the old casts were undefined past the top of a format
+    QRandomGenerator random(0xde1);
+    for (int i = 0; i < 100000; ++i) {
+        const double unit = random.generateDouble();
+        QCOMPARE(BinaryCodec::encodeU8P4(unit * 15.96 - 1.0), Legacy::encodeU8P4(unit * 15.96 - 1.0));
+        QCOMPARE(BinaryCodec::encodeU8P1(unit * 127.7 - 1.0), Legacy::encodeU8P1(unit * 127.7 - 1.0));
+        QCOMPARE(BinaryCodec::encodeU8P0(unit * 255.4 - 1.0), Legacy::encodeU8P0(unit * 255.4 - 1.0));
+        QCOMPARE(BinaryCodec::encodeU16P8(unit * 255.99 - 1.0), Legacy::encodeU16P8(unit * 255.99 - 1.0));
+        QCOMPARE(BinaryCodec::encodeS32P16(unit * 65535.0 - 32767.5), Legacy::encodeS32P16(unit * 65535.0 - 32767.5));
+        QCOMPARE(BinaryCodec::encodeF8_1_7(unit * 127.4), Legacy::encodeF8_1_7(unit * 127.4));
+        QCOMPARE(BinaryCodec::encodeU10P0(unit * 1100.0 - 1.0), Legacy::encodeU10P0(unit * 1100.0 - 1.0));
+    }
+}
+
+void TestBinaryCodec::bigEndianVectors()
+{
+    uint8_t buffer[4] = {};
+
+    BinaryCodec::writeU16BE(buffer, 0x1234);
+    QCOMPARE(QByteArray(reinterpret_cast<const char *>(buffer), 2), Legacy::encodeShortBE(0x1234));
+    QCOMPARE(BinaryCodec::readU16BE(buffer), uint16_t(0x1234));
+
+    BinaryCodec::writeU24BE(buffer, 0x80381C);
+    QCOMPARE(QByteArray(reinterpret_cast<const char *>(buffer), 3), Legacy::encodeU24P0(0x80381C));
+    QCOMPARE(BinaryCodec::readU24BE(buffer), uint32_t(0x80381C));
+
+    BinaryCodec::writeU32BE(buffer, 0xDEADBEEF);
+    QCOMPARE(QByteArray(reinterpret_cast<const char *>(buffer), 4), Legacy::encodeU32P0(0xDEADBEEF));
+    QCOMPARE(BinaryCodec::readU32BE(buffer), uint32_t(0xDEADBEEF));
+
+    const uint8_t negative[2] = {0xFF, 0x38};
+    QCOMPARE(BinaryCodec::readS16BE(negative), int16_t(-200));
+}
+
+void TestBinaryCodec::shotSampleVector()
+{
+    DE1::ShotSample shot;
+    QVERIFY(DE1::ShotSampleLayout::decode(shotSampleBytes(), shot));
+    QCOMPARE(shot.timer, uint16_t(500));
+    QCOMPARE(shot.groupPressure, 9.0);
+    QCOMPARE(shot.groupFlow, 2.5);
+    QCOMPARE(shot.mixTemp, 92.5);
+    QCOMPARE(shot.headTemp, 93.25);
+    QCOMPARE(shot.setMixTemp, 92.0);
+    QCOMPARE(shot.setHeadTemp, 93.0);
+    QCOMPARE(shot.setGroupPressure, 9.0);
+    QCOMPARE(shot.setGroupFlow, 0.0);
+    QCOMPARE(shot.frameNumber, uint8_t(3));
+    QCOMPARE(shot.steamTemp, 150.0);
+
+    DE1::ShotSample legacy;
+    QVERIFY(Legacy::parseShotSample(shotSampleBytes(), legacy));
+    QCOMPARE(shot.mixTemp, legacy.mixTemp);
+    QCOMPARE(shot.headTemp, legacy.headTemp);
+    QCOMPARE(shot.groupPressure, legacy.groupPressure);
+    QCOMPARE(shot.steamTemp, legacy.steamTemp);
+}
+
+void TestBinaryCodec::shotSettingsVector()
+{
+    const DE1::ShotSettings settings{1, 160, 120, 85, 200, 60, 36, 93.5};
+
+    // What setShotSettings() wrote before the layouts
+    QByteArray legacy(9, 0);
+    legacy[0] = char(1);
+    legacy[1] = char(160);
+    legacy[2] = char(120);
+    legacy[3] = char(85);
+    legacy[4] = char(200);
+    legacy[5] = char(60);
+    legacy[6] = char(36);
+    const QByteArray groupTemp = Legacy::encodeShortBE(Legacy::encodeU16P8(93.5));
+    legacy[7] = groupTemp[0];
+    legacy[8] = groupTemp[1];
+
+    QCOMPARE(DE1::ShotSettingsLayout::toByteArray(settings), QByteArray::fromHex("01a07855c83c245d80"));
+    QCOMPARE(DE1::ShotSettingsLayout::toByteArray(settings), legacy);
+}
+
+void TestBinaryCodec::waterLevelsVector()
+{
+    DE1::WaterLevels water;
+    QVERIFY(DE1::WaterLevelsLayout::decode(QByteArray::fromHex("002a01f4"), water));
+    QCOMPARE(water.currentLevel, uint16_t(42));
+    QCOMPARE(water.startLevel, uint16_t(500));
+}
+
+void TestBinaryCodec::layoutsRoundTrip()
+{
+    QCOMPARE(DE1::ShotSampleLayout::toByteArray([] {
+        DE1::ShotSample shot;
+        DE1::ShotSampleLayout::decode(shotSampleBytes(), shot);
+        return shot;
+    }()), shotSampleBytes());
+
+    // Values on the U16P8 grid survive encode + decode exactly
+    DE1::Temperatures temperatures{88.5, 140.25, 93.0, 21.75, 89.0, 145.5, 93.5, 0.00390625};
+    DE1::Temperatures decoded;
+    QVERIFY(DE1::TemperaturesLayout::decode(DE1::TemperaturesLayout::toByteArray(temperatures), decoded));
+    QCOMPARE(decoded.waterHeater, temperatures.waterHeater);
+    QCOMPARE(decoded.steamHeater, temperatures.steamHeater);
+    QCOMPARE(decoded.groupHead, temperatures.groupHead);
+    QCOMPARE(decoded.coldWater, temperatures.coldWater);
+    QCOMPARE(decoded.targetWaterHeater, temperatures.targetWaterHeater);
+    QCOMPARE(decoded.targetSteamHeater, temperatures.targetSteamHeater);
+    QCOMPARE(decoded.targetGroupHead, temperatures.targetGroupHead);
+    QCOMPARE(decoded.targetColdWater, temperatures.targetColdWater);
+}
+
+void TestBinaryCodec::shortPacketIsRejected()
+{
+    DE1::ShotSample shot;
+    shot.timer = 7;
+    QVERIFY(!DE1::ShotSampleLayout::decode(shotSampleBytes().left(15), shot));
+    QCOMPARE(shot.timer, uint16_t(7));
+
+    DE1::WaterLevels water;
+    QVERIFY(!DE1::WaterLevelsLayout::decode(QByteArray::fromHex("002a01"), water));
+}
+
+void TestBinaryCodec::benchmarkLayoutDecode()
+{
+    const QByteArray data = shotSampleBytes();
+    DE1::ShotSample shot;
+    QBENCHMARK {
+        DE1::ShotSampleLayout::decode(data, shot);
+    }
+    QCOMPARE(shot.mixTemp, 92.5);
+}
+
+void TestBinaryCodec::benchmarkLegacyDecode()
+{
+    const QByteArray data = shotSampleBytes();
+    DE1::ShotSample shot;
+    QBENCHMARK {
+        Legacy::parseShotSample(data, shot);
+    }
+    QCOMPARE(shot.mixTemp, 92.5);
+}
+
+QTEST_GUILESS_MAIN(TestBinaryCodec)
+#include "tst_binarycodec.moc"
@@ -0,0 +1,83 @@
+#include "core/bridge.h"
+#include "core/settings.h"
+#include "ble/connectionmanager.h"
+#include "ble/devicecache.h"
+#include "ble/sensordevice.h"
+
+#include <QBluetoothAddress>
+#include <QBluetoothDeviceInfo>
+#include <QFile>
+#include <QStandardPaths>
+#include <QTest>
+
+class TestBridge : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void sensorLinkLifecycle();
+    void devicesGenerationNeverGoesBack();
+
+private:
+    static DeviceCache savedCache();
+};
+
+void TestBridge::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    QFile::remove(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/devices.json");
+}
+
+DeviceCache TestBridge::savedCache()
+{
+    DeviceCache cache(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/devices.json");
+    cache.load();
+    return cache;
+}
+
+void TestBridge::sensorLinkLifecycle()
+{
+    Settings settings;
+    Bridge bridge(&settings);
+    const QBluetoothDeviceInfo device(QBluetoothAddress("AA:BB:CC:DD:EE:FF"), "BOOKOO_EM 123456", 0);
+    const QString linkId = "sensor:AA:BB:CC:DD:EE:FF";
+
+    bridge.connectToSensor(device);
+    QVERIFY(bridge.connections()->hasLink(linkId));
+    QCOMPARE(bridge.sensors().size(), 1);
+    SensorDevice *sensor = bridge.sensors().first();
+    QCOMPARE(sensor->address(), device.address().toString());
+
+    // No radio here: report the connection the way the BLE stack would
+    emit sensor->connected();
+    QVERIFY(bridge.connections()->isConnected(linkId));
+    QVERIFY(savedCache().contains(linkId));
+
+    // A user disconnect drops the link and the remembered device
+    bridge.disconnectSensor(sensor->id());
+    QVERIFY(!bridge.connections()->hasLink(linkId));
+    QVERIFY(!savedCache().contains(linkId));
+    QVERIFY(bridge.sensors().isEmpty());
+}
+
+void TestBridge::devicesGenerationNeverGoesBack()
+{
+    Settings settings;
+    Bridge bridge(&settings);
+    const quint64 initial = bridge.devicesGeneration();
+
+    bridge.connectToScale(QBluetoothDeviceInfo(QBluetoothAddress("11:22:33:44:55:66"), "BOOKOO_SC 996698", 0));
+    QTRY_VERIFY(bridge.scale());
+    const quint64 attached = bridge.devicesGeneration();
+    QVERIFY(attached > initial);
+
+    // Dropping the scale must not fall back to an older stamp, or a client
+    // holding the initial ETag would be told the empty list is unchanged
+    bridge.disconnectScale();
+    QVERIFY(!bridge.scale());
+    QVERIFY(bridge.devicesGeneration() > attached);
+}
+
+QTEST_GUILESS_MAIN(TestBridge)
+#include "tst_bridge.moc"
@@ -0,0 +1,182 @@
+#include "ble/deviceclassifier.h"
+
+#include <QTest>
+
+Q_DECLARE_METATYPE(DeviceType)
+
+class TestDeviceClassifier : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void classifiesNames_data();
+    void classifiesNames();
+    void keepsApiNames();
+    void acceptsLegacyNames();
+    void typeFromNameInvertsNames();
+
+    // The trie against the name matching it replaced, over a mixed scan
+    void benchmarkClassifier();
+    void benchmarkLegacyMatching();
+
+private:
+    static QStringList scanNames();
+    static QString legacyClassify(const QString &name);
+};
+
+void TestDeviceClassifier::classifiesNames_data()
+{
+    QTest::addColumn<QString>("name");
+    QTest::addColumn<DeviceType>("type");
+
+    QTest::newRow("de1") << "DE1" << DeviceType::DE1;
+    QTest::newRow("decent") << "Decent" << DeviceType::DE1;
+    QTest::newRow("de1 xl") << "DE1XL" << DeviceType::DE1;
+    QTest::newRow("decent inside") << "My Decent DE1" << DeviceType::DE1;
+    QTest::newRow("decent suffix") << "Kitchen-decent" << DeviceType::DE1;
+    QTest::newRow("decent scale") << "Decent Scale" << DeviceType::DecentScale;
+    QTest::newRow("lunar") << "LUNAR-A1B2C3" << DeviceType::Acaia;
+    QTest::newRow("proch") << "PROCHBT001" << DeviceType::Acaia;
+    QTest::newRow("pyxis") << "PYXIS-123456" << DeviceType::AcaiaPyxis;
+    QTest::newRow("felicita") << "FELICITA_ARC" << DeviceType::Felicita;
+    QTest::newRow("ecompass") << "ECOMPASS" << DeviceType::Felicita;
+    QTest::newRow("skale") << "Skale2" << DeviceType::Skale;
+    QTest::newRow("jimmy") << "JIMMY" << DeviceType::HiroiaJimmy;
+    QTest::newRow("bookoo") << "BOOKOO_SC 996698" << DeviceType::Bookoo;
+    QTest::newRow("bookoo monitor") << "BOOKOO_EM 123456" << DeviceType::BookooMonitor;
+    QTest::newRow("bookoo monitor dash") << "BOOKOO-EM" << DeviceType::BookooMonitor;
+    QTest::newRow("bookoo monitor joined") << "BOOKOOEM01" << DeviceType::BookooMonitor;
+    QTest::newRow("bookoo monitor underscore") << "BOOKOO_MONITOR" << DeviceType::BookooMonitor;
+    QTest::newRow("bookoo monitor words") << "Bookoo Monitor 2" << DeviceType::BookooMonitor;
+    QTest::newRow("smartchef") << "SmartChef" << DeviceType::SmartChef;
+    QTest::newRow("microbalance") << "Microbalance" << DeviceType::Difluid;
+    QTest::newRow("precisa") << "CFS-9002" << DeviceType::EurekaPrecisa;
+    QTest::newRow("solo barista") << "LSJ-001" << DeviceType::SoloBarista;
+    QTest::newRow("eclair") << "ECLAIR-01" << DeviceType::AtomheartEclair;
+    QTest::newRow("varia") << "Varia AKU" << DeviceType::VariaAku;
+    QTest::newRow("phone") << "Pixel 7" << DeviceType::Unknown;
+    QTest::newRow("empty") << "" << DeviceType::Unknown;
+}
+
+void TestDeviceClassifier::classifiesNames()
+{
+    QFETCH(QString, name);
+    QFETCH(DeviceType, type);
+    QCOMPARE(DeviceClassifier::classifyName(name), type);
+}
+
+void TestDeviceClassifier::keepsApiNames()
+{
+    // The scaleType values /api/v1/devices/discovered has always returned
+    QCOMPARE(DeviceClassifier::apiName(DeviceType::DecentScale), QString("Decent"));
+    QCOMPARE(DeviceClassifier::apiName(DeviceType::Acaia), QString("Acaia"));
+    QCOMPARE(DeviceClassifier::apiName(DeviceType::AcaiaPyxis), QString("Acaia Pyxis"));
+    QCOMPARE(DeviceClassifier::apiName(DeviceType::Felicita), QString("Felicita"));
+    QCOMPARE(DeviceClassifier::apiName(DeviceType::Skale), QString("Skale"));
+    QCOMPARE(DeviceClassifier::apiName(DeviceType::Bookoo), QString("Bookoo"));
+    QCOMPARE(DeviceClassifier::apiName(DeviceType::EurekaPrecisa), QString("Eureka"));
+    QCOMPARE(DeviceClassifier::apiName(DeviceType::Difluid), QString("DiFluid"));
+    QCOMPARE(DeviceClassifier::apiName(DeviceType::HiroiaJimmy), QString("Hiroia"));
+    QCOMPARE(DeviceClassifier::apiName(DeviceType::VariaAku), QString("Varia"));
+    QCOMPARE(DeviceClassifier::apiName(DeviceType::SmartChef), QString("SmartChef"));
+    QCOMPARE(DeviceClassifier::apiName(DeviceType::BookooMonitor), QString("BookooMonitor"));
+
+}
+
+void TestDeviceClassifier::acceptsLegacyNames()
+{
+    // Every name the old matching recognised still classifies the same way
+    for (const QString &name : scanNames()) {
+        const QString legacy = legacyClassify(name);
+        if (legacy.isEmpty()) continue;   // Only recognised since the rule table
+        const DeviceType type = DeviceClassifier::classifyName(name);
+        if (legacy == "DE1") {
+            QVERIFY2(type == DeviceType::DE1, qPrintable(name));
+        } else {
+            QVERIFY2(DeviceClassifier::apiName(type) == legacy, qPrintable(name));
+        }
+    }
+}
+
+void TestDeviceClassifier::typeFromNameInvertsNames()
+{
+    for (int i = int(DeviceType::DE1); i <= int(DeviceType::BookooMonitor); ++i) {
+        const DeviceType type = DeviceType(i);
+        QCOMPARE(DeviceClassifier::typeFromName(DeviceClassifier::typeName(type)), type);
+        QCOMPARE(DeviceClassifier::typeFromName(DeviceClassifier::apiName(type)), type);
+    }
+    QCOMPARE(DeviceClassifier::typeFromName(u"varia aku"), DeviceType::VariaAku);
+    QCOMPARE(DeviceClassifier::typeFromName(u"Varia AKU 1234"), DeviceType::Unknown);
+    QCOMPARE(DeviceClassifier::typeFromName(u"Unknown"), DeviceType::Unknown);
+}
+
+void TestDeviceClassifier::benchmarkClassifier()
+{
+    const QStringList names = scanNames();
+    int matched = 0;
+    QBENCHMARK {
+        for (const QString &name : names) {
+            matched += DeviceClassifier::classifyName(name) != DeviceType::Unknown;
+        }
+    }
+    QVERIFY(matched > 0);
+}
+
+void TestDeviceClassifier::benchmarkLegacyMatching()
+{
+    const QStringList names = scanNames();
+    int matched = 0;
+    QBENCHMARK {
+        for (const QString &name : names) {
+            matched += !legacyClassify(name).isEmpty();
+        }
+    }
+    QVERIFY(matched > 0);
+}
+
+QStringList TestDeviceClassifier::scanNames()
+{
+    // A busy scan is mostly phones, headphones and beacons
+    return {
+        "DE1", "Decent Scale", "LUNAR-A1B2C3", "PYXIS-123456", "FELICITA_ARC",
+        "Skale2", "BOOKOO_SC 996698", "BOOKOO_EM 123456", "EUREKA", "DiFluid MB",
+        "JIMMY", "Varia AKU", "SmartChef", "DE1XL", "My Decent DE1", "BOOKOO-EM", "BOOKOO_MONITOR",
+        "Bookoo Monitor 2",
+        "Pixel 7", "JBL Flip 5", "WH-1000XM4", "Galaxy Watch5 (1A2B)", "[TV] Samsung 7 Series",
+        "Mi Band 6", "iPhone", "Tile", "LE-Bose QC35", "HUAWEI Band 4", "Fitbit Charge 5",
+        "", "", "", "",
+    };
+}
+
+QString TestDeviceClassifier::legacyClassify(const QString &name)
+{
+    // BLEManager::classify before the rule table: scaleType(), isDE1(), isSensor()
+    QString nameLower = name.toLower();
+    auto scaleType = [&]() -> QString {
+        if (name.startsWith("Decent Scale")) return "Decent";
+        if (nameLower.startsWith("acaia") || nameLower.startsWith("proch")) return "Acaia";
+        if (nameLower.startsWith("pyxis")) return "Acaia Pyxis";
+        if (nameLower.startsWith("felicita")) return "Felicita";
+        if (nameLower.startsWith("skale")) return "Skale";
+        if (nameLower.startsWith("bookoo") && !nameLower.contains("em") && !nameLower.contains("monitor")) return "Bookoo";
+        if (nameLower.startsWith("eureka")) return "Eureka";
+        if (nameLower.startsWith("difluid")) return "DiFluid";
+        if (nameLower.startsWith("hiroia") || nameLower.startsWith("jimmy")) return "Hiroia";
+        if (nameLower.startsWith("varia")) return "Varia";
+        if (nameLower.startsWith("smartchef")) return "SmartChef";
+        return QString();
+    };
+
+    QString type = scaleType();
+    if (!type.isEmpty()) return type;
+    // isDE1() ran the scale checks again before its own
+    if (scaleType().isEmpty() && (nameLower.startsWith("de1") || nameLower.contains("decent"))) return "DE1";
+    QString nameUpper = name.toUpper();
+    if (nameUpper.contains("BOOKOO") && (nameUpper.contains("EM") || nameUpper.contains("MONITOR"))) {
+        return "BookooMonitor";
+    }
+    return QString();
+}
+
+QTEST_GUILESS_MAIN(TestDeviceClassifier)
+#include "tst_deviceclassifier.moc"
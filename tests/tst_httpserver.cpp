@@ -0,0 +1,248 @@
+#include "core/bridge.h"
+#include "core/settings.h"
+#include "core/zipfilesystem.h"
+#include "network/httpserver.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHostAddress>
+#include <QRegularExpression>
+#include <QStandardPaths>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <miniz.h>
+
+#include <memory>
+#include <vector>
+
+/**
+ * Request handling under load, against clients that stall and across
+ * content negotiation. Each test runs its own HttpServer on a free port
+ * with a short request timeout.
+ */
+class TestHttpServer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void stalledBodiesReleaseTheirBudget();
+    void uploadsShareATempFileBudget();
+    void concurrentStorePosts();
+    void gzipFollowsQValues_data();
+    void gzipFollowsQValues();
+    void hiddenSkinFilesStayPrivate();
+
+private:
+    struct Client {
+        QTcpSocket socket;
+        QByteArray response;
+
+        explicit Client(quint16 port)
+        {
+            QObject::connect(&socket, &QTcpSocket::readyRead, &socket, [this]() {
+                response += socket.readAll();
+            });
+            socket.connectToHost(QHostAddress::LocalHost, port);
+        }
+        int status() const
+        {
+            return response.startsWith("HTTP/1.1 ") ? response.mid(9, 3).toInt() : 0;
+        }
+    };
+
+    std::unique_ptr<Client> send(const QByteArray &request);
+    static QByteArray post(const QByteArray &path, qint64 contentLength, const QByteArray &body = {});
+
+    std::unique_ptr<Settings> m_settings;
+    std::unique_ptr<Bridge> m_bridge;
+    std::unique_ptr<HttpServer> m_server;
+
+    static constexpr int TIMEOUT_MS = 500;
+};
+
+void TestHttpServer::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+}
+
+void TestHttpServer::init()
+{
+    m_settings = std::make_unique<Settings>();
+    m_bridge = std::make_unique<Bridge>(m_settings.get());
+    m_server = std::make_unique<HttpServer>(m_bridge.get());
+    m_server->setRequestTimeout(TIMEOUT_MS);
+    QVERIFY(m_server->start(0));
+}
+
+void TestHttpServer::cleanup()
+{
+    m_server.reset();
+    m_bridge.reset();
+    m_settings.reset();
+}
+
+std::unique_ptr<TestHttpServer::Client> TestHttpServer::send(const QByteArray &request)
+{
+    auto client = std::make_unique<Client>(m_server->serverPort());
+    client->socket.write(request);
+    return client;
+}
+
+QByteArray TestHttpServer::post(const QByteArray &path, qint64 contentLength, const QByteArray &body)
+{
+    return "POST " + path + " HTTP/1.1\r\nHost: localhost\r\nContent-Length: "
+           + QByteArray::number(contentLength) + "\r\n\r\n" + body;
+}
+
+void TestHttpServer::stalledBodiesReleaseTheirBudget()
+{
+    // Eight 1 MiB store posts that never send their body fill the 8 MiB budget
+    std::vector<std::unique_ptr<Client>> stalled;
+    for (int i = 0; i < 8; ++i) {
+        stalled.push_back(send(post("/api/v1/store/load", 1024 * 1024)));
+    }
+    QTest::qWait(100);
+
+    auto refused = send(post("/api/v1/store/load", 1024 * 1024));
+    QTRY_COMPARE(refused->status(), 503);
+
+    // The deadline answers them and gives their reservations back
+    for (const auto &client : stalled) {
+        QTRY_COMPARE_WITH_TIMEOUT(client->status(), 408, TIMEOUT_MS * 10);
+    }
+    const QByteArray body = "{\"k\":1}";
+    auto accepted = send(post("/api/v1/store/load", body.size(), body));
+    QTRY_COMPARE(accepted->status(), 200);
+}
+
+void TestHttpServer::uploadsShareATempFileBudget()
+{
+    // Three 32 MiB uploads fill the temporary file budget
+    const QByteArray upload = "PUT /api/v1/dev/skin/big.bin HTTP/1.1\r\nContent-Length: 33554432\r\n\r\n";
+    std::vector<std::unique_ptr<Client>> uploads;
+    for (int i = 0; i < 3; ++i) {
+        uploads.push_back(send(upload));
+    }
+    QTest::qWait(100);
+    auto refused = send(upload);
+    QTRY_COMPARE(refused->status(), 503);
+
+    for (const auto &client : uploads) {
+        QTRY_COMPARE_WITH_TIMEOUT(client->status(), 408, TIMEOUT_MS * 10);
+    }
+    auto retried = send(upload);
+    QTest::qWait(100);
+    QCOMPARE(retried->status(), 0);     // Accepted, waiting for its body
+}
+
+void TestHttpServer::concurrentStorePosts()
+{
+    // 32 clients at once, 6.4 MiB of bodies in flight together: all fit the budget
+    constexpr int CLIENTS = 32;
+    const QByteArray body = "{\"value\":\"" + QByteArray(200 * 1024, 'x') + "\"}";
+
+    QElapsedTimer timer;
+    timer.start();
+    std::vector<std::unique_ptr<Client>> clients;
+    for (int i = 0; i < CLIENTS; ++i) {
+        clients.push_back(send(post("/api/v1/store/load" + QByteArray::number(i), body.size(), body)));
+    }
+    for (const auto &client : clients) {
+        QTRY_COMPARE_WITH_TIMEOUT(client->status(), 200, 10000);
+    }
+    qInfo() << CLIENTS << "concurrent 200 KiB posts answered in" << timer.elapsed() << "ms";
+}
+
+void TestHttpServer::gzipFollowsQValues_data()
+{
+    QTest::addColumn<QByteArray>("acceptEncoding");
+    QTest::addColumn<bool>("gzip");
+
+    QTest::newRow("absent") << QByteArray() << false;
+    QTest::newRow("gzip") << QByteArray("gzip, deflate, br") << true;
+    QTest::newRow("gzip q=0") << QByteArray("gzip;q=0, deflate") << false;
+    QTest::newRow("gzip q=0.0 spaced") << QByteArray("deflate, gzip ; q=0.0") << false;
+    QTest::newRow("gzip q=0.5") << QByteArray("br, gzip;q=0.5") << true;
+    QTest::newRow("x-gzip") << QByteArray("x-gzip") << true;
+    QTest::newRow("wildcard") << QByteArray("*") << true;
+    QTest::newRow("wildcard q=0") << QByteArray("identity, *;q=0") << false;
+    QTest::newRow("gzip over wildcard") << QByteArray("*;q=0, gzip") << true;
+    QTest::newRow("not a token") << QByteArray("gzipped") << false;
+}
+
+void TestHttpServer::gzipFollowsQValues()
+{
+    QFETCH(QByteArray, acceptEncoding);
+    QFETCH(bool, gzip);
+
+    const QByteArray index = "<html>" + QByteArray(4096, 'x') + "</html>";
+    mz_zip_archive zip;
+    memset(&zip, 0, sizeof(zip));
+    QVERIFY(mz_zip_writer_init_heap(&zip, 0, 0));
+    QVERIFY(mz_zip_writer_add_mem(&zip, "skin-main/index.html",
+                                  index.constData(), size_t(index.size()), MZ_DEFAULT_COMPRESSION));
+    void *data = nullptr;
+    size_t size = 0;
+    QVERIFY(mz_zip_writer_finalize_heap_archive(&zip, &data, &size));
+    auto archive = std::make_shared<ZipFileSystem>();
+    QVERIFY(archive->open(QByteArray(static_cast<const char*>(data), qsizetype(size))));
+    mz_free(data);
+    mz_zip_writer_end(&zip);
+
+    QTemporaryDir root;
+    QVERIFY(root.isValid());
+    m_server->setSkinRoot(root.path());
+    m_server->setSkinArchive(archive);
+
+    QByteArray request = "GET /index.html HTTP/1.1\r\nHost: localhost\r\n";
+    if (!acceptEncoding.isEmpty()) request += "Accept-Encoding: " + acceptEncoding + "\r\n";
+    auto client = send(request + "\r\n");
+    QTRY_COMPARE(client->status(), 200);
+
+    // Wait for the whole body the response announces
+    const int split = client->response.indexOf("\r\n\r\n");
+    QVERIFY(split > 0);
+    const QRegularExpression lengthHeader("content-length:\\s*(\\d+)",
+                                          QRegularExpression::CaseInsensitiveOption);
+    const int length = lengthHeader.match(client->response.left(split)).captured(1).toInt();
+    QTRY_COMPARE(client->response.size(), split + 4 + length);
+
+    const QByteArray head = client->response.left(split).toLower();
+    const QByteArray body = client->response.mid(split + 4);
+    QCOMPARE(head.contains("content-encoding: gzip"), gzip);
+    if (gzip) {
+        QVERIFY(body.startsWith("\x1f\x8b"));
+    } else {
+        QCOMPARE(body, index);
+    }
+}
+
+void TestHttpServer::hiddenSkinFilesStayPrivate()
+{
+    QTemporaryDir root;
+    QVERIFY(root.isValid());
+    QFile manifest(root.filePath(".manifest.json"));
+    QVERIFY(manifest.open(QIODevice::WriteOnly));
+    manifest.write("{}");
+    manifest.close();
+    m_server->setSkinRoot(root.path());
+
+    auto read = send("GET /.manifest.json HTTP/1.1\r\nHost: localhost\r\n\r\n");
+    QTRY_COMPARE(read->status(), 404);
+    auto nested = send("GET /css/.hidden/app.css HTTP/1.1\r\nHost: localhost\r\n\r\n");
+    QTRY_COMPARE(nested->status(), 404);
+
+    auto overwrite = send("PUT /api/v1/dev/skin/.manifest.json HTTP/1.1\r\nContent-Length: 2\r\n\r\n[]");
+    QTRY_COMPARE(overwrite->status(), 400);
+    QVERIFY(manifest.open(QIODevice::ReadOnly));
+    QCOMPARE(manifest.readAll(), QByteArray("{}"));
+}
+
+QTEST_GUILESS_MAIN(TestHttpServer)
+#include "tst_httpserver.moc"
@@ -0,0 +1,163 @@
+#include "core/keyvaluestore.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTest>
+
+class TestKeyValueStore : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundTrip();
+    void batchSharesOneRecord();
+    void tornTailIsDiscarded();
+    void importsLegacyLayout();
+    void compactsSupersededValues();
+
+    // Log store against the one-file-per-key layout it replaced
+    void benchmarkLogStore();
+    void benchmarkFilePerKey();
+
+private:
+    static QByteArray valueFor(int i) { return "{\"shot\":" + QByteArray::number(i) + "}"; }
+    static constexpr int BENCH_KEYS = 200;
+};
+
+void TestKeyValueStore::roundTrip()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    {
+        KeyValueStore store(dir.path());
+        store.put("profiles", "a", "1");
+        store.put("profiles", "b", "2");
+        store.put("profiles", "a", "3");
+        QCOMPARE(store.value("profiles", "a"), QByteArray("3"));
+        QVERIFY(store.value("profiles", "missing").isNull());
+        store.flush();
+    }
+
+    KeyValueStore reopened(dir.path());
+    QCOMPARE(reopened.value("profiles", "a"), QByteArray("3"));
+    QCOMPARE(reopened.value("profiles", "b"), QByteArray("2"));
+    QCOMPARE(reopened.values("profiles").size(), 2);
+    QCOMPARE(reopened.values("profiles", {"b", "missing"}).size(), 1);
+}
+
+void TestKeyValueStore::batchSharesOneRecord()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    KeyValueStore store(dir.path());
+    store.put("ns", QHash<QString, QByteArray>{{"x", "1"}, {"y", "2"}});
+    store.flush();
+
+    // Header (length + crc), then two entries of 4 + 1 + 4 + 1 bytes
+    QCOMPARE(QFileInfo(dir.filePath("ns.log")).size(), qint64(8 + 2 * 10));
+}
+
+void TestKeyValueStore::tornTailIsDiscarded()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString log = dir.filePath("ns.log");
+
+    {
+        KeyValueStore store(dir.path());
+        store.put("ns", "kept", "yes");
+        store.flush();
+    }
+    const qint64 intact = QFileInfo(log).size();
+
+    // A record whose header promises more payload than was written
+    {
+        QFile file(log);
+        QVERIFY(file.open(QIODevice::Append));
+        file.write(QByteArray::fromHex("40000000deadbeef") + "partial");
+    }
+
+    KeyValueStore reopened(dir.path());
+    QCOMPARE(reopened.value("ns", "kept"), QByteArray("yes"));
+    QCOMPARE(QFileInfo(log).size(), intact);
+}
+
+void TestKeyValueStore::importsLegacyLayout()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(QDir(dir.path()).mkpath("legacy"));
+    {
+        QFile file(dir.filePath("legacy/settings.json"));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("{\"old\":true}");
+    }
+
+    {
+        KeyValueStore store(dir.path());
+        QCOMPARE(store.value("legacy", "settings"), QByteArray("{\"old\":true}"));
+        store.flush();
+    }
+
+    QVERIFY(QFileInfo::exists(dir.filePath("legacy.log")));
+    QVERIFY(!QFileInfo::exists(dir.filePath("legacy")));
+
+    KeyValueStore reopened(dir.path());
+    QCOMPARE(reopened.value("legacy", "settings"), QByteArray("{\"old\":true}"));
+}
+
+void TestKeyValueStore::compactsSupersededValues()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    KeyValueStore store(dir.path());
+    const QByteArray big(4096, 'v');
+    for (int i = 0; i < 200; ++i) {
+        store.put("ns", "same", big + QByteArray::number(i));
+        store.flush();
+    }
+
+    // 200 appends of 4 KiB would be ~800 KiB without compaction
+    QVERIFY(QFileInfo(dir.filePath("ns.log")).size() < 300 * 1024);
+    KeyValueStore reopened(dir.path());
+    QCOMPARE(reopened.value("ns", "same"), big + "199");
+}
+
+void TestKeyValueStore::benchmarkLogStore()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    KeyValueStore store(dir.path());
+
+    QBENCHMARK {
+        for (int i = 0; i < BENCH_KEYS; ++i) {
+            store.put("bench", QString::number(i), valueFor(i));
+        }
+        store.flush();
+    }
+}
+
+void TestKeyValueStore::benchmarkFilePerKey()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    // What POST /api/v1/store/:ns/:key did before the log store
+    QBENCHMARK {
+        for (int i = 0; i < BENCH_KEYS; ++i) {
+            const QString nsDir = dir.path() + "/bench";
+            QDir().mkpath(nsDir);
+            QFile file(nsDir + "/" + QString::number(i) + ".json");
+            QVERIFY(file.open(QIODevice::WriteOnly));
+            file.write(valueFor(i));
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(TestKeyValueStore)
+#include "tst_keyvaluestore.moc"
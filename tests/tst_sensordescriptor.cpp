@@ -0,0 +1,128 @@
+#include "ble/sensors/genericsensor.h"
+#include "ble/sensors/sensordescriptor.h"
+
+#include <QBluetoothAddress>
+#include <QFile>
+#include <QJsonDocument>
+#include <QSignalSpy>
+#include <QTest>
+
+/**
+ * Sensor descriptions: validation, advertisement matching, and a recorded
+ * capture (the --record-sensor format) replayed through GenericSensor.
+ */
+class TestSensorDescriptor : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void sharedServiceNeedsNames();
+    void sharedServiceMatchesByNameOnly();
+    void uniqueServiceMatchesAlone();
+    void replaysCapture();
+
+private:
+    static SensorDescriptor thermoProbe(const QByteArray &json = {});
+    static QBluetoothDeviceInfo advertiser(const QString &name, const QBluetoothUuid &service);
+};
+
+SensorDescriptor TestSensorDescriptor::thermoProbe(const QByteArray &json)
+{
+    static const QByteArray THERMOPROBE = R"({
+        "type": "ThermoProbe",
+        "names": ["thermoprobe"],
+        "service": "fff0",
+        "characteristic": "fff1",
+        "fields": [
+            { "key": "temperature", "unit": "celsius", "offset": 2, "format": "s16", "endian": "little", "scale": 0.1 },
+            { "key": "battery", "unit": "percent", "offset": 4, "format": "u8" }
+        ]
+    })";
+    SensorDescriptor descriptor;
+    QString error;
+    if (!SensorDescriptor::fromJson(QJsonDocument::fromJson(json.isEmpty() ? THERMOPROBE : json).object(),
+                                    descriptor, &error)) {
+        qWarning() << error;
+    }
+    return descriptor;
+}
+
+QBluetoothDeviceInfo TestSensorDescriptor::advertiser(const QString &name, const QBluetoothUuid &service)
+{
+    QBluetoothDeviceInfo device(QBluetoothAddress("AA:BB:CC:DD:EE:01"), name, 0);
+    device.setServiceUuids({service});
+    return device;
+}
+
+void TestSensorDescriptor::sharedServiceNeedsNames()
+{
+    // FFF0 is the Decent Scale's and Varia's service too
+    const QJsonObject obj = QJsonDocument::fromJson(R"({
+        "type": "Anonymous", "service": "fff0", "characteristic": "fff1",
+        "fields": [ { "key": "value", "offset": 0, "format": "u8" } ]
+    })").object();
+    SensorDescriptor descriptor;
+    QString error;
+    QVERIFY(!SensorDescriptor::fromJson(obj, descriptor, &error));
+    QVERIFY(error.contains("names"));
+}
+
+void TestSensorDescriptor::sharedServiceMatchesByNameOnly()
+{
+    const SensorDescriptor descriptor = thermoProbe();
+    QVERIFY(!descriptor.type.isEmpty());
+
+    QVERIFY(descriptor.matches(advertiser("ThermoProbe 01", descriptor.service)));
+    QVERIFY(!descriptor.matches(advertiser("Decent Scale", descriptor.service)));
+    QVERIFY(!descriptor.matches(advertiser("Varia AKU", descriptor.service)));
+}
+
+void TestSensorDescriptor::uniqueServiceMatchesAlone()
+{
+    // Environmental Sensing (181A) is not used by any built-in device
+    const SensorDescriptor descriptor = thermoProbe(R"({
+        "type": "Climate", "service": "181a", "characteristic": "2a6e",
+        "fields": [ { "key": "temperature", "offset": 0, "format": "s16", "endian": "little", "scale": 0.01 } ]
+    })");
+    QCOMPARE(descriptor.type, QString("Climate"));
+    QVERIFY(descriptor.matches(advertiser("Unnamed", descriptor.service)));
+    QVERIFY(!descriptor.matches(advertiser("Unnamed", QBluetoothUuid(quint16(0x180f)))));
+}
+
+void TestSensorDescriptor::replaysCapture()
+{
+    auto descriptor = std::make_shared<const SensorDescriptor>(thermoProbe());
+    GenericSensor sensor(descriptor);
+    QSignalSpy updates(&sensor, &SensorDevice::dataUpdated);
+
+    QFile file(QFINDTESTDATA("captures/thermoprobe.jsonl"));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QJsonObject header = QJsonDocument::fromJson(file.readLine()).object();
+    QCOMPARE(header["capture"].toString(), QString("decentbridge-sensor"));
+    QCOMPARE(header["type"].toString(), descriptor->type);
+
+    QList<double> temperatures;
+    QList<double> batteries;
+    while (!file.atEnd()) {
+        const QJsonObject event = QJsonDocument::fromJson(file.readLine()).object();
+        const int before = updates.size();
+        sensor.handleNotification(QBluetoothUuid(event["notify"].toString()),
+                                  QByteArray::fromHex(event["data"].toString().toLatin1()));
+        if (updates.size() > before) {
+            temperatures.append(sensor.value("temperature"));
+            batteries.append(sensor.value("battery"));
+        }
+    }
+
+    // The short packet and the other characteristic leave the channels alone
+    const QList<double> expectedTemperatures{22.5, 50.0, -20.0};
+    const QList<double> expectedBatteries{100, 99, 98};
+    QCOMPARE(temperatures.size(), expectedTemperatures.size());
+    for (int i = 0; i < temperatures.size(); ++i) {
+        QCOMPARE(temperatures[i], expectedTemperatures[i]);
+        QCOMPARE(batteries[i], expectedBatteries[i]);
+    }
+}
+
+QTEST_GUILESS_MAIN(TestSensorDescriptor)
+#include "tst_sensordescriptor.moc"
@@ -0,0 +1,238 @@
+#include "core/skinmanager.h"
+
+#include <QDir>
+#include <QFile>
+#include <QHostAddress>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTest>
+
+#include <miniz.h>
+
+/**
+ * Minimal HTTP/1.1 origin for the skin zip: answers HEAD with an ETag and
+ * GET with 200, 206 or 416 depending on the Range header and the mode.
+ */
+class SkinOrigin : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Mode {
+        Normal,         // Honour ranges
+        IgnoreRange,    // Always send the whole zip with 200
+        DropOnce,       // Close the first full download halfway through
+    };
+
+    SkinOrigin(const QByteArray &zip, Mode mode) : m_zip(zip), m_mode(mode)
+    {
+        connect(&m_server, &QTcpServer::newConnection, this, [this]() {
+            while (QTcpSocket *socket = m_server.nextPendingConnection()) {
+                connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { onReadyRead(socket); });
+                connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            }
+        });
+        m_server.listen(QHostAddress::LocalHost);
+    }
+
+    QUrl url() const { return QUrl(QString("http://127.0.0.1:%1/main.zip").arg(m_server.serverPort())); }
+    QByteArray etag() const { return "\"skin-1\""; }
+
+    // Range header of each GET, empty when the whole zip was asked for
+    QList<QByteArray> ranges;
+
+private:
+    void onReadyRead(QTcpSocket *socket)
+    {
+        QByteArray &buffer = m_buffers[socket];
+        buffer += socket->readAll();
+        int end = buffer.indexOf("\r\n\r\n");
+        if (end < 0) return;
+
+        const QList<QByteArray> lines = buffer.left(end).split('\n');
+        const QByteArray method = lines.first().split(' ').first();
+        QByteArray range;
+        for (const QByteArray &line : lines) {
+            if (line.toLower().startsWith("range:")) range = line.mid(6).trimmed();
+        }
+        m_buffers.remove(socket);
+
+        if (method == "HEAD") {
+            reply(socket, "200 OK", "Content-Length: " + QByteArray::number(m_zip.size()) + "\r\n", {});
+            return;
+        }
+        ranges.append(range);
+
+        const qint64 from = range.isEmpty() ? 0 : range.mid(6, range.indexOf('-') - 6).toLongLong();
+        if (from >= m_zip.size()) {
+            reply(socket, "416 Range Not Satisfiable",
+                  "Content-Range: bytes */" + QByteArray::number(m_zip.size()) + "\r\nContent-Length: 0\r\n", {});
+        } else if (from > 0 && m_mode != Mode::IgnoreRange) {
+            reply(socket, "206 Partial Content",
+                  "Content-Range: bytes " + QByteArray::number(from) + "-" + QByteArray::number(m_zip.size() - 1)
+                      + "/" + QByteArray::number(m_zip.size()) + "\r\nContent-Length: "
+                      + QByteArray::number(m_zip.size() - from) + "\r\n",
+                  m_zip.mid(from));
+        } else if (m_mode == Mode::DropOnce && !m_dropped) {
+            // Promise the whole zip, deliver half of it, hang up
+            m_dropped = true;
+            reply(socket, "200 OK", "Content-Length: " + QByteArray::number(m_zip.size()) + "\r\n",
+                  m_zip.left(m_zip.size() / 2));
+        } else {
+            reply(socket, "200 OK", "Content-Length: " + QByteArray::number(m_zip.size()) + "\r\n", m_zip);
+        }
+    }
+
+    void reply(QTcpSocket *socket, const QByteArray &status, const QByteArray &headers, const QByteArray &body)
+    {
+        socket->write("HTTP/1.1 " + status + "\r\nETag: " + etag() + "\r\nAccept-Ranges: bytes\r\n"
+                      + headers + "Connection: close\r\n\r\n" + body);
+        socket->disconnectFromHost();
+    }
+
+    QTcpServer m_server;
+    QByteArray m_zip;
+    Mode m_mode;
+    bool m_dropped = false;
+    QHash<QTcpSocket*, QByteArray> m_buffers;
+};
+
+class TestSkinManager : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+
+    void resumesWithRange();
+    void restartsOnFullResponse();
+    void restartsAfterRangeNotSatisfiable();
+    void resumesAfterDroppedConnection();
+
+private:
+    bool install(SkinOrigin &origin);
+    void seedPartial(const QByteArray &data, const QByteArray &etag);
+    bool installedMatches() const;
+
+    static QString skinBaseDir();
+
+    QByteArray m_zip;
+    QByteArray m_index;
+    QByteArray m_script;
+};
+
+QString TestSkinManager::skinBaseDir()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/skins";
+}
+
+void TestSkinManager::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+
+    // A GitHub-style archive: one top-level directory, big enough to be cut in half
+    m_index = "<html><body>streamline</body></html>";
+    m_script.resize(256 * 1024);
+    quint32 seed = 12345;
+    for (char &c : m_script) {
+        seed = seed * 1103515245u + 12345u;
+        c = char(seed >> 24);
+    }
+
+    mz_zip_archive zip;
+    memset(&zip, 0, sizeof(zip));
+    QVERIFY(mz_zip_writer_init_heap(&zip, 0, 0));
+    QVERIFY(mz_zip_writer_add_mem(&zip, "streamline_project-main/index.html",
+                                  m_index.constData(), size_t(m_index.size()), MZ_DEFAULT_COMPRESSION));
+    QVERIFY(mz_zip_writer_add_mem(&zip, "streamline_project-main/app.bin",
+                                  m_script.constData(), size_t(m_script.size()), MZ_NO_COMPRESSION));
+    void *data = nullptr;
+    size_t size = 0;
+    QVERIFY(mz_zip_writer_finalize_heap_archive(&zip, &data, &size));
+    m_zip = QByteArray(static_cast<const char*>(data), qsizetype(size));
+    mz_free(data);
+    mz_zip_writer_end(&zip);
+}
+
+void TestSkinManager::init()
+{
+    QDir(skinBaseDir()).removeRecursively();
+}
+
+void TestSkinManager::seedPartial(const QByteArray &data, const QByteArray &etag)
+{
+    QDir().mkpath(skinBaseDir());
+    QFile zip(skinBaseDir() + "/download.zip");
+    QVERIFY(zip.open(QIODevice::WriteOnly));
+    zip.write(data);
+    QFile etagFile(skinBaseDir() + "/download.zip.etag");
+    QVERIFY(etagFile.open(QIODevice::WriteOnly));
+    etagFile.write(etag);
+}
+
+bool TestSkinManager::install(SkinOrigin &origin)
+{
+    SkinManager manager;
+    manager.setSourceUrl(origin.url());
+    QSignalSpy ready(&manager, &SkinManager::skinReady);
+    QSignalSpy failed(&manager, &SkinManager::skinUpdateFailed);
+
+    // Failed attempts are retried after 2 s, 4 s, ...
+    manager.initialize();
+    if (!QTest::qWaitFor([&]() { return !ready.isEmpty() || !failed.isEmpty(); }, 20000)) return false;
+    return !ready.isEmpty() && installedMatches();
+}
+
+bool TestSkinManager::installedMatches() const
+{
+    QFile index(skinBaseDir() + "/streamline_project/index.html");
+    QFile script(skinBaseDir() + "/streamline_project/app.bin");
+    return index.open(QIODevice::ReadOnly) && index.readAll() == m_index
+           && script.open(QIODevice::ReadOnly) && script.readAll() == m_script
+           && !QFile::exists(skinBaseDir() + "/download.zip");
+}
+
+void TestSkinManager::resumesWithRange()
+{
+    SkinOrigin origin(m_zip, SkinOrigin::Mode::Normal);
+    const qint64 half = m_zip.size() / 2;
+    seedPartial(m_zip.left(half), origin.etag());
+
+    QVERIFY(install(origin));
+    QCOMPARE(origin.ranges, QList<QByteArray>{"bytes=" + QByteArray::number(half) + "-"});
+}
+
+void TestSkinManager::restartsOnFullResponse()
+{
+    // The partial file is not a prefix of the zip: only a truncate-and-restart recovers
+    SkinOrigin origin(m_zip, SkinOrigin::Mode::IgnoreRange);
+    seedPartial(QByteArray(1000, 'x'), origin.etag());
+
+    QVERIFY(install(origin));
+    QCOMPARE(origin.ranges, QList<QByteArray>{"bytes=1000-"});
+}
+
+void TestSkinManager::restartsAfterRangeNotSatisfiable()
+{
+    SkinOrigin origin(m_zip, SkinOrigin::Mode::Normal);
+    seedPartial(m_zip + "trailing", origin.etag());
+
+    QVERIFY(install(origin));
+    const QList<QByteArray> expected{"bytes=" + QByteArray::number(m_zip.size() + 8) + "-", QByteArray()};
+    QCOMPARE(origin.ranges, expected);
+}
+
+void TestSkinManager::resumesAfterDroppedConnection()
+{
+    SkinOrigin origin(m_zip, SkinOrigin::Mode::DropOnce);
+
+    QVERIFY(install(origin));
+    const QList<QByteArray> expected{QByteArray(), "bytes=" + QByteArray::number(m_zip.size() / 2) + "-"};
+    QCOMPARE(origin.ranges, expected);
+}
+
+QTEST_GUILESS_MAIN(TestSkinManager)
+#include "tst_skinmanager.moc"